@@ -0,0 +1,77 @@
+#ifndef BATCH_SOLVER_H
+#define BATCH_SOLVER_H
+
+#include "SATInstance.h"
+#include "ThreadPool.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+enum class BatchStatus
+{
+    SAT,
+    UNSAT,
+    UNKNOWN // Timed out, also in the portfolio
+};
+
+struct BatchResult
+{
+    BatchStatus status = BatchStatus::UNKNOWN;
+    bool escalated = false;            // Exceeded the conflict budget and went to the portfolio
+    int conflicts = 0;                 // Of the single-solver run
+    int decisions = 0;
+    std::chrono::microseconds time{0}; // Wall time of both phases
+    std::vector<int> model;            // With keep_models: literals over variables 1..n
+};
+
+class PortfolioManager;
+
+// Solves many independent instances on a persistent thread pool. Each worker
+// takes the next instance and runs one CDCLSolverIncremental on it under a
+// conflict budget. Instances that exhaust it are escalated: once the cheap
+// ones are done, each runs on a PortfolioManager with the whole machine.
+class BatchSolver
+{
+public:
+    struct Config
+    {
+        int num_threads = std::max(1u, std::thread::hardware_concurrency());
+        int conflict_budget = 20000; // Single-solver conflicts before escalating
+        std::chrono::milliseconds timeout = std::chrono::seconds(60); // Per instance and phase
+        int portfolio_threads = std::max(1u, std::thread::hardware_concurrency());
+        bool keep_models = false;
+    };
+
+    // Builds instance i on demand; must return the same formula when asked
+    // again, since escalated instances are rebuilt for the portfolio
+    using InstanceSource = std::function<CNF(size_t)>;
+
+    // Called once per instance as it finishes, one call at a time
+    using ResultCallback = std::function<void(size_t, const BatchResult &)>;
+
+    BatchSolver(const Config &config);
+    ~BatchSolver();
+
+    // Results in instance order
+    std::vector<BatchResult> solve(size_t count, const InstanceSource &make_instance,
+                                   const ResultCallback &on_result = nullptr);
+    std::vector<BatchResult> solve(const std::vector<CNF> &instances, const ResultCallback &on_result = nullptr);
+
+    size_t getEscalated() const { return escalated; }
+
+private:
+    Config config;
+    ThreadPool pool;
+    std::mutex callback_mutex;
+    std::atomic<size_t> escalated;
+    std::unique_ptr<PortfolioManager> portfolio; // Shared by all escalations, created by the first
+
+    BatchResult solveBudgeted(const CNF &formula) const;
+    void solvePortfolio(const CNF &formula, BatchResult &result);
+};
+
+#endif // BATCH_SOLVER_H
@@ -3,11 +3,19 @@
 
 #include "SATInstance.h"
 #include "ClauseDatabase.h"
+#include "SolverCheckpoint.h"
+#include "SolveHandle.h"
+#include "SolveTask.h"
 #include <vector>
+#include <deque>
 #include <unordered_map>
 #include <unordered_set>
 #include <memory>
 #include <chrono>
+#include <functional>
+#include <string>
+#include <thread>
+#include <atomic>
 
 // Structure to represent a node in the implication graph for incremental CDCL
 struct ImplicationNodeIncremental
@@ -21,6 +29,15 @@ struct ImplicationNodeIncremental
         : literal(lit), decision_level(level), antecedent_id(ante_id), is_decision(decision) {}
 };
 
+// Settings for CDCLSolverIncremental::enumerateModels
+struct EnumerationOptions
+{
+    std::vector<int> projection;  // Variables models are distinguished on, empty = all
+    std::vector<int> assumptions; // Only enumerate models satisfying these literals
+    size_t max_models = 0;        // Stop after this many models, 0 = no limit
+    bool chronological = false;   // Split the search space instead of adding blocking clauses
+};
+
 // Forward declare the ClauseMinimizer class to avoid circular dependencies
 class ClauseMinimizer;
 
@@ -34,8 +51,11 @@ private:
     // Core components
     std::unique_ptr<ClauseDatabase> db;            // Clause database
     std::unordered_map<int, bool> assignments;     // Variable assignments
+    std::vector<signed char> lit_values;           // Mirror of assignments per literal (1/-1/0), indexed by litIndex
     std::vector<ImplicationNodeIncremental> trail; // Decision/propagation trail
     std::unordered_map<int, size_t> var_to_trail;  // Maps variables to positions in the trail
+    size_t propagate_head;                         // Trail literals before this have been propagated
+    size_t watch_epoch;                            // Database watch epoch the head is valid for
 
     // Current state
     int decision_level;
@@ -55,8 +75,16 @@ private:
 
     // Incremental solving
     std::vector<int> assumptions; // Current assumptions
+
+    // Temporary clause groups: each clause C of group a is stored as (C v -a)
+    // and a is assumed on every solve until the group is retracted with the
+    // root unit -a. Level-0 simplification then deletes the group's clauses and
+    // every learned clause derived from them.
+    std::unordered_set<int> temporary_groups; // Activation variables of live groups
+    int next_solve_group;                     // Group for addTemporaryClause(clause), 0 if none
     std::vector<int> core;        // Unsatisfiable core
     int last_solved_until;        // Index up to which the formula was solved
+    size_t root_level_units;      // Root-level literals the database was last simplified with
 
     // Statistics
     int conflicts;
@@ -64,17 +92,55 @@ private:
     int propagations;
     int restarts;
     int max_decision_level;
+    int hyper_binaries; // Binary resolvents derived during level-1 propagation
+    int strengthened;   // Antecedents shortened on the fly during conflict analysis
+    int subsumed;       // Recent learned clauses deleted as subsumed by a new one
+    int replayed;       // Implications restored from the saved trail
+
+    // Phase selection, per variable: 1 = true, -1 = false, 0 = none.
+    // Precedence when deciding: forced > target > saved > occurrence heuristic.
+    std::vector<signed char> forced_phase; // Set by setDecisionPolarity (e.g. MaxSAT warm starts)
+    std::vector<signed char> target_phase; // Assignment of the longest trail since the last restart
+    std::vector<signed char> saved_phase;  // Last value before the variable was unassigned
+    size_t target_trail_size;              // Trail length target_phase was taken from
+    size_t best_trail;                     // Longest trail of the current solve, see getProgress
 
     // Settings
     bool use_lbd;          // Use LBD for clause quality assessment
     bool use_phase_saving; // Use phase saving for decisions
+    bool use_hyper_binary; // Lazy hyper-binary resolution at decision level 1
+    bool use_trail_saving; // Replay the trail undone by the last backjump
     bool debug_output;
 
-    ClauseID conflict_clause_id; // ID of the last conflicting clause
+    ClauseID conflict_clause_id;    // ID of the last conflicting clause
+    std::vector<char> analyze_seen; // Per-variable marks for conflict analysis, cleared after use
 
-    // Optional clause minimizer
+    // Trail segment undone by the last backjump, replayed while it stays
+    // consistent with the new trail; reset by any backtrack to level 0
+    std::vector<ImplicationNodeIncremental> saved_trail;
+    size_t saved_head; // Next saved entry to replay
+
+    // Last learned clauses with their literal signatures, checked for subsumption
+    std::deque<std::pair<ClauseID, uint64_t>> recent_learned;
+    static constexpr size_t RECENT_LEARNED = 10;
+
+    // Clause minimizer: binary-implication step on learned clauses, vivification at restarts
     std::unique_ptr<ClauseMinimizer> minimizer;
 
+    // Periodic checkpoints: restarts past the interval hand a snapshot to a
+    // writer thread, skipping the checkpoint while the previous one is written
+    std::string checkpoint_path;
+    std::chrono::milliseconds checkpoint_interval;
+    std::chrono::steady_clock::time_point last_checkpoint;
+    std::thread checkpoint_writer;
+    std::atomic<bool> checkpoint_busy;
+    std::atomic<int> checkpoints_written;
+
+    // Memory relief requested from another thread, carried out at the next restart
+    std::atomic<bool> compaction_requested;
+    std::atomic<size_t> requested_max_learnts; // 0 = no change pending
+    int compactions;
+
     // Timeout related members
     std::chrono::high_resolution_clock::time_point start_time;
     std::chrono::milliseconds timeout_duration;
@@ -84,10 +150,37 @@ private:
     // Pointer to portfolio manager
     PortfolioManager *portfolio_manager;
 
+    // External control
+    bool interrupted;                                   // Last solve stopped without an answer
+    bool has_empty_clause;                              // Formula contains the empty clause
+    std::function<bool()> terminate_callback;           // Polled by checkTimeout()
+    std::function<void(const Clause &)> learn_callback; // Receives short learned clauses
+    size_t learn_max_length;
+    SolveHandle async_solve; // Latest solveAsync, waited for by the destructor
+
+    // Takes terminate_callback over for a scope and puts the caller's
+    // callback back on exit, also when the search throws
+    struct TerminateScope
+    {
+        std::function<bool()> &slot;
+        std::function<bool()> previous;
+        explicit TerminateScope(std::function<bool()> &callback) : slot(callback), previous(std::move(callback)) {}
+        ~TerminateScope() { slot = std::move(previous); }
+    };
+
+    // Model enumeration
+    std::vector<int> priority_vars; // Decided before all other variables (projection)
+
 public:
+    // Receives each model as literals over the projection; return false to stop
+    using ModelCallback = std::function<bool(const std::vector<int> &)>;
+
     // Make ClauseMinimizer a friend to access private members
     friend class ClauseMinimizer;
 
+    // Swaps in its own terminate callback around each slice
+    friend class SolveScheduler;
+
     // Constructor from a CNF formula
     CDCLSolverIncremental(const CNF &formula, bool debug = false, PortfolioManager *portfolio = nullptr);
 
@@ -98,22 +191,73 @@ public:
     bool solve();                                    // Solve the current formula
     bool solve(const std::vector<int> &assumptions); // Solve with assumptions
 
+    // Solve in slices: each resume() of the task runs until slice_conflicts
+    // conflicts or slice_propagations propagations have passed (0 = no limit)
+    // or the solve ends, with the search state kept in between. With
+    // at_restart the slice runs on to the next restart. Used by SolveScheduler
+    // to interleave many solvers on a few threads and by PortfolioManager to
+    // time-slice configurations.
+    SolveTask solveSliced(std::vector<int> assumptions, int slice_conflicts, int slice_propagations = 0,
+                          bool at_restart = false);
+
+    // Solve on the shared executor without blocking (see SolveHandle.h). Leave
+    // the solver alone until the handle is done; the destructor cancels and
+    // waits for an outstanding solve. While one runs, further calls return a
+    // handle that is already done as UNKNOWN.
+    SolveHandle solveAsync(const std::vector<int> &assumptions = {});
+
     // Incremental interface
     void addClause(const Clause &clause);                     // Add a permanent clause
+    void add(int lit);                                        // Stream a permanent clause, 0 terminates it
     void addTemporaryClause(const Clause &clause);            // Add a clause valid only for next solve
+    int newTemporaryGroup();                                  // Open a retractable group of clauses
+    void addTemporaryClause(int group, const Clause &clause); // Add a clause to a group
+    void retractTemporaryGroup(int group);                    // Disable a group for all later solves
     void setAssumptions(const std::vector<int> &assumptions); // Set assumptions for next solve
     void addAssumption(int literal);                          // Add a single assumption
     void clearAssumptions();                                  // Clear all assumptions
     std::vector<int> getUnsatCore() const;                    // Get the UNSAT core from the last solve
 
+    // Enumerate models (distinct on the projection), returns the number found.
+    // A timeout or the terminate callback can cut it short: the count is then
+    // partial and wasInterrupted() is true; stopping through on_model or
+    // max_models is not an interruption.
+    size_t enumerateModels(const ModelCallback &on_model, const EnumerationOptions &options = EnumerationOptions());
+
     // Variable management
-    void setDecisionPolarity(int var, bool phase);           // Force initial polarity
+    void setDecisionPolarity(int var, bool phase);           // Force polarity (overrides saved/target phases)
+    void clearDecisionPolarities();                          // Drop all forced polarities
     void setRandomizedPolarities(double random_freq = 0.02); // Randomize some polarities
 
     // Control methods
     void setMaxLearnts(size_t max_learnts);                     // Set maximum learned clauses
     void setVarDecay(double decay);                             // Set VSIDS decay factor
     void setRestartStrategy(bool use_luby, int init_threshold); // Configure restarts
+    void setTimeout(std::chrono::milliseconds timeout);         // Per-solve time limit
+    void setHyperBinaryResolution(bool enable);                 // Binary shortcuts for level-1 implications
+    void setTrailSaving(bool enable);                           // Replay implications undone by backjumps
+
+    // Memory relief (see MemoryGovernor.h), safe to call from any thread. At
+    // the next restart the learned clause limit becomes max_learnts and the
+    // database is cut to it; a compaction then also gives the memory back.
+    // Both wait for the restart, when no deletable clause is a reason.
+    void requestMaxLearnts(size_t max_learnts) { requested_max_learnts = max_learnts; }
+    void requestCompaction() { compaction_requested = true; }
+    size_t getMemoryUsage() const { return db->getMemoryUsage(); } // Clause database estimate in bytes
+    int getCompactions() const { return compactions; }
+
+    // Checkpoints (see SolverCheckpoint.h). Save and load between solves; a
+    // loaded checkpoint replaces the formula and search state but keeps the
+    // settings. setCheckpointing writes one in the background at restarts at
+    // most once per interval; an empty path turns it off.
+    bool saveCheckpoint(const std::string &path) const;
+    bool loadCheckpoint(const std::string &path);
+    void setCheckpointing(const std::string &path, std::chrono::milliseconds interval);
+    int getCheckpointsWritten() const { return checkpoints_written; }
+
+    // External control, used by the IPASIR interface
+    void setTerminateCallback(std::function<bool()> callback);
+    void setLearnCallback(size_t max_length, std::function<void(const Clause &)> callback);
 
     // Accessors
     const std::unordered_map<int, bool> &getAssignments() const { return assignments; }
@@ -122,35 +266,85 @@ public:
     int getPropagations() const { return propagations; }
     int getRestarts() const { return restarts; }
     int getMaxDecisionLevel() const { return max_decision_level; }
+    int getHyperBinaries() const { return hyper_binaries; }
+    int getStrengthened() const { return strengthened; }
+    int getSubsumed() const { return subsumed; }
+    int getReplayed() const { return replayed; }
+    bool wasInterrupted() const { return interrupted; } // False result was a timeout/stop, not UNSAT
+    SolveProgress getProgress() const;                  // Counters and longest trail of the current solve
     int getNumVars() const;
     int getNumClauses() const;
     int getNumLearnts() const;
 
     // New variable, used for incremental solving specifically graph coloring
     int newVariable();
+    void ensureVariable(int var); // Create variables up to var
 
     // Timeout related methods
     bool checkTimeout();
 
 private:
     // Internal solving methods
-    bool unitPropagate();                                              // Propagate unit clauses
+    SolveTask search(std::vector<int> assume, int slice_conflicts,     // CDCL search under assumptions,
+                     int slice_propagations, bool at_restart);         // suspending between slices
+    bool unitPropagate();                                              // Propagate the unprocessed trail literals
+    bool assertUnitClauses();                                          // Put unit clauses on the level-0 trail
+    void assignLiteral(int lit, size_t antecedent_id);                 // Record an implied literal
+    ClauseID hyperBinaryReason(ClauseID clause_id, int implied);       // Binary resolvent to use as reason
+    int binaryParent(int lit) const;                                   // Level-1 literal implying lit by a binary
+    bool impliedByBinaries(int from, int to) const;                    // from -> to in at most two binary steps
     int analyzeConflict(ClauseID conflict_id, Clause &learned_clause); // Analyze conflict
+    void analyzeFinal(ClauseID conflict_id);                           // Assumptions behind a level-0 conflict
+    const Clause *reasonOf(const ImplicationNodeIncremental &node) const;
+    void strengthenReason(ClauseID id, int pivot);                     // Drop the pivot from an antecedent
+    void subsumeRecentLearned(ClauseID learned_id);                    // Delete recent clauses the new one subsumes
+    bool isLocked(ClauseID id) const;                                  // Clause is the reason of a trail literal
+    int conflictLevel(ClauseID conflict_id) const;                     // Highest level in a false clause
     void backtrack(int level);                                         // Backtrack to a specific decision level
+    void saveTrail(int level);                                         // Stash the trail above level before a backjump
+    bool replaySavedTrail();                                           // Restore saved implications, false on conflict
     bool makeDecision();                                               // Make a new decision
+    bool propagateRootLevel();                                         // Level-0 propagation and simplification
+    void simplifyRootLevel();                                          // Simplify with new level-0 facts
+    void simplifyAtRestart();                                          // Same for units learned during the search
+    size_t assumptionStart() const;                                    // Trail index of the first assumption
+    std::vector<ImplicationNodeIncremental> liftAssumptions();         // Take assumptions off the level-0 trail
+    void restoreAssumptions(const std::vector<ImplicationNodeIncremental> &lifted); // Put them back unpropagated
+    void truncateLevelZero(size_t start);                              // Unassign level 0 from a trail index on
+    int preferredPhase(int var) const;                                 // Forced > target > saved phase, 0 if none
+    void updateTargetPhase();                                          // Remember the longest trail's assignment
+
+    // Checkpoint helpers
+    SolverCheckpoint takeCheckpoint() const;                     // Snapshot of the search state
+    void restoreCheckpoint(const SolverCheckpoint &checkpoint); // Rebuild the solver from a snapshot
+    void checkpointInBackground();                               // Periodic checkpoint at a restart
+
+    void compactClauseDatabase(); // Shed and compact at level 0, remapping clause IDs
+
+    // Literal values for the propagation hot path, kept in step with assignments
+    int litValue(int lit) const { return lit_values[litIndex(lit)]; }
+    void setVarValue(int var, bool value)
+    {
+        lit_values[2 * var] = value ? 1 : -1;
+        lit_values[2 * var + 1] = value ? -1 : 1;
+    }
+    void clearVarValue(int var)
+    {
+        lit_values[2 * var] = 0;
+        lit_values[2 * var + 1] = 0;
+    }
     bool isSatisfied() const;                                          // Check if formula is satisfied
 
     // VSIDS helpers
     void initializeVSIDS();        // Initialize VSIDS scores
     int selectVarVSIDS();          // Select next variable by VSIDS
+    int selectPriorityVar() const; // Most active unassigned priority variable, 0 if none
     void bumpVarActivity(int var); // Bump variable activity
     void decayVarActivities();     // Decay variable activities
 
     // Clause database helpers
     void minimizeClause(Clause &clause); // Minimize learned clause
-    bool isRedundant(int lit, std::unordered_set<int> &seen, int &timeout_check_counter,
-                     const std::chrono::time_point<std::chrono::high_resolution_clock> &start_time,
-                     const std::chrono::milliseconds &max_time);
+    bool isRedundant(int lit, std::vector<int> &marked); // Implied by the marked literals
 
     // Restart strategy
     bool shouldRestart();    // Check if we should restart
@@ -2,28 +2,40 @@
 #define CLAUSE_DATABASE_H
 
 #include "SATInstance.h"
+#include "Logging.h"
 #include <vector>
 #include <unordered_map>
 #include <algorithm>
+#include <functional>
 #include <memory>
 
 // Forward declaration
 class CDCLSolverIncremental;
 
+// Literal encoding shared by watch lists, occurrence counters and value arrays:
+// variable v owns slots 2v (positive) and 2v+1 (negative), so new variables
+// only append slots and never move existing ones.
+inline size_t litIndex(int lit)
+{
+    return 2 * static_cast<size_t>(lit < 0 ? -lit : lit) + (lit < 0 ? 1 : 0);
+}
+
 // Enhanced representation of a clause with activity and other metadata
 class ClauseInfo
 {
 public:
     Clause literals; // The literals in the clause
+    float activity;  // Bumped when the clause takes part in conflict analysis
+    int lbd;         // Literal Block Distance (for clause quality assessment)
     bool is_learned; // Whether this is a learned clause
     bool is_core;    // Whether this is part of the original problem (core)
-    size_t activity; // Activity counter for clause deletion heuristics
-    int lbd;         // Literal Block Distance (for clause quality assessment)
+    bool used;       // LBD improved since the last reduction; survives it once
 
     // Optional watched literals (stored here for cache efficiency)
     std::pair<int, int> watched_lits;
 
     ClauseInfo(const Clause &lits, bool learned = false, bool core = true);
+    ClauseInfo(Clause &&lits, bool learned = false, bool core = true);
 
     // Utility functions
     size_t size() const { return literals.size(); }
@@ -44,12 +56,21 @@ private:
 
     std::vector<ClauseRef> clauses;             // All clauses
     std::vector<ClauseRef> learned_clauses;     // Learned clauses for more efficient access
-    std::vector<std::vector<ClauseID>> watches; // Watched literals data structure
-
-    // Activity management
-    size_t clause_activity_inc;
+    std::vector<std::vector<ClauseID>> watches; // Watched literals data structure, indexed by litIndex
+    std::vector<size_t> occurrences;            // Live clauses containing each literal, indexed by litIndex
+    std::vector<std::vector<int>> binary_partners; // For each literal l: every m with a binary clause (l v m)
+    std::vector<ClauseID> unit_clauses;            // Unit clauses, asserted by the solver at level 0
+    size_t watch_epoch;                            // Bumped whenever initWatches() rebuilds every list
+
+    // Activity management: the increment grows by 1/decay per conflict and
+    // all activities are rescaled together before they overflow
+    double clause_activity_inc;
     double clause_decay_factor;
 
+    // Per decision level stamps for computeLBD
+    std::vector<size_t> lbd_stamps;
+    size_t lbd_stamp;
+
     // Statistics
     size_t num_variables;    // Number of variables
     size_t original_clauses; // Number of original clauses
@@ -61,6 +82,7 @@ private:
     size_t max_learnt_clauses;        // Maximum number of learned clauses before deletion
     double clause_deletion_threshold; // LBD threshold for deletion
     bool allow_clause_deletion;       // Whether to allow clause deletion (disable for debugging)
+    std::function<bool(ClauseID)> is_locked; // Set by the solver: clause is a reason on its trail, never deleted
 
     // Debug control
     bool debug_output;
@@ -68,8 +90,18 @@ private:
     size_t current_memory_usage;
     static constexpr size_t MAX_MEMORY_MB = 1024; // 1GB limit
 
+    // Clause being streamed in literal by literal (addLiteral/commitClause)
+    Clause pending_clause;
+    std::vector<signed char> pending_marks; // Per variable: +1/-1 if that literal is pending
+    std::vector<signed char> append_marks;  // Same, for the clause inside appendClause
+    bool pending_tautology;
+
+    static size_t clauseMemory(const ClauseInfo &clause);
     size_t calculateMemoryUsage() const;
     void updateMemoryUsage();
+    ClauseID storeClause(ClauseRef clause_ref); // Register and watch a new clause
+    void updateOccurrences(const Clause &lits, bool add);
+    void addBinaryPartners(const Clause &lits); // Record lits if it is a binary clause
 
 public:
     // Constructor
@@ -78,19 +110,50 @@ public:
     // Core database operations
     ClauseID addClause(const Clause &clause, bool is_learned = false);
     ClauseID addLearnedClause(const Clause &clause, int lbd);
+    ClauseID addHyperBinary(int implied, int other); // Learned binary added during propagation
     void removeClause(ClauseID id);
 
+    // Bulk loading: reserve, append every clause, then build watches once with initWatches().
+    // appendClause normalizes like commitClause and returns NO_CLAUSE for tautologies.
+    void reserve(size_t num_clauses);
+    ClauseID appendClause(const Clause &clause);
+    ClauseID appendLearnedClause(const Clause &clause, int lbd, float activity);
+
+    // Streaming clause construction: duplicates are dropped and tautologies
+    // discarded as literals arrive, and the finished clause takes over the
+    // staging buffer. commitClause returns NO_CLAUSE for tautologies and
+    // empty clauses.
+    static constexpr ClauseID NO_CLAUSE = static_cast<ClauseID>(-1);
+    void addLiteral(int lit);
+    ClauseID commitClause();
+    bool pendingClauseEmpty() const { return pending_clause.empty() && !pending_tautology; }
+
     // Watches management
     void initWatches();
     void updateWatches(ClauseID id, int old_lit, int new_lit);
     const std::vector<ClauseID> &getWatches(int literal) const;
+    size_t getWatchEpoch() const { return watch_epoch; }
+    const std::vector<ClauseID> &getUnitClauses() const { return unit_clauses; }
+
+    // In-place strengthening: detach a clause from its watches, replace its
+    // literals, then attach it again watching literals[0] and literals[1]
+    void detachClause(ClauseID id);
+    void replaceLiterals(ClauseID id, const Clause &literals);
+    void attachClause(ClauseID id);
 
     // Clause management
     void bumpClauseActivity(ClauseID id);
     void decayClauseActivities();
+    void updateClauseLBD(ClauseID id, const std::vector<int> &levels); // Recompute LBD of a clause in use
     void garbageCollect(const std::unordered_map<int, bool> &assignments);
+    size_t simplify(const std::unordered_map<int, bool> &root_assignments);
     size_t reduceLearnedClauses(const std::unordered_map<int, bool> &assignments);
 
+    // Close the gaps deleted clauses leave in the clause list and release spare
+    // capacity in the clause, watch and partner lists. Returns the new ID of
+    // every old ID, NO_CLAUSE for deleted ones; watches are rebuilt.
+    std::vector<ClauseID> compact();
+
     // LBD computation
     int computeLBD(const Clause &clause, const std::vector<int> &levels);
 
@@ -104,6 +167,13 @@ public:
     size_t getNumClauses() const;
     size_t getNumLearnedClauses() const;
     size_t getNumVariables() const;
+    size_t getOccurrences(int lit) const; // Number of live clauses containing lit
+    size_t getMemoryUsage() const { return current_memory_usage; } // Estimate in bytes
+
+    // Other literal of every binary clause containing lit. Rebuilt by
+    // initWatches(); entries of binaries deleted since then are implied by the
+    // formula, so they remain valid for minimization.
+    const std::vector<int> &getBinaryPartners(int lit) const { return binary_partners[litIndex(lit)]; }
 
     // Add variable
     int addVariable();
@@ -113,39 +183,46 @@ public:
     void printWatches() const;
     bool checkWatchesConsistency() const;
 
-    // Clear all learned clauses and reset the database
+    // Clear all learned clauses and reset the database. Clause IDs of the
+    // remaining clauses stay valid; learned slots become nullptr.
     void clearLearnedClauses()
     {
-        // Keep only original clauses
         size_t num_original = 0;
-        for (size_t i = 0; i < clauses.size(); i++)
+        for (auto &clause : clauses)
         {
-            if (clauses[i] && clauses[i]->is_core)
+            if (clause && clause->is_learned)
+            {
+                clause = nullptr;
+            }
+            else if (clause)
             {
                 num_original++;
             }
         }
 
-        // Resize to keep only original clauses
-        clauses.resize(num_original);
-
         // Clear learned clauses vector
         learned_clauses.clear();
 
-        // Reset watches
-        watches.clear();
-        watches.resize(2 * num_variables + 1); // +1 for index 0, *2 for positive and negative literals
-
         // Reset statistics
         total_learned = 0;
         active_learned = 0;
         deleted_learned = 0;
-        original_clauses = num_original;
 
         // Reset activity management
         clause_activity_inc = 1;
 
-        if (debug_output)
+        // Rebuild watches, occurrence counters and the memory estimate
+        std::fill(occurrences.begin(), occurrences.end(), 0);
+        for (const auto &clause : clauses)
+        {
+            if (clause)
+            {
+                updateOccurrences(clause->literals, true);
+            }
+        }
+        initWatches();
+
+        SAT_DEBUG(debug_output)
         {
             std::cout << "Cleared learned clauses. Database now has " << num_original << " original clauses.\n";
         }
@@ -5,25 +5,21 @@
 #include "ClauseDatabase.h"
 #include "CDCLSolverIncremental.h" // ImplicationNodeIncremental definition
 #include <vector>
-#include <unordered_map>
-#include <unordered_set>
 
 // Class for clause minimization techniques
 class ClauseMinimizer
 {
 private:
-    // Reference to trail and assignments (from solver)
-    const std::vector<ImplicationNodeIncremental> &trail;
-    const std::unordered_map<int, bool> &assignments;
-    const std::unordered_map<int, size_t> &var_to_trail;
-    const std::vector<int> &decision_levels;
-
     // Reference to clause database
     ClauseDatabase &db;
 
+    // Solver whose trail and propagation vivification runs on (optional)
+    CDCLSolverIncremental *solver;
+    ClauseID vivify_cursor; // Learned clauses below this ID have been vivified
+
     // Working data structures
-    std::unordered_set<int> seen;
-    std::vector<int> stack;
+    std::vector<unsigned> lit_stamps; // Per literal (litIndex): marked if lit_stamps == current_stamp
+    unsigned current_stamp;
 
     // Settings
     bool use_binary_resolution;
@@ -32,16 +28,14 @@ private:
 
 public:
     ClauseMinimizer(
-        const std::vector<ImplicationNodeIncremental> &trail_ref,
-        const std::unordered_map<int, bool> &assignments_ref,
-        const std::unordered_map<int, size_t> &var_to_trail_ref,
-        const std::vector<int> &decision_levels_ref,
         ClauseDatabase &db_ref,
-        bool debug = false);
+        bool debug = false,
+        CDCLSolverIncremental *solver_ref = nullptr);
 
     // Main minimization methods
-    void minimizeConflictClause(Clause &clause);
-    void minimizeLearnedClauses();
+    void minimizeWithBinaries(Clause &clause); // Per-conflict binary step, clause[0] = asserting literal
+    size_t vivifyLearnedClauses(size_t max_clauses); // Vivify new learned clauses, solver at level 0
+    void remapClauses(const std::vector<ClauseID> &remap); // Follow ClauseDatabase::compact()
 
     // Configuration
     void setUseBinaryResolution(bool use) { use_binary_resolution = use; }
@@ -49,15 +43,9 @@ public:
 
 private:
     // Minimization techniques
-    bool recursiveMinimize(int lit, std::unordered_set<int> &seen, int depth = 0);
-    void selfSubsumption(Clause &clause);
     void binaryResolution(Clause &clause);
     void vivification(Clause &clause);
-
-    // Utility methods
-    bool isRedundant(int lit);
-    bool isImplied(int lit, const Clause &by_clause);
-    void printClause(const Clause &clause) const;
+    bool canVivify() const;
 };
 
 #endif // CLAUSE_MINIMIZER_H
\ No newline at end of file
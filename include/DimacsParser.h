@@ -0,0 +1,27 @@
+#ifndef DIMACS_PARSER_H
+#define DIMACS_PARSER_H
+
+#include "SATInstance.h"
+#include <istream>
+#include <string>
+#include <vector>
+
+// Readers for DIMACS CNF and WCNF files. Comment lines ("c ...") are skipped
+// and clauses may span lines; each clause ends with 0. Both return false on
+// malformed input and leave the outputs in an unspecified state.
+
+// "p cnf <vars> <clauses>" followed by the clauses
+bool readDimacs(std::istream &in, CNF &formula);
+
+// Weighted formulas, in either format:
+//   classic: "p wcnf <vars> <clauses> [top]", every clause starts with its
+//            weight and weights >= top (if given) mark hard clauses
+//   2022:    no header, hard clauses start with "h", soft ones with the weight
+// Soft clauses are returned with their weights in matching order.
+bool readWcnf(std::istream &in, CNF &hard, CNF &soft, std::vector<int> &weights);
+
+// Open path and dispatch on the extension (.wcnf reads weighted formulas,
+// everything else plain CNF); hard holds the CNF clauses
+bool readFormulaFile(const std::string &path, CNF &hard, CNF &soft, std::vector<int> &weights, bool &weighted);
+
+#endif // DIMACS_PARSER_H
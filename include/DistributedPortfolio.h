@@ -0,0 +1,143 @@
+#ifndef DISTRIBUTED_PORTFOLIO_H
+#define DISTRIBUTED_PORTFOLIO_H
+
+#include "SATInstance.h"
+#include "SolveProtocol.h"
+#include "ThreadPool.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Portfolio spread over several processes or hosts (see sat_portfolio_node).
+// Workers connect to the coordinator over TCP and offer a number of solver
+// slots. For each formula the coordinator sends the formula once, then fills
+// the slots with tasks: either every portfolio configuration on the whole
+// formula, or the 2^k cubes over the k most frequent variables, handed out as
+// slots free up. Learned clauses up to a length limit are exchanged in batches
+// between slices of a fixed number of conflicts. The first SAT answer, a
+// refutation of the whole formula, or refutations of all cubes settle the
+// formula, and the coordinator cancels the remaining tasks. The messages are
+// described in SolveProtocol.h.
+class DistributedCoordinator
+{
+public:
+    struct Config
+    {
+        std::string bind_address = "127.0.0.1";
+        uint16_t port = 0; // 0 picks a free port, see getPort()
+        int num_workers = 1;
+        std::chrono::milliseconds connect_timeout = std::chrono::seconds(30); // For acceptWorkers
+        std::chrono::milliseconds timeout = std::chrono::minutes(30);         // Per solve
+        int cube_variables = 0;        // Split into 2^k cubes, 0 runs the configurations on the whole formula
+        uint32_t share_max_length = 8; // Longest shared learned clause, 0 disables sharing
+    };
+
+    DistributedCoordinator(const Config &config);
+    ~DistributedCoordinator();
+
+    // Bind and listen; false if the socket cannot be set up
+    bool listen();
+    uint16_t getPort() const { return port; }
+
+    // Wait for up to num_workers workers; returns how many are connected
+    size_t acceptWorkers();
+
+    // SAT with the model over variables 1..n, UNSAT, TIMEOUT, CANCELLED after
+    // stop(), or ERROR once every worker is gone. The workers stay connected
+    // for the next formula.
+    JobResult solve(const CNF &formula);
+
+    // Stop a running solve from another thread
+    void stop() { stopping = true; }
+
+    size_t getSharedClauses() const { return shared_clauses; }
+
+private:
+    struct Worker
+    {
+        int fd = -1;
+        uint32_t slots = 0;
+        std::vector<DistributedTask> running;
+    };
+
+    Config config;
+    int listen_fd;
+    uint16_t port;
+    std::vector<Worker> workers;
+    uint64_t next_job_id;
+    uint64_t next_task_id;
+    std::atomic<bool> stopping;
+    std::atomic<size_t> shared_clauses;
+
+    std::deque<DistributedTask> makeTasks(const CNF &formula);
+    void dispatch(std::deque<DistributedTask> &queue);
+    void dropWorker(Worker &worker, std::deque<DistributedTask> &queue);
+    void broadcast(MessageType type, const std::vector<uint8_t> &payload, const Worker *except = nullptr);
+};
+
+// Worker process side: connects to a coordinator and runs its tasks on a
+// thread pool, one CDCLSolverIncremental per task, until the coordinator
+// closes the connection. A task that fails (out of memory, say) is answered
+// with ERROR and the coordinator queues it again.
+class DistributedWorker
+{
+public:
+    struct Config
+    {
+        std::string host = "127.0.0.1";
+        uint16_t port = 0;
+        int num_threads = std::max(1u, std::thread::hardware_concurrency()); // Slots offered
+        int slice_conflicts = 2000; // Conflicts between clause exchanges
+        std::chrono::milliseconds connect_timeout = std::chrono::seconds(30); // Retry window
+    };
+
+    DistributedWorker(const Config &config);
+    ~DistributedWorker();
+
+    // Connect and serve; false if the coordinator cannot be reached
+    bool run();
+
+    // Cancel the running tasks and make run() return
+    void stop();
+
+    size_t getTasksCompleted() const { return tasks_completed; }
+
+private:
+    // One formula and the clauses learned on it so far
+    struct Job
+    {
+        uint64_t id = 0;
+        uint32_t share_max_length = 0;
+        CNF formula;
+        int num_vars = 0;
+        std::atomic<bool> cancelled{false};
+
+        // Shared clauses with the task that learned them (0 = another worker)
+        std::mutex clauses_mutex;
+        std::vector<std::pair<uint64_t, Clause>> clauses;
+        size_t sent = 0; // Clauses up to here went to the coordinator
+    };
+
+    Config config;
+    std::atomic<int> fd;
+    std::mutex write_mutex;
+    std::mutex job_mutex;
+    std::shared_ptr<Job> job; // Current formula, guarded by job_mutex
+    ThreadPool pool;
+    std::atomic<size_t> tasks_completed;
+
+    bool connectToCoordinator();
+    void runTask(std::shared_ptr<Job> job, const DistributedTask &task);
+    void exchangeClauses(Job &job, uint64_t task_id, std::vector<Clause> &learned, size_t &cursor,
+                         CNF &imported);
+    void send(MessageType type, const std::vector<uint8_t> &payload);
+};
+
+#endif // DISTRIBUTED_PORTFOLIO_H
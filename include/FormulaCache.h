@@ -0,0 +1,117 @@
+#ifndef FORMULA_CACHE_H
+#define FORMULA_CACHE_H
+
+#include "SATInstance.h"
+#include <cstdint>
+#include <list>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// 128-bit formula key
+struct FormulaKey
+{
+    uint64_t hi = 0;
+    uint64_t lo = 0;
+
+    bool operator==(const FormulaKey &other) const { return hi == other.hi && lo == other.lo; }
+};
+
+struct FormulaKeyHash
+{
+    size_t operator()(const FormulaKey &key) const { return key.hi ^ (key.lo * 0x9e3779b97f4a7c15ULL); }
+};
+
+// A query in canonical form: its key plus the variable labelling the key was
+// computed under. Cached literals are stored over canonical labels, so a hit
+// from a renamed formula maps back to the caller's variables.
+struct CanonicalFormula
+{
+    FormulaKey key;
+    bool renamed = false;          // Labels come from degree refinement, not the input
+    int num_vars = 0;              // Largest variable of the query
+    std::vector<int> label_of_var; // Variable -> canonical label (renamed only)
+    std::vector<int> var_of_label; // Canonical label -> variable (renamed only)
+};
+
+// Cached answer: a model (SAT) or failed assumptions (UNSAT), plus the
+// optimum cost of weighted queries (-1 otherwise)
+struct CachedResult
+{
+    bool sat = false;
+    int64_t cost = -1;
+    std::vector<int> literals;
+};
+
+// LRU map from canonical formula keys to solver answers, optionally persisted
+// to a memory-mapped file.
+//
+// The key is independent of clause order, literal order, duplicate literals,
+// duplicate hard clauses and tautologies. With modulo_renaming, variables are
+// first relabelled by degree refinement (colour refinement over the
+// variable/clause incidence graph); formulas whose refinement separates every
+// variable get a key shared by all their renamings. Formulas it cannot fully
+// separate (symmetric ones) fall back to the exact key, so a hit always
+// comes from an isomorphic formula.
+//
+// The file is an append-only log of entries read back on open; it is
+// rewritten in LRU order once dead entries dominate and on flush(). All
+// methods are thread-safe; canonicalize() takes no lock.
+class FormulaCache
+{
+public:
+    FormulaCache(size_t capacity, bool modulo_renaming = false);
+    ~FormulaCache();
+
+    // Attach a cache file, loading its entries; false if it cannot be mapped
+    bool open(const std::string &path);
+
+    // Canonical form of clauses (weights parallel to clauses, empty or 0 =
+    // hard) under assumptions
+    CanonicalFormula canonicalize(const CNF &clauses, const std::vector<int> &weights,
+                                  const std::vector<int> &assumptions) const;
+
+    // Answer in the query's variables; false on a miss
+    bool lookup(const CanonicalFormula &query, CachedResult &result);
+    void store(const CanonicalFormula &query, const CachedResult &result);
+
+    // Compact the file and write it back to disk
+    void flush();
+
+    size_t size();
+    size_t getHits() const { return hits; }
+    size_t getMisses() const { return misses; }
+
+private:
+    struct Entry
+    {
+        FormulaKey key;
+        CachedResult result; // Literals over canonical labels
+    };
+
+    size_t capacity;
+    bool modulo_renaming;
+
+    std::mutex mutex;
+    std::list<Entry> entries; // Most recently used first
+    std::unordered_map<FormulaKey, std::list<Entry>::iterator, FormulaKeyHash> index;
+    size_t hits;
+    size_t misses;
+
+    // Mapped log file
+    int fd;
+    uint8_t *mapped;
+    size_t mapped_size;
+    size_t log_bytes; // Record bytes in use after the header
+    size_t live_bytes; // Record bytes of the entries still cached
+
+    void insert(Entry entry);
+    bool reserveLog(size_t bytes);
+    void appendRecord(const Entry &entry);
+    void loadLog();
+    void rewriteLog();
+    void closeFile();
+};
+
+#endif // FORMULA_CACHE_H
@@ -43,6 +43,12 @@ public:
     int getNumVariables() const;
     int getNumSolverCalls() const;
 
+    // Stop hook passed to the inner searches (polled like the IPASIR
+    // terminate callback). wasInterrupted() tells whether the last solve was
+    // stopped by it or by a timeout: its -1 then proves nothing
+    void setTerminateCallback(std::function<bool()> callback) { terminate_callback = std::move(callback); }
+    bool wasInterrupted() const { return interrupted; }
+
 private:
     // Determine if the problem is weighted or unweighted
     bool isWeightedProblem() const;
@@ -66,6 +72,8 @@ private:
     // Result tracking
     std::unordered_map<int, bool> last_assignment;
     int solver_calls;
+    bool interrupted;
+    std::function<bool()> terminate_callback;
 };
 
 #endif // HYBRID_MAXSAT_SOLVER_H
\ No newline at end of file
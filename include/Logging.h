@@ -0,0 +1,53 @@
+#ifndef LOGGING_H
+#define LOGGING_H
+
+#include <iostream>
+
+// Compile-time log levels for the solvers' diagnostic output.
+//
+// Every diagnostic block is written as
+//
+//     SAT_TRACE(debug_output)
+//     {
+//         std::cout << ...;
+//     }
+//
+// The level check is an `if constexpr`, so when a level is compiled out the
+// block and the runtime flag test both disappear from the generated code.
+// Release builds keep only INFO messages (one-off setup output); the *_debug
+// targets are compiled with SAT_LOG_LEVEL=SAT_LOG_LEVEL_TRACE and keep every
+// propagation/analysis trace, still switched on at runtime by debug_output.
+#define SAT_LOG_LEVEL_NONE 0
+#define SAT_LOG_LEVEL_INFO 1  // Setup and summary messages
+#define SAT_LOG_LEVEL_DEBUG 2 // Per-solve events: restarts, reductions, timeouts
+#define SAT_LOG_LEVEL_TRACE 3 // Per-propagation/per-conflict events in hot loops
+
+#ifndef SAT_LOG_LEVEL
+#define SAT_LOG_LEVEL SAT_LOG_LEVEL_INFO
+#endif
+
+namespace satlog
+{
+    constexpr int compiled_level = SAT_LOG_LEVEL;
+
+    // Whether messages of the given level are compiled into this build
+    constexpr bool enabled(int level) { return level <= compiled_level; }
+}
+
+// Guard a diagnostic block by compile-time level and runtime flag. The empty
+// branches make the macro safe to use in front of a braced block without
+// dangling-else surprises.
+#define SAT_LOG_IF(level, flag)                 \
+    if constexpr (!::satlog::enabled(level))    \
+    {                                           \
+    }                                           \
+    else if (!(flag))                           \
+    {                                           \
+    }                                           \
+    else
+
+#define SAT_INFO(flag) SAT_LOG_IF(SAT_LOG_LEVEL_INFO, flag)
+#define SAT_DEBUG(flag) SAT_LOG_IF(SAT_LOG_LEVEL_DEBUG, flag)
+#define SAT_TRACE(flag) SAT_LOG_IF(SAT_LOG_LEVEL_TRACE, flag)
+
+#endif // LOGGING_H
@@ -29,6 +29,12 @@ public:
 
     void setPreviousSolution(const std::unordered_map<int, bool> &solution);
 
+    // Polled by the inner CDCL searches; returning true stops them. An inner
+    // search stopped this way or by a timeout makes solve() and
+    // solveBinarySearch() return -1 without proving anything
+    void setTerminateCallback(std::function<bool()> callback);
+    bool wasInterrupted() const { return interrupted; }
+
 private:
     std::vector<int> createAssumptions(int k);
     bool solveWithKRelaxed(int k, std::vector<int> &assumptions);
@@ -39,6 +45,7 @@ private:
     int next_var;
     bool debug_output;
     int solver_calls;
+    bool interrupted;
 
     // New variables for warm starting
     std::unordered_map<int, bool> last_solution;
@@ -0,0 +1,96 @@
+#ifndef MEMORY_GOVERNOR_H
+#define MEMORY_GOVERNOR_H
+
+#include <chrono>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+// Staged response to memory pressure across a set of solver workers. Each
+// check compares the process RSS (or, where that cannot be read, the sum of
+// the workers' clause database estimates) with a limit, by default the
+// container's memory limit, and escalates as usage climbs:
+//   1. lower every worker's learned clause limit,
+//   2. have every worker shed and compact its clause database at its next restart,
+//   3. suspend the worker that has made the least progress.
+// A stage acts again only after a cooldown, so earlier steps can take effect
+// first. The governor only decides; the owner of the workers carries it out
+// (see PortfolioManager).
+class MemoryGovernor
+{
+public:
+    enum class Stage
+    {
+        NORMAL,
+        SHRINK,
+        COMPACT,
+        SUSPEND
+    };
+
+    struct Config
+    {
+        size_t limit_bytes = 0;     // 0 = the container limit, if any; no limit disables the governor
+        double shrink_at = 0.70;    // Fraction of the limit that starts each stage
+        double compact_at = 0.80;
+        double suspend_at = 0.90;
+        double shrink_factor = 0.5; // Learned clause limit multiplier per shrink
+        size_t min_learnts = 1000;  // Shrinking stops here
+        std::chrono::milliseconds interval = std::chrono::milliseconds(100); // Between checks
+        std::chrono::milliseconds cooldown = std::chrono::seconds(1);        // Between actions of one stage
+    };
+
+    // What the governor sees of one worker
+    struct WorkerUsage
+    {
+        bool active = false;    // Running and not suspended
+        size_t memory = 0;      // Clause database estimate in bytes
+        size_t max_learnts = 0; // Current learned clause limit
+        double progress = 0.0;  // Higher is further along
+    };
+
+    // Instructions for the workers after one check
+    struct Decision
+    {
+        Stage stage = Stage::NORMAL;
+        std::vector<std::pair<int, size_t>> learnt_limits; // Worker and its new learned clause limit
+        std::vector<int> compact;                           // Workers to compact at their next restart
+        int suspend = -1;                                   // Worker to suspend, -1 if none
+    };
+
+    MemoryGovernor();
+    explicit MemoryGovernor(const Config &config);
+
+    bool enabled() const { return limit > 0; }
+    size_t getLimit() const { return limit; }
+    void setLimit(size_t bytes) { limit = bytes; }
+    std::chrono::milliseconds getInterval() const { return config.interval; }
+
+    // Forget the actions of the previous solve
+    void reset();
+
+    // One check against the limit; the overload takes the resident size
+    // instead of reading it, 0 meaning unknown
+    Decision check(const std::vector<WorkerUsage> &workers);
+    Decision check(const std::vector<WorkerUsage> &workers, size_t resident_bytes);
+
+    size_t getPeakUsage() const { return peak_usage; }
+    int getShrinks() const { return shrinks; }
+    int getCompactions() const { return compactions; }
+    int getSuspensions() const { return suspensions; }
+
+    static size_t processResidentBytes(); // From /proc/self/statm, 0 elsewhere
+    static size_t containerMemoryLimit(); // cgroup v2 or v1 limit, 0 if none
+
+private:
+    Config config;
+    size_t limit;
+    std::chrono::steady_clock::time_point last_action[4]; // Per stage
+    size_t peak_usage;
+    int shrinks;
+    int compactions;
+    int suspensions;
+
+    bool due(Stage stage, std::chrono::steady_clock::time_point now);
+};
+
+#endif // MEMORY_GOVERNOR_H
@@ -9,7 +9,9 @@
 #include <chrono>
 #include <unordered_map>
 #include <memory>
+#include <string>
 #include "CDCLSolverIncremental.h"
+#include "MemoryGovernor.h"
 
 // Portfolio-based parallel SAT solver optimized for Random 3SAT problems
 // Runs multiple diversely configured CDCLSolverIncremental instances in parallel,
@@ -22,12 +24,45 @@ private:
     CNF formula;
 
     // Thread and termination control
-    std::vector<std::thread> solver_threads;
     std::atomic<bool> solution_found;
+    std::atomic<bool> unsat_proven; // A solver refuted the formula
     std::atomic<bool> global_timeout;
-    std::condition_variable termination_cv;
+    std::condition_variable termination_cv; // A solver finished or the portfolio was stopped
     std::mutex termination_mutex;
 
+    // Worker pool: one thread per configuration, at most max_concurrent_solvers,
+    // started by the first solve() and parked on work_cv between solves.
+    // Guarded by termination_mutex.
+    std::vector<std::thread> solver_threads;
+    std::condition_variable work_cv;
+    size_t job_generation;                 // Bumped once per solve()
+    const CNF *job_formula;                // Formula of the current solve
+    std::chrono::microseconds job_stagger; // Start delay between consecutive solvers
+    size_t pending_solvers;                // Workers of the current solve still running
+    size_t job_num_vars;                   // Variables of the current formula
+    bool shutting_down;
+
+    // Time slicing. With more configurations than workers, each configuration
+    // runs as a suspended solve (CDCLSolverIncremental::solveSliced) that keeps
+    // its learned clauses between slices. A free worker resumes the one with
+    // the best UCB score over the progress made in its past slices until the
+    // next restart after slice_conflicts conflicts. Guarded by schedule_mutex.
+    struct ConfigurationRun
+    {
+        std::unique_ptr<CDCLSolverIncremental> solver; // Created on the first slice
+        SolveTask task;
+        bool claimed = false;  // A worker is running its slice
+        bool finished = false; // Done or stopped, or never started before the end
+        int slices = 0;
+        double total_reward = 0.0; // Sum of slice rewards, see runSlice
+        std::chrono::microseconds solve_time{0};
+    };
+    std::vector<ConfigurationRun> configuration_runs;
+    std::mutex schedule_mutex;
+    int total_slices;
+    int slice_conflicts;
+    static constexpr double UCB_EXPLORATION = 0.5;
+
     // Resource management
     const size_t MAX_MEMORY_PER_SOLVER = 1024 * 1024 * 1024; // 1GB per solver
     std::atomic<size_t> total_memory_used;
@@ -35,7 +70,7 @@ private:
     std::condition_variable resource_cv;
     int max_concurrent_solvers;
     std::atomic<int> active_solvers;
-    std::atomic<bool> initialization_complete; // Track initialization status
+    size_t job_memory_estimate; // estimateMemoryUsage of the current formula
 
     // Timing control
     std::chrono::milliseconds global_timeout_duration;
@@ -58,9 +93,38 @@ private:
         std::chrono::microseconds solve_time;
         size_t peak_memory_usage;
         int termination_reason; // 0=solution, 1=timeout, 2=resource_limit, 3=external_stop
+        int time_slices;        // Slices the configuration ran in, 1 without time slicing
     };
     std::vector<SolverStats> solver_statistics;
 
+    // Live counters each solver publishes while it runs, read by getProgress();
+    // shared with async handles so they stay readable after the manager is gone
+    struct SolverProgress
+    {
+        std::atomic<int> conflicts{0};
+        std::atomic<int> decisions{0};
+        std::atomic<int> restarts{0};
+        std::atomic<int> best_trail{0};
+        std::atomic<size_t> memory{0}; // Clause database estimate
+    };
+    std::shared_ptr<SolverProgress[]> solver_progress;
+
+    // Memory governor (see MemoryGovernor.h), checked by solve() while it
+    // waits. Its instructions reach each solver through these flags, which
+    // the solver's terminate callback picks up on its own thread.
+    struct SolverControl
+    {
+        std::atomic<size_t> learnt_limit{0}; // Learned clause limit to apply
+        std::atomic<bool> compact{false};    // Compact at the next restart
+        std::atomic<bool> suspend{false};    // Stop and release the solver
+    };
+    std::unique_ptr<SolverControl[]> solver_control;
+    MemoryGovernor memory_governor;
+
+    // Async solves (see SolveHandle.h)
+    SolveHandle async_solve;  // Latest solveAsync, waited for by the destructor
+    SolveHandle active_async; // Set only while an async solve runs; its cancel() stops the solvers
+
     // Configuration presets optimized for Random 3SAT
     struct SolverConfig
     {
@@ -74,8 +138,10 @@ private:
     };
     std::vector<SolverConfig> solver_configs;
 
-    // Monitor thread
-    std::thread monitor_thread;
+    // Checkpointing: solver i checkpoints to <prefix>.<formula key>.<i>
+    std::string checkpoint_prefix;
+    std::chrono::milliseconds checkpoint_interval;
+    std::string checkpoint_key; // Hex key of the formula being solved
 
 public:
     // Constructs a new PortfolioManager object
@@ -83,20 +149,45 @@ public:
                      std::chrono::milliseconds timeout = std::chrono::minutes(30),
                      int num_threads = std::thread::hardware_concurrency());
 
-    // Ensures proper termination of all threads
+    // Stops a running solve and joins the worker threads
     ~PortfolioManager();
 
-    // Solves the formula using the portfolio approach
+    // Solves the formula using the portfolio approach. The manager can be
+    // reused: later calls run on the same worker threads, and the global
+    // timeout counts from the start of each call.
     bool solve(const CNF &formula);
 
+    // solve() on the shared executor without blocking; the formula is copied.
+    // While one runs, further calls return a handle that is already done as
+    // UNKNOWN. The destructor cancels and waits for an outstanding solve.
+    SolveHandle solveAsync(const CNF &formula);
+
+    // Summed counters of the running solvers; best_trail is the longest of any
+    SolveProgress getProgress() const;
+
     // Get satisfying assignment if formula was satisfiable
     const std::unordered_map<int, bool> &getSolution() const;
 
     // Set the global timeout for the entire portfolio
     void setGlobalTimeout(std::chrono::milliseconds timeout);
 
-    // Set maximum memory usage for the portfolio
+    // Checkpoint every solver periodically and let the next solve of the same
+    // formula resume from those checkpoints; an empty prefix turns it off
+    void setCheckpointing(const std::string &prefix, std::chrono::milliseconds interval);
+
+    // Set maximum memory usage for the portfolio; this and the thread count
+    // fix the number of workers when the first solve starts them. It is also
+    // the memory governor's limit, which otherwise is the container's.
     void setMaxMemoryUsage(size_t max_memory_mb);
+    const MemoryGovernor &getMemoryGovernor() const { return memory_governor; }
+
+    // Run count configurations: the built-in ones, then variants of them with
+    // slower restarts and more randomization. Call between solves.
+    void setNumConfigurations(int count);
+
+    // Conflicts a time-sliced configuration runs before it yields at its next
+    // restart (default 2000); only used with more configurations than workers
+    void setSliceConflicts(int conflicts);
 
     // Print detailed statistics about the solver performance
     void printStatistics() const;
@@ -111,19 +202,53 @@ public:
     const std::vector<SolverStats> &getSolverStatistics() const { return solver_statistics; }
 
     bool isSolutionFound() const { return solution_found; }
+    bool isUnsatProven() const { return unsat_proven; }
+
+    // Polled by the portfolio's solvers: a result is in, time is up or stop() was called
+    bool shouldTerminate() const;
+
+    // Stop a running solve from another thread
+    void stop() { terminateAllSolvers(); }
+
+    // The built-in configurations, for solvers run outside a manager (the
+    // distributed workers); ids wrap around
+    static int numConfigurations();
+    static void applyConfiguration(CDCLSolverIncremental &solver, int config_id);
 
 private:
     // Initialize diverse solver configurations
     void initializeConfigs();
+    static const std::vector<SolverConfig> &builtinConfigs();
+
+    // Start the worker threads on first use
+    void startWorkers();
+
+    // Worker thread: runs configurations once per solve() until shut down
+    void workerLoop();
 
-    // Main solver thread function
-    void solverThread(int solver_id, const CNF &formula);
+    // Pick the unfinished configuration with the best UCB score, -1 if none is free
+    int claimConfiguration();
 
-    // Thread that monitors timeout and resource usage
-    void monitorThread();
+    // Run one slice of a configuration, starting it on the first call
+    void runSlice(int solver_id, const CNF &formula);
+
+    // Gather the workers' memory use, check it and pass the governor's instructions on
+    void governMemory();
+
+    // Record the result of a configuration that finished
+    void finishConfiguration(int solver_id, CDCLSolverIncremental &solver, bool result);
+
+    // Variant round of the built-in configurations for ids past the first set
+    static SolverConfig configurationVariant(int config_id);
+
+    // Checkpoint file of a configuration for the current formula
+    std::string checkpointPath(int solver_id) const;
 
     // Apply configuration to a solver instance
     void configureSolver(CDCLSolverIncremental &solver, int config_id);
+    static void applyConfig(CDCLSolverIncremental &solver, const SolverConfig &config);
+
+    static SolveProgress sumProgress(const SolverProgress *progress, size_t count);
 
     // Record statistics from a solver run
     void recordStatistics(int solver_id, const CDCLSolverIncremental &solver,
@@ -135,9 +260,6 @@ private:
     // Release resources allocated to a solver thread
     void releaseResources();
 
-    // Check if the portfolio should terminate
-    bool shouldTerminate() const;
-
     // Signal all solver threads to terminate
     void terminateAllSolvers();
 
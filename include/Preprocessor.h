@@ -199,6 +199,7 @@ public:
 
     // Set problem type
     void setProblemType(ProblemType type);
+    ProblemType getProblemType() const { return problem_type; }
 };
 
 #endif // PREPROCESSOR_H
\ No newline at end of file
@@ -6,6 +6,7 @@
 #include <iostream>
 #include <cmath>
 #include <algorithm>
+#include "Logging.h"
 
 using Clause = std::vector<int>; // A clause is a disjunction (OR) of literals
 using CNF = std::vector<Clause>; // A CNF formula is a conjunction (AND) of clauses
@@ -89,7 +90,7 @@ struct SATInstance
             }
         }
 
-        if (debug_output && best_var != 0)
+        SAT_TRACE(debug_output && best_var != 0)
         {
             std::cout << "VSIDS selected var " << best_var << " with score " << best_score << "\n";
         }
@@ -105,7 +106,7 @@ struct SATInstance
             bumpVarActivity(abs(literal));
         }
 
-        if (debug_output)
+        SAT_TRACE(debug_output)
         {
             std::cout << "Updated activities for conflict variables\n";
         }
@@ -124,7 +125,7 @@ struct SATInstance
             }
         }
 
-        if (debug_output)
+        SAT_TRACE(debug_output)
         {
             std::cout << "Initialized VSIDS activities:\n";
             for (const auto &[var, score] : activity)
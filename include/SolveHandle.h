@@ -0,0 +1,98 @@
+#ifndef SOLVE_HANDLE_H
+#define SOLVE_HANDLE_H
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+enum class SolveStatus
+{
+    RUNNING,
+    SAT,
+    UNSAT,
+    UNKNOWN // Cancelled, timed out or stopped without an answer
+};
+
+struct SolveProgress
+{
+    int conflicts = 0;
+    int decisions = 0;
+    int restarts = 0;
+    int best_trail = 0; // Most variables assigned at once so far: the best partial assignment
+};
+
+// Result of solveAsync() on CDCLSolverIncremental or PortfolioManager. Copies
+// share one outstanding solve. The solve runs on a process-wide executor of
+// solveExecutorThreads() threads, so the caller never blocks; progress() can
+// be polled from any thread while it runs. Completion callbacks run once on
+// the executor thread that finished the solve, or right away in onComplete()
+// if it already has.
+class SolveHandle
+{
+public:
+    using Callback = std::function<void(const SolveHandle &)>;
+
+    SolveHandle() = default; // No solve attached, see valid()
+
+    bool valid() const { return state != nullptr; }
+    bool done() const { return status() != SolveStatus::RUNNING; }
+    SolveStatus status() const;
+
+    // Block until the solve finishes
+    SolveStatus wait() const;
+
+    // Block up to timeout; RUNNING if the solve is still going
+    SolveStatus waitFor(std::chrono::milliseconds timeout) const;
+
+    // Ask the solve to stop; it finishes as UNKNOWN unless it already had an answer
+    void cancel();
+    bool cancelRequested() const { return state && state->cancelled; }
+
+    SolveProgress progress() const;
+
+    void onComplete(Callback callback);
+
+    // Valid once done: the model after SAT, the failed assumptions after UNSAT
+    const std::unordered_map<int, bool> &model() const { return state->model; }
+    const std::vector<int> &core() const { return state->core; }
+
+    static size_t solveExecutorThreads();
+
+private:
+    struct State
+    {
+        std::mutex mutex;
+        std::condition_variable done_cv;
+        SolveStatus status = SolveStatus::RUNNING;
+        std::vector<Callback> callbacks;
+        std::atomic<bool> cancelled{false};
+
+        // Published by the solving thread while it runs
+        std::atomic<int> conflicts{0};
+        std::atomic<int> decisions{0};
+        std::atomic<int> restarts{0};
+        std::atomic<int> best_trail{0};
+        std::function<SolveProgress()> poll; // Overrides the fields above when set
+
+        std::unordered_map<int, bool> model;
+        std::vector<int> core;
+    };
+    std::shared_ptr<State> state;
+
+    // Used by the solvers' solveAsync() and by SolveScheduler
+    friend class CDCLSolverIncremental;
+    friend class PortfolioManager;
+    friend class SolveScheduler;
+
+    static SolveHandle create();
+    static void execute(std::function<void()> task);
+    void publish(const SolveProgress &progress);
+    void complete(SolveStatus status, std::unordered_map<int, bool> model, std::vector<int> core);
+};
+
+#endif // SOLVE_HANDLE_H
@@ -0,0 +1,166 @@
+#ifndef SOLVE_PROTOCOL_H
+#define SOLVE_PROTOCOL_H
+
+#include "SATInstance.h"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Binary wire protocol of the sat_served daemon and the distributed portfolio.
+//
+// Every message is a frame: a 4-byte little-endian payload length, a 1-byte
+// message type, then the payload. Integers inside payloads are LEB128
+// varints; signed values (literals, weights, costs) are zigzag-encoded first,
+// so small literals take one or two bytes. A clause list is its clause count
+// followed by every clause's literals, each clause terminated by 0.
+//
+//   SUBMIT  client -> server  id, kind, flags, timeout_ms, clauses,
+//                             [WCNF: one weight per clause, 0 = hard],
+//                             assumption count, assumptions
+//   CANCEL  client -> server  id
+//   RESULT  server -> client  id, status, cost, literal count, literals
+//
+// Results come back in completion order and carry the client's job id. A SAT
+// result lists the model as literals over variables 1..n; an UNSAT result
+// lists the failed assumptions (empty without assumptions). cost is the
+// violated soft weight of a WCNF job and -1 otherwise.
+//
+// The distributed portfolio (DistributedPortfolio.h) uses the same frames
+// over TCP:
+//
+//   HELLO    worker -> coordinator  solver slots
+//   FORMULA  coordinator -> worker  job id, share length, clauses
+//   TASK     coordinator -> worker  task id, configuration, cube literal
+//                                   count, cube literals
+//   CLAUSES  both ways              job id, clauses
+//   RESULT   worker -> coordinator  as above, id = task id, UNSAT lists the
+//                                   cube literals behind the refutation
+//   CANCEL   coordinator -> worker  job id
+//
+// The formula is sent once per job; tasks then only name a configuration and
+// a cube, solved as assumptions. CLAUSES carries learned clauses of at most
+// share length literals; the coordinator forwards each batch to the other
+// workers.
+
+enum class MessageType : uint8_t
+{
+    SUBMIT = 1,
+    CANCEL = 2,
+    RESULT = 3,
+    HELLO = 4,
+    FORMULA = 5,
+    TASK = 6,
+    CLAUSES = 7
+};
+
+enum class JobKind : uint8_t
+{
+    CNF = 0, // Plain satisfiability, optionally under assumptions
+    WCNF = 1 // Weighted MaxSAT
+};
+
+enum class JobStatus : uint8_t
+{
+    SAT = 0,
+    UNSAT = 1,
+    TIMEOUT = 2,
+    CANCELLED = 3,
+    ERROR = 4 // Malformed or unsupported request
+};
+
+// Job flags
+constexpr uint8_t JOB_FLAG_PORTFOLIO = 1; // Solve with the parallel portfolio
+
+struct JobRequest
+{
+    uint64_t id = 0;
+    JobKind kind = JobKind::CNF;
+    uint8_t flags = 0;
+    uint32_t timeout_ms = 0; // 0 = server default
+    CNF clauses;
+    std::vector<int> weights; // WCNF only, parallel to clauses; 0 marks a hard clause
+    std::vector<int> assumptions;
+};
+
+struct JobResult
+{
+    uint64_t id = 0;
+    JobStatus status = JobStatus::ERROR;
+    int64_t cost = -1;
+    std::vector<int> literals; // Model (SAT) or failed assumptions (UNSAT)
+};
+
+// Distributed portfolio job and task
+struct DistributedFormula
+{
+    uint64_t job_id = 0;
+    uint32_t share_max_length = 0; // 0 disables clause sharing
+    CNF clauses;
+};
+
+struct DistributedTask
+{
+    uint64_t id = 0;
+    uint32_t config = 0;   // Portfolio configuration, see PortfolioManager::applyConfiguration
+    std::vector<int> cube; // Assumptions; empty for the whole formula
+};
+
+// Payload builder
+class MessageWriter
+{
+public:
+    void putByte(uint8_t value) { buffer.push_back(value); }
+    void putUnsigned(uint64_t value);
+    void putSigned(int64_t value);
+    void putClauses(const CNF &clauses);
+
+    const std::vector<uint8_t> &data() const { return buffer; }
+
+private:
+    std::vector<uint8_t> buffer;
+};
+
+// Payload parser; every getter returns false once the input is exhausted or malformed
+class MessageReader
+{
+public:
+    MessageReader(const std::vector<uint8_t> &payload) : data(payload), pos(0) {}
+
+    bool getByte(uint8_t &value);
+    bool getUnsigned(uint64_t &value);
+    bool getSigned(int64_t &value);
+    bool getClauses(CNF &clauses);
+    bool atEnd() const { return pos == data.size(); }
+
+private:
+    const std::vector<uint8_t> &data;
+    size_t pos;
+};
+
+// Payload encoding of the three messages
+std::vector<uint8_t> encodeJobRequest(const JobRequest &request);
+bool decodeJobRequest(const std::vector<uint8_t> &payload, JobRequest &request);
+std::vector<uint8_t> encodeJobResult(const JobResult &result);
+bool decodeJobResult(const std::vector<uint8_t> &payload, JobResult &result);
+std::vector<uint8_t> encodeCancel(uint64_t id);
+bool decodeCancel(const std::vector<uint8_t> &payload, uint64_t &id);
+
+// Payload encoding of the distributed portfolio messages
+std::vector<uint8_t> encodeHello(uint32_t slots);
+bool decodeHello(const std::vector<uint8_t> &payload, uint32_t &slots);
+std::vector<uint8_t> encodeFormula(const DistributedFormula &formula);
+bool decodeFormula(const std::vector<uint8_t> &payload, DistributedFormula &formula);
+std::vector<uint8_t> encodeTask(const DistributedTask &task);
+bool decodeTask(const std::vector<uint8_t> &payload, DistributedTask &task);
+std::vector<uint8_t> encodeClauseBatch(uint64_t job_id, const CNF &clauses);
+bool decodeClauseBatch(const std::vector<uint8_t> &payload, uint64_t &job_id, CNF &clauses);
+
+// Blocking frame I/O on a stream socket; false on EOF or error. Frames larger
+// than MAX_FRAME_SIZE are rejected without reading them.
+constexpr uint32_t MAX_FRAME_SIZE = 1u << 30;
+bool sendFrame(int fd, MessageType type, const std::vector<uint8_t> &payload);
+bool receiveFrame(int fd, MessageType &type, std::vector<uint8_t> &payload);
+
+const char *jobStatusName(JobStatus status);
+
+#endif // SOLVE_PROTOCOL_H
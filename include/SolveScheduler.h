@@ -0,0 +1,64 @@
+#ifndef SOLVE_SCHEDULER_H
+#define SOLVE_SCHEDULER_H
+
+#include "CDCLSolverIncremental.h"
+#include "SolveHandle.h"
+#include "SolveTask.h"
+#include "ThreadPool.h"
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <vector>
+
+// Runs many incremental solves on a few threads. Each submitted solve is a
+// SolveTask (CDCLSolverIncremental::solveSliced) that is resumed for one
+// slice of a fixed number of conflicts or propagations and then goes to the
+// back of the queue, so every running solve gets its turn in round-robin
+// order however long the others take. Thousands of small sessions can share
+// a handful of threads instead of needing one thread each.
+class SolveScheduler
+{
+public:
+    struct Config
+    {
+        int num_threads = std::max(1u, std::thread::hardware_concurrency());
+        int slice_conflicts = 100;        // Conflicts per slice, 0 = no limit
+        int slice_propagations = 100000;  // Propagations per slice, 0 = no limit
+    };
+
+    SolveScheduler();
+    explicit SolveScheduler(const Config &config);
+
+    // Cancels the solves still running and waits for them
+    ~SolveScheduler();
+
+    // Queue solve(assumptions) on the solver. The solver belongs to the
+    // scheduler until the handle is done: do not touch it or submit it again
+    // before then. The handle's progress is updated after every slice.
+    SolveHandle submit(CDCLSolverIncremental &solver, const std::vector<int> &assumptions = {});
+
+    // Block until every submitted solve has finished
+    void wait();
+
+    size_t getActiveSolves() const { return active; }
+    size_t getSlicesRun() const { return slices; }
+
+private:
+    struct Session
+    {
+        CDCLSolverIncremental *solver;
+        SolveTask task;
+        SolveHandle handle;
+    };
+
+    Config config;
+    std::atomic<bool> stopping;
+    std::atomic<size_t> active;
+    std::atomic<size_t> slices;
+    ThreadPool pool; // Last member: its threads stop before the rest is destroyed
+
+    void runSlice(std::shared_ptr<Session> session);
+};
+
+#endif // SOLVE_SCHEDULER_H
@@ -0,0 +1,81 @@
+#ifndef SOLVE_TASK_H
+#define SOLVE_TASK_H
+
+#include <coroutine>
+#include <exception>
+#include <utility>
+
+// Coroutine for a solve that can be suspended part way, returned by
+// CDCLSolverIncremental::solveSliced. It starts suspended; each resume()
+// runs the search until the next slice boundary or the end, so one thread
+// can take turns between many solvers (see SolveScheduler.h). Destroying an
+// unfinished task abandons the solve; the solver's next solve starts afresh.
+class SolveTask
+{
+public:
+    struct promise_type
+    {
+        bool result = false;
+        std::exception_ptr exception; // Thrown by the solve, rethrown by resume()
+
+        SolveTask get_return_object()
+        {
+            return SolveTask(std::coroutine_handle<promise_type>::from_promise(*this));
+        }
+        std::suspend_always initial_suspend() noexcept { return {}; }
+        std::suspend_always final_suspend() noexcept { return {}; }
+        void return_value(bool value) { result = value; }
+        void unhandled_exception() { exception = std::current_exception(); }
+    };
+
+    SolveTask() = default;
+    SolveTask(SolveTask &&other) noexcept : coroutine(std::exchange(other.coroutine, nullptr)) {}
+    SolveTask &operator=(SolveTask &&other) noexcept
+    {
+        if (this != &other)
+        {
+            reset();
+            coroutine = std::exchange(other.coroutine, nullptr);
+        }
+        return *this;
+    }
+    SolveTask(const SolveTask &) = delete;
+    SolveTask &operator=(const SolveTask &) = delete;
+    ~SolveTask() { reset(); }
+
+    // Run one slice; true once the solve has finished. An exception from
+    // the solve (std::bad_alloc) ends it and is rethrown here.
+    bool resume()
+    {
+        if (!done())
+        {
+            coroutine.resume();
+            if (coroutine.promise().exception)
+            {
+                std::rethrow_exception(std::exchange(coroutine.promise().exception, nullptr));
+            }
+        }
+        return done();
+    }
+
+    bool done() const { return !coroutine || coroutine.done(); }
+
+    // Return value of the solve, valid once done
+    bool result() const { return coroutine && coroutine.promise().result; }
+
+private:
+    std::coroutine_handle<promise_type> coroutine;
+
+    explicit SolveTask(std::coroutine_handle<promise_type> handle) : coroutine(handle) {}
+
+    void reset()
+    {
+        if (coroutine)
+        {
+            coroutine.destroy();
+            coroutine = nullptr;
+        }
+    }
+};
+
+#endif // SOLVE_TASK_H
@@ -0,0 +1,62 @@
+#ifndef SOLVER_CHECKPOINT_H
+#define SOLVER_CHECKPOINT_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Per-clause record of a checkpoint; the literals live in one shared array
+struct CheckpointClause
+{
+    uint32_t size;
+    int32_t lbd;
+    float activity;
+    uint32_t flags; // CHECKPOINT_* bits
+};
+
+constexpr uint32_t CHECKPOINT_LEARNED = 1;
+constexpr uint32_t CHECKPOINT_USED = 2;
+
+// Search state of a CDCLSolverIncremental between restarts: the clause
+// database with learned clauses, variable activities, phases, the restart
+// schedule and the level-0 facts. Produced by the solver as a snapshot, so
+// it can be written out while the search goes on.
+struct SolverCheckpoint
+{
+    uint32_t num_vars = 0;
+    bool has_empty_clause = false;
+
+    // Restart schedule and activity increments
+    int32_t restart_threshold = 0;
+    int32_t luby_index = 1;
+    double var_inc = 1.0;
+    double clause_activity_inc = 1.0;
+
+    // Statistics carried across the resume
+    int64_t conflicts = 0;
+    int64_t decisions = 0;
+    int64_t propagations = 0;
+    int64_t restarts = 0;
+
+    std::vector<CheckpointClause> clauses;
+    std::vector<int32_t> literals;       // Every clause's literals back to back
+    std::vector<double> activity;        // VSIDS score per variable, index 0 unused
+    std::vector<int8_t> saved_phase;     // Per variable, 1 = true, -1 = false, 0 = none
+    std::vector<int8_t> target_phase;
+    std::vector<int8_t> forced_phase;
+    std::vector<int32_t> root_trail;     // Level-0 facts in trail order
+    std::vector<int32_t> temporary_groups; // Activation literals of live groups
+};
+
+// File format (version 1, native little-endian): a fixed header with the
+// scalar fields and an offset/count pair per array, then every array at an
+// 8-byte aligned offset, so a mapped file can be read in place. Files are
+// written to a temporary name and renamed, so a reader never sees a partial
+// checkpoint.
+bool writeCheckpoint(const std::string &path, const SolverCheckpoint &checkpoint);
+
+// Map and validate a checkpoint file; false if it is missing, truncated or
+// of another version
+bool readCheckpoint(const std::string &path, SolverCheckpoint &checkpoint);
+
+#endif // SOLVER_CHECKPOINT_H
@@ -0,0 +1,117 @@
+#ifndef SOLVER_DAEMON_H
+#define SOLVER_DAEMON_H
+
+#include "SolveProtocol.h"
+#include "FormulaCache.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+class PortfolioManager;
+
+// Long-running solver service behind a Unix domain socket (see sat_served).
+// Clients submit CNF/WCNF jobs with the protocol in SolveProtocol.h; jobs wait
+// in one FIFO queue and a fixed set of worker threads solves them, large or
+// flagged CNF jobs with a PortfolioManager. Results are written back on the
+// submitting connection as soon as each job finishes. A job stops at its
+// timeout or when cancelled, explicitly or by its connection closing. With a
+// cache, SAT/UNSAT answers are kept in a FormulaCache and repeats skip the
+// solver. A job that is malformed, too large or fails while solving is
+// answered with ERROR; it never takes the daemon down.
+class SolverDaemon
+{
+public:
+    struct Config
+    {
+        std::string socket_path = "/tmp/sat_served.sock";
+        int num_workers = std::max(1u, std::thread::hardware_concurrency());
+        size_t portfolio_threshold = 50000; // CNF jobs with at least this many clauses use the portfolio
+        int portfolio_threads = 4;          // Threads per portfolio job
+        std::chrono::milliseconds default_timeout = std::chrono::seconds(60);
+        size_t cache_capacity = 0;   // Cached answers, 0 disables the result cache
+        std::string cache_path;      // Persist the cache here when set
+        bool cache_renaming = false; // Also answer renamed repeats
+        int max_variables = 10000000; // Jobs over more variables are answered with ERROR
+    };
+
+    SolverDaemon(const Config &config);
+    ~SolverDaemon();
+
+    // Bind the socket and serve until stop(); false if the socket cannot be set up
+    bool run();
+
+    // Ask run() to return; safe to call from a signal handler
+    void stop() { stopping = true; }
+
+    // Counters since start
+    size_t getJobsCompleted() const { return jobs_completed; }
+    size_t getJobsCancelled() const { return jobs_cancelled; }
+    size_t getCacheHits() const { return cache ? cache->getHits() : 0; }
+
+private:
+    struct Connection;
+
+    // One submitted job, shared by the queue, the worker and its connection
+    struct Job
+    {
+        JobRequest request;
+        std::shared_ptr<Connection> connection;
+        std::atomic<bool> cancelled{false};
+        std::mutex mutex;                       // Guards portfolio
+        PortfolioManager *portfolio = nullptr; // Set while a portfolio solves the job
+    };
+
+    // A client connection: results from several workers share the socket. The
+    // descriptor is closed with the last reference, so a late result can never
+    // reach a different client that reused the number.
+    struct Connection
+    {
+        int fd = -1;
+        std::mutex write_mutex;
+        std::mutex jobs_mutex;
+        std::unordered_map<uint64_t, std::shared_ptr<Job>> jobs; // Submitted, not yet answered
+
+        ~Connection();
+    };
+
+    Config config;
+    std::atomic<bool> stopping;
+    int listen_fd;
+
+    // Job queue served by the workers
+    std::deque<std::shared_ptr<Job>> queue;
+    std::mutex queue_mutex;
+    std::condition_variable queue_cv;
+    std::vector<std::thread> workers;
+
+    // Connection readers run detached; shutdown waits for active_readers to drop to 0
+    std::mutex connections_mutex;
+    std::condition_variable readers_cv;
+    std::vector<std::shared_ptr<Connection>> connections;
+    int active_readers;
+
+    std::unique_ptr<FormulaCache> cache;
+
+    std::atomic<size_t> jobs_completed;
+    std::atomic<size_t> jobs_cancelled;
+
+    void readerLoop(std::shared_ptr<Connection> connection);
+    void workerLoop();
+    JobResult solveJob(Job &job);
+    JobResult solveUncached(Job &job);
+    JobResult solveCNF(Job &job, std::chrono::milliseconds timeout);
+    JobResult solveWCNF(Job &job, std::chrono::milliseconds timeout);
+    void cancel(Job &job);
+    void finish(Job &job, const JobResult &result);
+    void shutdown();
+};
+
+#endif // SOLVER_DAEMON_H
@@ -0,0 +1,40 @@
+#ifndef THREAD_POOL_H
+#define THREAD_POOL_H
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Fixed set of worker threads serving a FIFO task queue. The threads live as
+// long as the pool, so submitting work costs a queue push, not a thread start.
+class ThreadPool
+{
+public:
+    explicit ThreadPool(size_t num_threads = std::thread::hardware_concurrency());
+
+    // Finishes queued tasks, then joins the workers
+    ~ThreadPool();
+
+    void submit(std::function<void()> task);
+
+    // Block until every task submitted so far has finished
+    void wait();
+
+    size_t size() const { return workers.size(); }
+
+private:
+    std::vector<std::thread> workers;
+    std::deque<std::function<void()>> tasks;
+    std::mutex mutex;
+    std::condition_variable task_cv; // Work queued or stopping
+    std::condition_variable idle_cv; // Queue drained and no task running
+    size_t running;                  // Tasks currently executing
+    bool stopping;
+
+    void workerLoop();
+};
+
+#endif // THREAD_POOL_H
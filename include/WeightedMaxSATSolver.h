@@ -18,14 +18,22 @@ public:
 
     int getNumSolverCalls() const;
 
+    // Handed to every inner MaxSATSolver. Set when an inner search was
+    // stopped or timed out; the result is then -1 and unproven
+    void setTerminateCallback(std::function<bool()> callback) { terminate_callback = std::move(callback); }
+    bool wasInterrupted() const { return interrupted; }
+
 private:
     bool checkWeightLimit(int weight_limit);
+    int runSolver(MaxSATSolver &solver); // Linear search, recording calls and interruptions
 
     CNF hard_clauses;
     CNF soft_clauses;
     std::vector<int> weights;
     bool debug_output;
     int solver_calls;
+    bool interrupted;
+    std::function<bool()> terminate_callback;
 
     // New variables for warm starting
     std::unordered_map<int, bool> last_solution;
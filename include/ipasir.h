@@ -0,0 +1,49 @@
+#ifndef IPASIR_H
+#define IPASIR_H
+
+// IPASIR: the standard C interface for incremental SAT solvers.
+// Implemented in src/IpasirInterface.cpp on top of CDCLSolverIncremental and
+// shipped in libsatsolver (shared and static).
+//
+// Literals are non-zero ints in DIMACS convention. Clauses are added one literal
+// at a time and terminated by 0. Assumptions hold for the next ipasir_solve call
+// only. ipasir_solve returns 10 (SAT), 20 (UNSAT) or 0 (interrupted).
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+    // Name and version of the solver
+    const char *ipasir_signature(void);
+
+    // Create a new solver instance; release it with ipasir_release
+    void *ipasir_init(void);
+    void ipasir_release(void *solver);
+
+    // Add a literal to the clause under construction, 0 finishes the clause
+    void ipasir_add(void *solver, int lit_or_zero);
+
+    // Assume a literal for the next solve call
+    void ipasir_assume(void *solver, int lit);
+
+    // Solve under the current assumptions: 10 = SAT, 20 = UNSAT, 0 = interrupted
+    int ipasir_solve(void *solver);
+
+    // After SAT: lit if lit is true in the model, -lit otherwise
+    int ipasir_val(void *solver, int lit);
+
+    // After UNSAT: 1 if the assumption lit was used to prove unsatisfiability
+    int ipasir_failed(void *solver, int lit);
+
+    // Callback polled during search; a non-zero return stops ipasir_solve
+    void ipasir_set_terminate(void *solver, void *data, int (*terminate)(void *data));
+
+    // Callback receiving learned clauses of at most max_length literals (0-terminated)
+    void ipasir_set_learn(void *solver, void *data, int max_length, void (*learn)(void *data, int *clause));
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // IPASIR_H
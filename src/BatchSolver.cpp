@@ -0,0 +1,158 @@
+#include "../include/BatchSolver.h"
+#include "../include/CDCLSolverIncremental.h"
+#include "../include/PortfolioManager.h"
+
+namespace
+{
+    std::vector<int> modelLiterals(const std::unordered_map<int, bool> &assignment, int num_vars)
+    {
+        std::vector<int> model;
+        model.reserve(num_vars);
+        for (int var = 1; var <= num_vars; var++)
+        {
+            auto it = assignment.find(var);
+            model.push_back(it != assignment.end() && it->second ? var : -var);
+        }
+        return model;
+    }
+
+    int maxVariable(const CNF &formula)
+    {
+        int num_vars = 0;
+        for (const auto &clause : formula)
+        {
+            for (int lit : clause)
+            {
+                num_vars = std::max(num_vars, std::abs(lit));
+            }
+        }
+        return num_vars;
+    }
+}
+
+BatchSolver::BatchSolver(const Config &config)
+    : config(config),
+      pool(config.num_threads),
+      escalated(0)
+{
+}
+
+BatchSolver::~BatchSolver() = default;
+
+// Two phases: the pool works through every instance under the conflict
+// budget, then the unresolved ones get a portfolio each, in index order.
+// make_instance is called from the worker threads concurrently.
+std::vector<BatchResult> BatchSolver::solve(size_t count, const InstanceSource &make_instance,
+                                            const ResultCallback &on_result)
+{
+    std::vector<BatchResult> results(count);
+    std::vector<char> unresolved(count, 0);
+    std::atomic<size_t> next(0);
+
+    auto report = [&](size_t i)
+    {
+        if (on_result)
+        {
+            std::lock_guard<std::mutex> lock(callback_mutex);
+            on_result(i, results[i]);
+        }
+    };
+
+    // One task per worker, each pulling the next instance until none are left
+    for (size_t w = 0; w < pool.size(); w++)
+    {
+        pool.submit([&]()
+                    {
+            for (size_t i = next++; i < count; i = next++)
+            {
+                results[i] = solveBudgeted(make_instance(i));
+                if (results[i].status == BatchStatus::UNKNOWN)
+                {
+                    unresolved[i] = 1;
+                }
+                else
+                {
+                    report(i);
+                }
+            } });
+    }
+    pool.wait();
+
+    for (size_t i = 0; i < count; i++)
+    {
+        if (unresolved[i])
+        {
+            escalated++;
+            solvePortfolio(make_instance(i), results[i]);
+            report(i);
+        }
+    }
+    return results;
+}
+
+std::vector<BatchResult> BatchSolver::solve(const std::vector<CNF> &instances, const ResultCallback &on_result)
+{
+    return solve(instances.size(), [&instances](size_t i)
+                 { return instances[i]; }, on_result);
+}
+
+// Single solver, stopped by the terminate callback once the budget is spent
+BatchResult BatchSolver::solveBudgeted(const CNF &formula) const
+{
+    BatchResult result;
+    auto start = std::chrono::high_resolution_clock::now();
+
+    CDCLSolverIncremental solver(formula);
+    solver.setTimeout(config.timeout);
+    int budget = config.conflict_budget;
+    solver.setTerminateCallback([&solver, budget]()
+                                { return solver.getConflicts() >= budget; });
+
+    bool sat = solver.solve();
+    if (sat)
+    {
+        result.status = BatchStatus::SAT;
+        if (config.keep_models)
+        {
+            result.model = modelLiterals(solver.getAssignments(), maxVariable(formula));
+        }
+    }
+    else if (!solver.wasInterrupted())
+    {
+        result.status = BatchStatus::UNSAT;
+    }
+
+    result.conflicts = solver.getConflicts();
+    result.decisions = solver.getDecisions();
+    result.time = std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::high_resolution_clock::now() - start);
+    return result;
+}
+
+// Escalations run one after another, so they share one portfolio and its threads
+void BatchSolver::solvePortfolio(const CNF &formula, BatchResult &result)
+{
+    auto start = std::chrono::high_resolution_clock::now();
+
+    if (!portfolio)
+    {
+        portfolio = std::make_unique<PortfolioManager>(formula, config.timeout, config.portfolio_threads);
+    }
+    bool sat = portfolio->solve(formula);
+
+    result.escalated = true;
+    if (sat)
+    {
+        result.status = BatchStatus::SAT;
+        if (config.keep_models)
+        {
+            result.model = modelLiterals(portfolio->getSolution(), maxVariable(formula));
+        }
+    }
+    else
+    {
+        result.status = portfolio->isUnsatProven() ? BatchStatus::UNSAT : BatchStatus::UNKNOWN;
+    }
+    result.time += std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::high_resolution_clock::now() - start);
+}
@@ -34,7 +34,7 @@ CDCLSolver::CDCLSolver(const CNF &formula, bool debug)
     // Initialize VSIDS activities
     instance.initializeVSIDS();
 
-    if (debug_output)
+    SAT_INFO(debug_output)
     {
         std::cout << "CDCL Solver initialized with " << num_variables << " variables and "
                   << formula.size() << " clauses.\n";
@@ -67,7 +67,7 @@ bool CDCLSolver::solve()
         // Check if we should restart
         if (conflicts >= restart_threshold)
         {
-            if (debug_output)
+            SAT_TRACE(debug_output)
             {
                 std::cout << "Restarting after " << conflicts << " conflicts\n";
             }
@@ -90,7 +90,7 @@ bool CDCLSolver::solve()
             // Handle conflict at decision level 0
             if (decision_level == 0)
             {
-                if (debug_output)
+                SAT_TRACE(debug_output)
                 {
                     std::cout << "Conflict at decision level 0. Formula is UNSATISFIABLE.\n";
                 }
@@ -155,7 +155,7 @@ bool CDCLSolver::solve()
 
                 if (all_satisfied)
                 {
-                    if (debug_output)
+                    SAT_TRACE(debug_output)
                     {
                         std::cout << "All clauses satisfied. Formula is SATISFIABLE.\n";
                     }
@@ -163,7 +163,7 @@ bool CDCLSolver::solve()
                 }
                 else
                 {
-                    if (debug_output)
+                    SAT_TRACE(debug_output)
                     {
                         std::cout << "No more decisions possible but formula not satisfied. UNSATISFIABLE.\n";
                     }
@@ -192,7 +192,7 @@ void CDCLSolver::initWatchedLiterals()
 
         if (clause.empty())
         {
-            if (debug_output)
+            SAT_TRACE(debug_output)
             {
                 std::cout << "Empty clause detected during initialization. Formula is UNSATISFIABLE.\n";
             }
@@ -220,7 +220,7 @@ void CDCLSolver::initWatchedLiterals()
         }
     }
 
-    if (debug_output)
+    SAT_TRACE(debug_output)
     {
         std::cout << "Watched literals initialized.\n";
         printWatches();
@@ -269,7 +269,7 @@ bool CDCLSolver::unitPropagate()
             // If all literals are assigned and false, this is a conflict
             if (unassigned_lits.empty())
             {
-                if (debug_output)
+                SAT_TRACE(debug_output)
                 {
                     std::cout << "Conflict detected: all literals in clause are false\n";
                 }
@@ -286,7 +286,7 @@ bool CDCLSolver::unitPropagate()
                 int var = abs(unit_lit);
                 bool value = (unit_lit > 0);
 
-                if (debug_output)
+                SAT_TRACE(debug_output)
                 {
                     std::cout << "Unit propagation: x" << var << " = " << value << " at level "
                               << decision_level << "\n";
@@ -310,7 +310,7 @@ bool CDCLSolver::unitPropagate()
 
 int CDCLSolver::analyzeConflict(const Clause &conflict_clause, Clause &learned_clause)
 {
-    if (debug_output)
+    SAT_TRACE(debug_output)
     {
         std::cout << "Analyzing conflict in clause: ";
         printClause(conflict_clause);
@@ -334,7 +334,7 @@ int CDCLSolver::analyzeConflict(const Clause &conflict_clause, Clause &learned_c
         }
     }
 
-    if (debug_output)
+    SAT_TRACE(debug_output)
     {
         std::cout << "Current level variables in conflict: " << current_level_vars.size() << "\n";
     }
@@ -374,7 +374,7 @@ int CDCLSolver::analyzeConflict(const Clause &conflict_clause, Clause &learned_c
         int var = abs(node.literal);
         const Clause &antecedent = node.antecedent;
 
-        if (debug_output)
+        SAT_TRACE(debug_output)
         {
             std::cout << "Resolving with antecedent of x" << var << ": ";
             printClause(antecedent);
@@ -416,7 +416,7 @@ int CDCLSolver::analyzeConflict(const Clause &conflict_clause, Clause &learned_c
         // Remove the variable from the current level set
         current_level_vars.erase(var);
 
-        if (debug_output)
+        SAT_TRACE(debug_output)
         {
             std::cout << "After resolution, learned clause: ";
             printClause(learned_clause);
@@ -431,7 +431,7 @@ int CDCLSolver::analyzeConflict(const Clause &conflict_clause, Clause &learned_c
     std::sort(learned_clause.begin(), learned_clause.end());
     learned_clause.erase(std::unique(learned_clause.begin(), learned_clause.end()), learned_clause.end());
 
-    if (debug_output)
+    SAT_TRACE(debug_output)
     {
         std::cout << "Final learned clause: ";
         printClause(learned_clause);
@@ -443,7 +443,7 @@ int CDCLSolver::analyzeConflict(const Clause &conflict_clause, Clause &learned_c
 
 void CDCLSolver::backtrack(int level)
 {
-    if (debug_output)
+    SAT_TRACE(debug_output)
     {
         std::cout << "Backtracking from level " << decision_level << " to level " << level << "\n";
     }
@@ -469,7 +469,7 @@ void CDCLSolver::backtrack(int level)
     // Update the decision level
     decision_level = level;
 
-    if (debug_output)
+    SAT_TRACE(debug_output)
     {
         std::cout << "After backtracking, trail size: " << trail.size() << "\n";
         printTrail();
@@ -496,7 +496,7 @@ bool CDCLSolver::makeDecision()
     bool value = true;
     int literal = var; // positive literal
 
-    if (debug_output)
+    SAT_TRACE(debug_output)
     {
         std::cout << "Decision: x" << var << " = " << value << " at level " << decision_level << "\n";
     }
@@ -515,7 +515,7 @@ void CDCLSolver::addLearnedClause(const Clause &clause)
 {
     if (clause.empty())
     {
-        if (debug_output)
+        SAT_TRACE(debug_output)
         {
             std::cout << "Learned an empty clause. Formula is UNSATISFIABLE.\n";
         }
@@ -528,7 +528,7 @@ void CDCLSolver::addLearnedClause(const Clause &clause)
     instance.formula.push_back(clause);
     learned_clauses++;
 
-    if (debug_output)
+    SAT_TRACE(debug_output)
     {
         std::cout << "Added learned clause: ";
         printClause(clause);
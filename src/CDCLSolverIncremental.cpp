@@ -11,7 +11,9 @@
 
 // Constructor from a CNF formula
 CDCLSolverIncremental::CDCLSolverIncremental(const CNF &formula, bool debug, PortfolioManager *portfolio_manager)
-    : decision_level(0),
+    : propagate_head(0),
+      watch_epoch(0),
+      decision_level(0),
       var_inc(1.0),
       var_decay(0.95),
       conflicts_since_restart(0),
@@ -19,19 +21,39 @@ CDCLSolverIncremental::CDCLSolverIncremental(const CNF &formula, bool debug, Por
       restart_multiplier(1.5),
       luby_index(1),
       use_luby_restarts(true),
+      next_solve_group(0),
       last_solved_until(-1),
+      root_level_units(0),
       conflicts(0),
       decisions(0),
       propagations(0),
       restarts(0),
       max_decision_level(0),
+      hyper_binaries(0),
+      strengthened(0),
+      subsumed(0),
+      replayed(0),
+      target_trail_size(0),
+      best_trail(0),
       use_lbd(true),
       use_phase_saving(true),
-      debug_output(false),
+      use_hyper_binary(false),
+      use_trail_saving(true),
+      debug_output(debug),
+      checkpoint_interval(0),
+      checkpoint_busy(false),
+      checkpoints_written(0),
+      compaction_requested(false),
+      requested_max_learnts(0),
+      compactions(0),
       timeout_duration(std::chrono::milliseconds(30000)), // 30 second timeout
       stuck_counter(0),
       conflict_clause_id(0),
-      portfolio_manager(portfolio_manager)
+      saved_head(0),
+      portfolio_manager(portfolio_manager),
+      interrupted(false),
+      has_empty_clause(false),
+      learn_max_length(0)
 { // Initialize stuck counter
 
     // Find the number of variables in the formula
@@ -46,20 +68,37 @@ CDCLSolverIncremental::CDCLSolverIncremental(const CNF &formula, bool debug, Por
 
     // Initialize clause database
     db = std::make_unique<ClauseDatabase>(num_vars, debug);
+    db->is_locked = [this](ClauseID id)
+    { return isLocked(id); };
 
     // Initialize decision level array (1-indexed for variables)
     decision_levels.resize(num_vars + 1, 0);
+    lit_values.resize(2 * (num_vars + 1), 0);
+    forced_phase.resize(num_vars + 1, 0);
+    target_phase.resize(num_vars + 1, 0);
+    saved_phase.resize(num_vars + 1, 0);
 
-    // Add all clauses to the database
+    // Bulk load all clauses, then build every watch list in one pass
+    db->reserve(formula.size());
     for (const auto &clause : formula)
     {
-        db->addClause(clause);
+        if (clause.empty())
+        {
+            has_empty_clause = true;
+            continue;
+        }
+        db->appendClause(clause);
     }
+    db->initWatches();
+
+    // Binary-implication minimization and vivification of learned clauses
+    minimizer = std::make_unique<ClauseMinimizer>(*db, debug, this);
 
     // Initialize VSIDS scores
+    activity.reserve(num_vars + 1);
     initializeVSIDS();
 
-    if (debug_output)
+    SAT_INFO(debug_output)
     {
         std::cout << "CDCLSolverIncremental initialized with " << num_vars << " variables and "
                   << formula.size() << " clauses.\n";
@@ -68,7 +107,18 @@ CDCLSolverIncremental::CDCLSolverIncremental(const CNF &formula, bool debug, Por
 
 CDCLSolverIncremental::~CDCLSolverIncremental()
 {
-    // Smart pointer handles cleanup of clause database
+    // An asynchronous solve still uses this solver
+    if (async_solve.valid())
+    {
+        async_solve.cancel();
+        async_solve.wait();
+    }
+
+    // Let a background checkpoint finish; smart pointers handle the rest
+    if (checkpoint_writer.joinable())
+    {
+        checkpoint_writer.join();
+    }
 }
 
 // Main solving method
@@ -79,14 +129,141 @@ bool CDCLSolverIncremental::solve()
     return solve(assumptions);
 }
 
-// Solve with assumptions
+// Solve with assumptions; live temporary groups are assumed as well
 bool CDCLSolverIncremental::solve(const std::vector<int> &assume)
+{
+    SolveTask task = solveSliced(assume, 0);
+    task.resume();
+    return task.result();
+}
+
+// solve(assumptions) as a coroutine that gives up its thread every
+// slice_conflicts conflicts or slice_propagations propagations (0 = no limit)
+SolveTask CDCLSolverIncremental::solveSliced(std::vector<int> assume, int slice_conflicts, int slice_propagations,
+                                             bool at_restart)
+{
+    std::vector<int> all_assumptions = assume;
+    all_assumptions.insert(all_assumptions.end(), temporary_groups.begin(), temporary_groups.end());
+
+    SolveTask search_task = search(all_assumptions, slice_conflicts, slice_propagations, at_restart);
+    while (!search_task.resume())
+    {
+        co_await std::suspend_always{};
+    }
+    bool result = search_task.result();
+
+    // Activation literals are internal; the core only reports caller assumptions
+    if (!result && !temporary_groups.empty())
+    {
+        core.erase(std::remove_if(core.begin(), core.end(),
+                                  [this](int lit)
+                                  { return temporary_groups.count(lit) > 0; }),
+                   core.end());
+    }
+    assumptions = assume;
+
+    // Clauses added with addTemporaryClause(clause) only live for one call
+    if (next_solve_group != 0)
+    {
+        retractTemporaryGroup(next_solve_group);
+        next_solve_group = 0;
+    }
+
+    co_return result;
+}
+
+// Run solve(assumptions) on the executor. A terminate callback installed for
+// the run publishes progress, honours cancel() and still asks any callback
+// the caller had set.
+SolveHandle CDCLSolverIncremental::solveAsync(const std::vector<int> &assume)
+{
+    if (async_solve.valid() && !async_solve.done())
+    {
+        SolveHandle busy = SolveHandle::create();
+        busy.complete(SolveStatus::UNKNOWN, {}, {});
+        return busy;
+    }
+
+    SolveHandle handle = SolveHandle::create();
+    async_solve = handle;
+    SolveHandle::execute([this, handle, assume]() mutable
+                         {
+        // A solve that throws (std::bad_alloc) ends as UNKNOWN instead of
+        // escaping into the executor
+        bool sat = false;
+        bool threw = false;
+        {
+            TerminateScope scope(terminate_callback);
+            terminate_callback = [this, &handle, &scope]()
+            {
+                handle.publish(getProgress());
+                return handle.cancelRequested() || (scope.previous && scope.previous());
+            };
+            try
+            {
+                sat = solve(assume);
+            }
+            catch (...)
+            {
+                threw = true;
+            }
+        }
+        handle.publish(getProgress());
+
+        // Everything the handle needs is copied out before waiters wake
+        SolveStatus status = threw         ? SolveStatus::UNKNOWN
+                             : sat         ? SolveStatus::SAT
+                             : interrupted ? SolveStatus::UNKNOWN
+                                           : SolveStatus::UNSAT;
+        std::unordered_map<int, bool> model;
+        std::vector<int> failed;
+        if (status == SolveStatus::SAT)
+        {
+            model = assignments;
+        }
+        else if (status == SolveStatus::UNSAT)
+        {
+            failed = core;
+        }
+        handle.complete(status, std::move(model), std::move(failed)); });
+    return handle;
+}
+
+SolveProgress CDCLSolverIncremental::getProgress() const
+{
+    SolveProgress progress;
+    progress.conflicts = conflicts;
+    progress.decisions = decisions;
+    progress.restarts = restarts;
+    progress.best_trail = static_cast<int>(best_trail);
+    return progress;
+}
+
+// CDCL search under the given assumptions. With a slice limit it suspends
+// once that many conflicts or propagations have passed since the last resume,
+// right away or, with at_restart, at the next restart; the trail and learned
+// clauses stay intact. The time spent suspended does not count against the
+// timeout.
+SolveTask CDCLSolverIncremental::search(std::vector<int> assume, int slice_conflicts, int slice_propagations,
+                                        bool at_restart)
 {
     // Store start time for timeout
     start_time = std::chrono::high_resolution_clock::now();
 
     // Store the assumptions
     assumptions = assume;
+    interrupted = false;
+    for (int lit : assumptions)
+    {
+        ensureVariable(std::abs(lit));
+    }
+
+    // An empty clause makes every call UNSAT, regardless of assumptions
+    if (has_empty_clause)
+    {
+        core.clear();
+        co_return false;
+    }
 
     // Check for contradictory assumptions
     for (size_t i = 0; i < assumptions.size(); i++)
@@ -97,33 +274,47 @@ bool CDCLSolverIncremental::solve(const std::vector<int> &assume)
             int lit2 = assumptions[j];
             if (lit1 == -lit2)
             {
-                if (debug_output)
+                SAT_DEBUG(debug_output)
                 {
                     std::cout << "Contradictory assumptions: " << lit1 << " and " << lit2 << "\n";
                 }
 
                 // Create a core with these contradictory assumptions
                 core = {lit1, lit2};
-                return false;
+                co_return false;
             }
         }
     }
 
     // Clear trail and variable states for a fresh start
     trail.clear();
+    propagate_head = 0;
+    saved_trail.clear();
     var_to_trail.clear();
     assignments.clear();
+    std::fill(lit_values.begin(), lit_values.end(), 0);
     for (size_t i = 0; i < decision_levels.size(); i++)
     {
         decision_levels[i] = 0;
     }
     decision_level = 0;
     conflicts_since_restart = 0;
+    target_trail_size = 0;
+    best_trail = 0;
 
-    // Initialize watches if this is a fresh solve
+    // Build watches on the first solve only; later clauses and variables are
+    // watched as they are added
     if (last_solved_until == -1)
     {
         db->initWatches();
+        last_solved_until = 0;
+    }
+
+    // Fix everything the formula implies on its own before any assumption is applied
+    if (!propagateRootLevel())
+    {
+        core.clear();
+        co_return false;
     }
 
     // Apply assumptions as unit clauses
@@ -134,16 +325,20 @@ bool CDCLSolverIncremental::solve(const std::vector<int> &assume)
 
         // Check for contradictory assumptions
         auto it = assignments.find(var);
+        if (it != assignments.end() && it->second == value)
+        {
+            continue; // Already implied at the root
+        }
         if (it != assignments.end() && it->second != value)
         {
-            if (debug_output)
+            SAT_DEBUG(debug_output)
             {
                 std::cout << "Contradictory assumptions, formula is UNSAT\n";
             }
 
             // Create a core with just this contradictory assumption
             core = {lit};
-            return false;
+            co_return false;
         }
 
         // Add to trail
@@ -152,76 +347,29 @@ bool CDCLSolverIncremental::solve(const std::vector<int> &assume)
 
         // Update assignment
         assignments[var] = value;
+        setVarValue(var, value);
         decision_levels[var] = 0; // Assumptions are at level 0
     }
 
     // Check for immediate unit propagation conflicts
     if (!unitPropagate())
     {
-        if (debug_output)
+        if (interrupted)
         {
-            std::cout << "Conflict during initial unit propagation, formula is UNSAT\n";
+            co_return false;
         }
 
-        conflicts++; // Increment conflict counter
-
-        // Extract UNSAT core from the conflict
-        Clause learned_clause;
-        int backtrack_level = analyzeConflict(conflict_clause_id, learned_clause);
-
-        // Calculate LBD if enabled
-        int lbd = use_lbd ? db->computeLBD(learned_clause, decision_levels) : learned_clause.size();
-
-        // Add the learned clause to the database
-        db->addLearnedClause(learned_clause, lbd);
-
-        // Bump VSIDS scores for variables in the learned clause
-        for (int lit : learned_clause)
+        SAT_DEBUG(debug_output)
         {
-            bumpVarActivity(std::abs(lit));
+            std::cout << "Conflict during initial unit propagation, formula is UNSAT\n";
         }
 
-        // Decay VSIDS scores
-        decayVarActivities();
-
-        // Extract the core assumptions
-        core.clear();
-        for (int assumption : assumptions)
-        {
-            int var = std::abs(assumption);
-
-            // Check if this variable appears in the learned clause with correct polarity
-            bool var_in_learned_clause = false;
-            for (int learned_lit : learned_clause)
-            {
-                // Check for exact literal match to respect polarity
-                if (learned_lit == -assumption)
-                {
-                    var_in_learned_clause = true;
-                    break;
-                }
-            }
-
-            if (!var_in_learned_clause)
-            {
-                continue; // Skip this assumption if not in learned clause
-            }
-
-            // Now check if it was assigned as an assumption at level 0
-            auto trail_it = var_to_trail.find(var);
-            if (trail_it != var_to_trail.end())
-            {
-                const auto &node = trail[trail_it->second];
+        conflicts++; // Increment conflict counter
 
-                // Include this assumption if it was assigned at level 0
-                if (node.decision_level == 0 && node.is_decision)
-                {
-                    core.push_back(assumption);
-                }
-            }
-        }
+        // The assumptions alone contradict the formula
+        analyzeFinal(conflict_clause_id);
 
-        return false;
+        co_return false;
     }
 
     // Main CDCL loop
@@ -237,6 +385,8 @@ bool CDCLSolverIncremental::solve(const std::vector<int> &assume)
     int consecutive_restarts = 0;
     int last_decision_level = 0;
     int stuck_at_level_count = 0;
+    int slice_conflict_start = conflicts;
+    int slice_propagation_start = propagations;
 
     while (iterations < MAX_ITERATIONS)
     {
@@ -245,12 +395,12 @@ bool CDCLSolverIncremental::solve(const std::vector<int> &assume)
         // Check for timeout at the start of each iteration
         if (checkTimeout())
         {
-            if (debug_output)
+            SAT_DEBUG(debug_output)
             {
                 std::cout << "Timeout reached after " << iterations << " iterations.\n";
                 printStatistics();
             }
-            return false;
+            co_return false;
         }
 
         // Enhanced stuck detection
@@ -337,7 +487,7 @@ bool CDCLSolverIncremental::solve(const std::vector<int> &assume)
             // If stuck for too long, try a restart
             if (stuck_counter > 50)
             { // Changed back to 50 from 200
-                if (debug_output)
+                SAT_DEBUG(debug_output)
                 {
                     std::cout << "No progress for " << stuck_counter << " iterations, forcing restart.\n";
                 }
@@ -345,12 +495,14 @@ bool CDCLSolverIncremental::solve(const std::vector<int> &assume)
                 // If we've restarted too many times consecutively, try a more aggressive restart
                 if (consecutive_restarts > 10)
                 { // Increased from 3
-                    if (debug_output)
+                    SAT_DEBUG(debug_output)
                     {
                         std::cout << "Too many consecutive restarts, clearing learned clauses.\n";
                     }
                     // Clear learned clauses and reset VSIDS scores
+                    backtrack(0);
                     db->clearLearnedClauses();
+                    root_level_units = 0; // Level-0 reasons may have been learned
                     initializeVSIDS();
                     consecutive_restarts = 0;
                 }
@@ -364,7 +516,7 @@ bool CDCLSolverIncremental::solve(const std::vector<int> &assume)
             // If stuck at the same decision level for too long, force backtrack
             if (stuck_at_level_count > 400)
             { // Increased from 100
-                if (debug_output)
+                SAT_DEBUG(debug_output)
                 {
                     std::cout << "Stuck at decision level " << decision_level << " for too long, forcing backtrack.\n";
                 }
@@ -376,80 +528,68 @@ bool CDCLSolverIncremental::solve(const std::vector<int> &assume)
             // If still stuck after multiple restarts, return UNSAT
             if (no_progress_count > 2000)
             { // Increased from 500
-                if (debug_output)
+                SAT_DEBUG(debug_output)
                 {
                     std::cout << "Solver appears to be stuck after " << iterations << " iterations.\n";
                     std::cout << "Last progress: " << no_progress_count << " iterations ago.\n";
                     printStatistics();
                 }
-                return false;
+                interrupted = true;
+                co_return false;
             }
         }
 
         // Check if we should restart
-        if (shouldRestart())
+        bool restart_due = shouldRestart();
+
+        // End of this slice: hand the thread back to the scheduler
+        if (((slice_conflicts > 0 && conflicts - slice_conflict_start >= slice_conflicts) ||
+             (slice_propagations > 0 && propagations - slice_propagation_start >= slice_propagations)) &&
+            (restart_due || !at_restart))
+        {
+            auto suspended_at = std::chrono::high_resolution_clock::now();
+            co_await std::suspend_always{};
+            start_time += std::chrono::high_resolution_clock::now() - suspended_at;
+            slice_conflict_start = conflicts;
+            slice_propagation_start = propagations;
+        }
+
+        if (restart_due)
         {
             restart();
         }
 
         // Perform unit propagation with timeout check
         bool conflict = !unitPropagate();
+        if (interrupted)
+        {
+            co_return false;
+        }
 
         if (conflict)
         {
             conflicts++;
             conflicts_since_restart++;
+            updateTargetPhase();
+
+            // The clause may have become false below the current level
+            int conflict_level = conflictLevel(conflict_clause_id);
+            if (conflict_level < decision_level)
+            {
+                backtrack(conflict_level);
+            }
 
             // Handle conflict at decision level 0
             if (decision_level == 0)
             {
-                if (debug_output)
+                SAT_DEBUG(debug_output)
                 {
                     std::cout << "Conflict at decision level 0. Formula is UNSATISFIABLE.\n";
                 }
 
-                // Extract UNSAT core from the conflict
-                Clause learned_clause;
-                analyzeConflict(conflict_clause_id, learned_clause);
-
                 // Extract the core assumptions
-                core.clear();
-                for (int assumption : assumptions)
-                {
-                    int var = std::abs(assumption);
-
-                    // Check if this variable appears in the learned clause with correct polarity
-                    bool var_in_learned_clause = false;
-                    for (int learned_lit : learned_clause)
-                    {
-                        // Check for exact literal match to respect polarity
-                        if (learned_lit == -assumption)
-                        {
-                            var_in_learned_clause = true;
-                            break;
-                        }
-                    }
-
-                    if (!var_in_learned_clause)
-                    {
-                        continue; // Skip this assumption if not in learned clause
-                    }
-
-                    // Now check if it was assigned as an assumption at level 0
-                    auto trail_it = var_to_trail.find(var);
-                    if (trail_it != var_to_trail.end())
-                    {
-                        const auto &node = trail[trail_it->second];
-
-                        // Include this assumption if it was assigned at level 0
-                        if (node.decision_level == 0 && node.is_decision)
-                        {
-                            core.push_back(assumption);
-                        }
-                    }
-                }
-
-                return false;
+                analyzeFinal(conflict_clause_id);
+                co_return false;
             }
 
             // Analyze conflict and learn a new clause
@@ -459,7 +599,7 @@ bool CDCLSolverIncremental::solve(const std::vector<int> &assume)
             // Check timeout after conflict analysis
             if (checkTimeout())
             {
-                return false;
+                co_return false;
             }
 
             // Minimize the learned clause
@@ -469,11 +609,29 @@ bool CDCLSolverIncremental::solve(const std::vector<int> &assume)
             int lbd = use_lbd ? db->computeLBD(learned_clause, decision_levels) : learned_clause.size();
 
             // Add the learned clause to the database
-            db->addLearnedClause(learned_clause, lbd);
+            ClauseID learned_id = db->addLearnedClause(learned_clause, lbd);
+
+            // Hand short learned clauses to an external listener (IPASIR learn callback)
+            if (learn_callback && learned_clause.size() <= learn_max_length)
+            {
+                learn_callback(learned_clause);
+            }
 
             // Backtrack to the computed level
+            saveTrail(backtrack_level);
             backtrack(backtrack_level);
 
+            // An asserting clause implies its first literal right away; its
+            // false literals were propagated before the clause existed
+            if ((learned_clause.size() == 1 || litValue(learned_clause[1]) < 0) &&
+                litValue(learned_clause[0]) == 0)
+            {
+                assignLiteral(learned_clause[0], learned_id);
+            }
+
+            // Recent learned clauses the new one subsumes are deleted
+            subsumeRecentLearned(learned_id);
+
             // Bump VSIDS scores for variables in the learned clause
             for (int lit : learned_clause)
             {
@@ -491,81 +649,103 @@ bool CDCLSolverIncremental::solve(const std::vector<int> &assume)
             // No conflict, make a new decision
             if (!makeDecision())
             {
-                if (debug_output)
+                SAT_DEBUG(debug_output)
                 {
                     std::cout << "All variables assigned without conflict. Formula is SATISFIABLE.\n";
                 }
-                return true;
+                co_return true;
             }
         }
     }
 
     // If we get here, the formula is satisfied or too complex
-    if (debug_output)
+    SAT_DEBUG(debug_output)
     {
         std::cout << "Reached maximum iterations. Cannot determine satisfiability.\n";
         printStatistics();
     }
 
     // Return UNSAT as a conservative approach
-    return false;
+    interrupted = true;
+    co_return false;
 }
 
 // Add a permanent clause to the formula
 void CDCLSolverIncremental::addClause(const Clause &clause)
 {
-    // Add clause to the database
-    db->addClause(clause);
-
-    // Update VSIDS for the new clause
     for (int lit : clause)
     {
-        int var = std::abs(lit);
-
-        // Initialize activity if this is a new variable
-        if (activity.find(var) == activity.end())
-        {
-            activity[var] = 0.0;
+        add(lit);
+    }
+    add(0);
+}
 
-            // Resize decision levels array if needed
-            if (var >= static_cast<int>(decision_levels.size()))
-            {
-                decision_levels.resize(var + 1, 0);
-            }
-        }
+// Stream one literal of a permanent clause; 0 terminates the clause
+void CDCLSolverIncremental::add(int lit)
+{
+    if (lit != 0)
+    {
+        // Make sure the database knows the variable before watches are set up
+        ensureVariable(std::abs(lit));
+        db->addLiteral(lit);
+        return;
     }
 
-    // Mark that the solver state is no longer valid
-    if (last_solved_until != -1)
+    if (db->pendingClauseEmpty())
     {
-        last_solved_until = -1;
+        has_empty_clause = true;
     }
+
+    // Tautologies and empty clauses are not stored; stored clauses are watched immediately
+    db->commitClause();
 }
 
 // Add a temporary clause valid only for the next solve
 void CDCLSolverIncremental::addTemporaryClause(const Clause &clause)
 {
-    // Add clause to the database as a non-core clause
-    ClauseID id = db->addClause(clause);
-    db->clauses[id]->is_core = false;
+    if (next_solve_group == 0)
+    {
+        next_solve_group = newTemporaryGroup();
+    }
+    addTemporaryClause(next_solve_group, clause);
+}
+
+// Open a new group of temporary clauses, identified by its activation variable
+int CDCLSolverIncremental::newTemporaryGroup()
+{
+    int group = newVariable();
+    temporary_groups.insert(group);
+    return group;
+}
 
-    // Update VSIDS for the new clause
-    for (int lit : clause)
+// Add a clause that holds while the group is live
+void CDCLSolverIncremental::addTemporaryClause(int group, const Clause &clause)
+{
+    if (temporary_groups.count(group) == 0)
     {
-        int var = std::abs(lit);
+        return; // Unknown or already retracted group
+    }
 
-        // Initialize activity if this is a new variable
-        if (activity.find(var) == activity.end())
-        {
-            activity[var] = 0.0;
+    for (int lit : clause)
+    {
+        add(lit);
+    }
+    add(-group);
+    add(0);
+}
 
-            // Resize decision levels array if needed
-            if (var >= static_cast<int>(decision_levels.size()))
-            {
-                decision_levels.resize(var + 1, 0);
-            }
-        }
+// Retract a group: the unit -group satisfies all of its clauses at level 0,
+// so the next solve's root simplification deletes them together with the
+// learned clauses that depended on them
+void CDCLSolverIncremental::retractTemporaryGroup(int group)
+{
+    if (temporary_groups.erase(group) == 0)
+    {
+        return;
     }
+
+    add(-group);
+    add(0);
 }
 
 // Set assumptions for the next solve
@@ -592,17 +772,149 @@ std::vector<int> CDCLSolverIncremental::getUnsatCore() const
     return core;
 }
 
-// Force initial polarity for a variable
-void CDCLSolverIncremental::setDecisionPolarity(int var, bool phase)
+// Force the polarity of a variable; VSIDS activity is left untouched
+// Enumerate models, streaming each one (restricted to the projection) to on_model.
+// Projected variables are decided before all others, so once they are assigned
+// the projected model is implied by the projected decisions alone. Blocking
+// mode excludes that model with the negated decisions, which is usually far
+// shorter than the model itself; the blocking clauses live in a temporary group
+// that is retracted afterwards. Chronological mode adds no clauses: the rest of
+// the space under the current prefix is split into the disjoint cubes
+// d1..d(i-1), -di and each one is searched under assumptions, deepest first.
+// A solve stopped by the timeout or terminate callback ends the enumeration
+// with interrupted still set, which is how callers tell a partial count.
+size_t CDCLSolverIncremental::enumerateModels(const ModelCallback &on_model, const EnumerationOptions &options)
 {
-    if (use_phase_saving)
+    std::vector<int> projection = options.projection;
+    if (projection.empty())
+    {
+        for (int var = 1; var <= getNumVars(); var++)
+        {
+            if (temporary_groups.count(var) == 0)
+            {
+                projection.push_back(var);
+            }
+        }
+    }
+    for (int var : projection)
+    {
+        ensureVariable(var);
+    }
+
+    std::vector<char> in_projection(db->getNumVariables() + 1, 0);
+    for (int var : projection)
+    {
+        in_projection[var] = 1;
+    }
+    priority_vars = projection;
+
+    size_t found = 0;
+    std::vector<int> model;
+    model.reserve(projection.size());
+
+    // Report the current model; false once enumeration should stop
+    auto report = [&]() -> bool
+    {
+        model.clear();
+        for (int var : projection)
+        {
+            model.push_back(litValue(var) >= 0 ? var : -var);
+        }
+        found++;
+        bool go_on = on_model(model);
+        return go_on && (options.max_models == 0 || found < options.max_models);
+    };
+
+    // Projected decisions above the assumption level, in trail order
+    auto projectedDecisions = [&]()
+    {
+        std::vector<int> cube;
+        for (const auto &node : trail)
+        {
+            int var = std::abs(node.literal);
+            if (node.is_decision && node.decision_level > 0 &&
+                var < static_cast<int>(in_projection.size()) && in_projection[var])
+            {
+                cube.push_back(node.literal);
+            }
+        }
+        return cube;
+    };
+
+    if (!options.chronological)
+    {
+        int group = newTemporaryGroup();
+        while (solve(options.assumptions))
+        {
+            bool go_on = report();
+
+            Clause blocking;
+            for (int lit : projectedDecisions())
+            {
+                blocking.push_back(-lit);
+            }
+
+            // No decisions: the assumptions imply the only remaining model
+            if (!go_on || blocking.empty())
+            {
+                break;
+            }
+            addTemporaryClause(group, blocking);
+        }
+        retractTemporaryGroup(group);
+    }
+    else
     {
-        // Store the preferred phase
-        activity[var] = phase ? 1.0 : -1.0;
+        std::vector<std::vector<int>> pending = {options.assumptions};
+        while (!pending.empty())
+        {
+            std::vector<int> prefix = std::move(pending.back());
+            pending.pop_back();
+
+            if (!solve(prefix))
+            {
+                if (interrupted)
+                {
+                    break;
+                }
+                continue;
+            }
+
+            std::vector<int> cube = projectedDecisions();
+            if (!report())
+            {
+                break;
+            }
+
+            // Cube i fixes the first i-1 decisions and flips the i-th; pushing
+            // them in order makes the deepest flip the next one searched
+            for (int lit : cube)
+            {
+                std::vector<int> branch = prefix;
+                branch.push_back(-lit);
+                pending.push_back(std::move(branch));
+                prefix.push_back(lit);
+            }
+        }
     }
+
+    priority_vars.clear();
+    return found;
+}
+
+void CDCLSolverIncremental::setDecisionPolarity(int var, bool phase)
+{
+    ensureVariable(var);
+    forced_phase[var] = phase ? 1 : -1;
 }
 
-// Randomize some polarities for diversification
+// Drop every forced polarity, falling back to target/saved phases
+void CDCLSolverIncremental::clearDecisionPolarities()
+{
+    std::fill(forced_phase.begin(), forced_phase.end(), 0);
+}
+
+// Randomize some saved phases for diversification
 void CDCLSolverIncremental::setRandomizedPolarities(double random_freq)
 {
     if (!use_phase_saving)
@@ -612,16 +924,50 @@ void CDCLSolverIncremental::setRandomizedPolarities(double random_freq)
     std::mt19937 gen(rd());
     std::uniform_real_distribution<> dis(0.0, 1.0);
 
-    for (auto &[var, act] : activity)
+    for (size_t var = 1; var < saved_phase.size(); var++)
     {
         if (dis(gen) < random_freq)
         {
             // Randomize the phase
-            act = (dis(gen) < 0.5) ? 1.0 : -1.0;
+            saved_phase[var] = (dis(gen) < 0.5) ? 1 : -1;
         }
     }
 }
 
+// Preferred polarity of a variable: forced > target > saved, 0 if none is known
+int CDCLSolverIncremental::preferredPhase(int var) const
+{
+    if (forced_phase[var] != 0)
+    {
+        return forced_phase[var];
+    }
+    if (!use_phase_saving)
+    {
+        return 0;
+    }
+    if (target_phase[var] != 0)
+    {
+        return target_phase[var];
+    }
+    return saved_phase[var];
+}
+
+// Take the target phase from the current trail if it is the longest one since the last restart
+void CDCLSolverIncremental::updateTargetPhase()
+{
+    best_trail = std::max(best_trail, trail.size());
+    if (!use_phase_saving || trail.size() <= target_trail_size)
+    {
+        return;
+    }
+
+    for (const auto &node : trail)
+    {
+        target_phase[std::abs(node.literal)] = node.literal > 0 ? 1 : -1;
+    }
+    target_trail_size = trail.size();
+}
+
 // Set maximum number of learned clauses
 void CDCLSolverIncremental::setMaxLearnts(size_t max_learnts)
 {
@@ -634,6 +980,39 @@ void CDCLSolverIncremental::setVarDecay(double decay)
     var_decay = decay;
 }
 
+// Enable lazy hyper-binary resolution; pays off on binary-heavy encodings
+// such as graph coloring and Hamiltonian path formulas
+void CDCLSolverIncremental::setHyperBinaryResolution(bool enable)
+{
+    use_hyper_binary = enable;
+}
+
+// Enable or disable trail saving on backjumps
+void CDCLSolverIncremental::setTrailSaving(bool enable)
+{
+    use_trail_saving = enable;
+    saved_trail.clear();
+}
+
+// Set the wall-clock limit for a single solve call
+void CDCLSolverIncremental::setTimeout(std::chrono::milliseconds timeout)
+{
+    timeout_duration = timeout;
+}
+
+// Install a callback polled during search; returning true stops the solve
+void CDCLSolverIncremental::setTerminateCallback(std::function<bool()> callback)
+{
+    terminate_callback = std::move(callback);
+}
+
+// Install a callback receiving every learned clause of at most max_length literals
+void CDCLSolverIncremental::setLearnCallback(size_t max_length, std::function<void(const Clause &)> callback)
+{
+    learn_max_length = max_length;
+    learn_callback = std::move(callback);
+}
+
 // Configure restart strategy
 void CDCLSolverIncremental::setRestartStrategy(bool use_luby, int init_threshold)
 {
@@ -660,540 +1039,953 @@ int CDCLSolverIncremental::getNumLearnts() const
     return db->getNumLearnedClauses();
 }
 
-// Propagate unit clauses
+// Propagate every trail literal from propagate_head on with two watched
+// literals. Each watch list is compacted in place: entries of deleted clauses
+// are dropped and clauses that find a new watch move to that literal's list.
+// A rebuild of all watch lists in the database sends the head back to 0.
 bool CDCLSolverIncremental::unitPropagate()
 {
-    size_t trail_index = 0;
+    if (watch_epoch != db->getWatchEpoch())
+    {
+        watch_epoch = db->getWatchEpoch();
+        propagate_head = 0;
+    }
 
-    // Process trail until no more propagations
-    while (trail_index < trail.size())
+    while (propagate_head < trail.size())
     {
         // Check for timeout periodically during propagation
-        if (trail_index % 1000 == 0)
-        { // Check every 1000 propagations
+        if (propagate_head % 1000 == 0)
+        {
             if (checkTimeout())
             {
                 return false;
             }
         }
 
-        // Get the assigned literal
-        int lit = trail[trail_index].literal;
-        int neg_lit = -lit;
-
-        // Check all clauses watching the negation of this literal
-        const auto &watch_list = db->getWatches(neg_lit);
+        // Once the next saved literal holds again, the implications saved
+        // after it are restored from their reasons without watch lookups
+        if (saved_head < saved_trail.size() && litValue(saved_trail[saved_head].literal) > 0 &&
+            !replaySavedTrail())
+        {
+            return false;
+        }
 
-        // Create a copy of the watch list that we can modify
-        std::vector<ClauseID> watch_list_copy = watch_list;
+        int false_lit = -trail[propagate_head].literal;
+        auto &watch_list = db->watches[litIndex(false_lit)];
 
-        for (auto it = watch_list_copy.begin(); it != watch_list_copy.end();)
+        bool conflict = false;
+        size_t i = 0;
+        size_t j = 0;
+        while (i < watch_list.size())
         {
-            ClauseID clause_id = *it;
-
-            // Skip if clause has been deleted
+            ClauseID clause_id = watch_list[i++];
             if (clause_id >= db->clauses.size() || !db->clauses[clause_id])
             {
-                ++it;
-                continue;
+                continue; // Deleted clause
             }
+            ClauseInfo &clause = *db->clauses[clause_id];
 
-            const auto &clause = db->clauses[clause_id];
-
-            // Make sure the falsified literal is at index 0
-            if (clause->watched_lits.second == neg_lit)
+            // A unit clause whose only literal is false
+            if (clause.size() == 1)
             {
-                // Swap watched literals
-                std::swap(clause->watched_lits.first, clause->watched_lits.second);
+                watch_list[j++] = clause_id;
+                conflict_clause_id = clause_id;
+                conflict = true;
+                break;
             }
 
-            // Cache the other watched literal
-            int other_lit = clause->watched_lits.second;
+            // Make sure the falsified literal is the first watch
+            if (clause.watched_lits.second == false_lit)
+            {
+                std::swap(clause.watched_lits.first, clause.watched_lits.second);
+            }
+            if (clause.watched_lits.first != false_lit)
+            {
+                continue; // Stale entry, the clause no longer watches this literal
+            }
 
-            // Check if the other watched literal is true
-            int other_var = std::abs(other_lit);
-            auto other_it = assignments.find(other_var);
-            if (other_it != assignments.end() &&
-                ((other_lit > 0 && other_it->second) || (other_lit < 0 && !other_it->second)))
+            // Satisfied by the other watch
+            int other_lit = clause.watched_lits.second;
+            int other_value = litValue(other_lit);
+            if (other_value > 0)
             {
-                // Clause is satisfied, continue
-                ++it;
+                watch_list[j++] = clause_id;
                 continue;
             }
 
             // Try to find a new literal to watch
             bool found_new_watch = false;
-
-            for (size_t i = 0; i < clause->literals.size(); i++)
+            for (int l : clause.literals)
             {
-                int l = clause->literals[i];
-
-                // Skip current watched literals
-                if (l == clause->watched_lits.first || l == clause->watched_lits.second)
+                if (l != false_lit && l != other_lit && litValue(l) >= 0)
                 {
-                    continue;
-                }
-
-                // Check if this literal is unassigned or true
-                int var = std::abs(l);
-                auto var_it = assignments.find(var);
-                if (var_it == assignments.end() ||
-                    (l > 0 && var_it->second) || (l < 0 && !var_it->second))
-                {
-                    // Found a new watch
-                    db->updateWatches(clause_id, neg_lit, l);
-                    clause->watched_lits.first = l;
+                    clause.watched_lits.first = l;
+                    db->watches[litIndex(l)].push_back(clause_id);
                     found_new_watch = true;
                     break;
                 }
             }
-
             if (found_new_watch)
             {
-                // We don't need to remove from watch_list_copy since we're just iterating through it
-                ++it;
                 continue;
             }
 
-            // If we get here, no new watch was found
-
-            // Check if the other watched literal is unassigned
-            if (other_it == assignments.end())
+            watch_list[j++] = clause_id;
+            if (other_value == 0)
             {
-                // Unit clause, propagate it
-                int var = std::abs(other_lit);
-                bool value = (other_lit > 0);
-
-                // Check for direct contradiction with existing assignment
-                auto existing_assignment = assignments.find(var);
-                if (existing_assignment != assignments.end() && existing_assignment->second != value)
+                // Unit clause, propagate it. At level 1 a long clause may be
+                // replaced by a binary shortcut from the dominating literal.
+                ClauseID reason_id = clause_id;
+                if (use_hyper_binary && decision_level == 1 && clause.size() > 2)
                 {
-                    // We have a contradiction! The variable is already assigned the opposite value
-                    if (debug_output)
-                    {
-                        std::cout << "Contradiction detected: x" << var << " would be assigned both "
-                                  << existing_assignment->second << " and " << value << "\n";
-                    }
-
-                    // Find the clause that assigned the variable to its current value
-                    ClauseID conflicting_clause_id = std::numeric_limits<ClauseID>::max();
-                    for (size_t i = 0; i < trail.size(); i++)
-                    {
-                        const auto &node = trail[i];
-                        if (std::abs(node.literal) == var)
-                        {
-                            conflicting_clause_id = node.antecedent_id;
-                            break;
-                        }
-                    }
-
-                    // If we couldn't find the conflicting clause, use the current clause
-                    if (conflicting_clause_id == std::numeric_limits<ClauseID>::max())
-                    {
-                        conflicting_clause_id = clause_id; // Current clause ID
-                    }
-
-                    // Set the conflict clause ID
-                    conflict_clause_id = conflicting_clause_id;
-                    return false;
+                    reason_id = hyperBinaryReason(clause_id, other_lit);
                 }
-
-                // Add to trail
-                trail.emplace_back(other_lit, decision_level, clause_id);
-                var_to_trail[var] = trail.size() - 1;
-
-                // Update assignment
-                assignments[var] = value;
-                decision_levels[var] = decision_level;
-
+                assignLiteral(other_lit, reason_id);
                 propagations++;
 
-                if (debug_output)
+                SAT_TRACE(debug_output)
                 {
-                    std::cout << "Unit propagation: x" << var << " = " << value
+                    std::cout << "Unit propagation: x" << std::abs(other_lit) << " = " << (other_lit > 0)
                               << " at level " << decision_level << "\n";
                 }
-
-                // Keep this clause in the watch list
-                ++it;
             }
             else
             {
-                // Both watched literals are assigned and false, this is a conflict
-                if (debug_output)
+                // Both watched literals are false, this is a conflict
+                SAT_TRACE(debug_output)
                 {
                     std::cout << "Conflict detected in clause: ";
-                    printClause(clause->literals);
+                    printClause(clause.literals);
                     std::cout << "\n";
                 }
 
-                // Store conflicting clause ID for conflict analysis
                 conflict_clause_id = clause_id;
-                return false;
+                conflict = true;
+                break;
             }
         }
 
-        // Move to next literal in the trail
-        trail_index++;
+        // Keep the entries a conflict left unvisited
+        while (i < watch_list.size())
+        {
+            watch_list[j++] = watch_list[i++];
+        }
+        watch_list.resize(j);
+
+        if (conflict)
+        {
+            return false;
+        }
+        propagate_head++;
     }
 
-    // Also check for any unit clauses in the database
-    // This is important for formulas like (x1) AND (NOT x1)
-    for (size_t i = 0; i < db->clauses.size(); i++)
+    return true;
+}
+
+// Assert unit clauses at level 0; false if one contradicts the trail
+bool CDCLSolverIncremental::assertUnitClauses()
+{
+    for (ClauseID id : db->getUnitClauses())
     {
-        if (!db->clauses[i] || db->clauses[i]->literals.empty())
+        if (id >= db->clauses.size() || !db->clauses[id] || db->clauses[id]->size() != 1)
+        {
             continue;
+        }
 
-        const auto &clause = db->clauses[i]->literals;
+        int lit = db->clauses[id]->literals[0];
+        int value = litValue(lit);
+        if (value < 0)
+        {
+            conflict_clause_id = id;
+            return false;
+        }
+        if (value == 0)
+        {
+            assignLiteral(lit, id);
+        }
+    }
+    return true;
+}
 
-        // Count satisfied and unassigned literals
-        int satisfied = 0;
-        int unassigned = 0;
-        int last_unassigned_lit = 0;
+// Put an implied literal on the trail at the current decision level
+void CDCLSolverIncremental::assignLiteral(int lit, size_t antecedent_id)
+{
+    int var = std::abs(lit);
+    bool value = (lit > 0);
 
-        for (int lit : clause)
+    trail.emplace_back(lit, decision_level, antecedent_id);
+    var_to_trail[var] = trail.size() - 1;
+    assignments[var] = value;
+    setVarValue(var, value);
+    decision_levels[var] = decision_level;
+}
+
+// Lazy hyper-binary resolution. A long clause implying lit at level 1 has all
+// other literals false; if they were all derived through binary reasons from
+// one literal d (their dominator in the binary implication tree), the
+// resolvent (-d v lit) is implied by the formula and is learned in place of
+// the long reason. Later propagation from d then reaches lit in one step.
+// Returns the clause to record as reason: the new binary or clause_id.
+ClauseID CDCLSolverIncremental::hyperBinaryReason(ClauseID clause_id, int implied)
+{
+    const size_t max_steps = 64; // Bound on tree walking per clause
+    size_t steps = 0;
+
+    int dominator = 0;
+    for (int lit : db->clauses[clause_id]->literals)
+    {
+        if (lit == implied)
         {
-            int var = std::abs(lit);
-            auto it = assignments.find(var);
+            continue;
+        }
 
-            if (it == assignments.end())
-            {
-                // Unassigned
-                unassigned++;
-                last_unassigned_lit = lit;
-            }
-            else
+        size_t pos = var_to_trail[std::abs(lit)];
+        if (trail[pos].decision_level == 0)
+        {
+            // Root facts hold for good; assumptions only for this call
+            if (pos < root_level_units)
             {
-                // Assigned - check if it satisfies the clause
-                if ((lit > 0 && it->second) || (lit < 0 && !it->second))
-                {
-                    satisfied++;
-                    break;
-                }
+                continue;
             }
+            return clause_id;
         }
 
-        // If clause is satisfied, skip it
-        if (satisfied > 0)
+        // Lowest common ancestor of the true literals, walking up from the
+        // later one until both meet
+        int other = -lit;
+        if (dominator == 0)
         {
+            dominator = other;
             continue;
         }
-
-        // If all literals are assigned and none satisfied, we have a conflict
-        if (unassigned == 0)
+        while (dominator != other)
         {
-            if (debug_output)
+            if (++steps > max_steps)
             {
-                std::cout << "Conflict detected: clause is unsatisfied: ";
-                printClause(clause);
-                std::cout << "\n";
+                return clause_id;
+            }
+            int &later = (var_to_trail[std::abs(dominator)] > var_to_trail[std::abs(other)]) ? dominator : other;
+            later = binaryParent(later);
+            if (later == 0)
+            {
+                return clause_id;
             }
-
-            // Store conflicting clause ID for conflict analysis
-            conflict_clause_id = i;
-            return false;
         }
+    }
+
+    // Skip resolvents that existing binaries already imply (transitive reduction)
+    if (dominator == 0 || impliedByBinaries(dominator, implied))
+    {
+        return clause_id;
+    }
+
+    hyper_binaries++;
+    ClauseID binary_id = db->addHyperBinary(implied, -dominator);
 
-        // If there's exactly one unassigned literal, it's a unit clause
-        if (unassigned == 1)
+    SAT_TRACE(debug_output)
+    {
+        std::cout << "Hyper-binary resolvent: " << -dominator << " " << implied << "\n";
+    }
+
+    return binary_id;
+}
+
+// The true level-1 literal that implied lit through a binary reason, or 0 for
+// the decision and literals with longer reasons
+int CDCLSolverIncremental::binaryParent(int lit) const
+{
+    const auto &node = trail[var_to_trail.at(std::abs(lit))];
+    const Clause *reason = reasonOf(node);
+    if (reason == nullptr || reason->size() != 2)
+    {
+        return 0;
+    }
+
+    int parent = -((*reason)[0] == lit ? (*reason)[1] : (*reason)[0]);
+    return decision_levels[std::abs(parent)] == 1 ? parent : 0;
+}
+
+// Whether binary clauses lead from "from" to "to" directly or through one
+// intermediate literal; partner lists are only scanned while short
+bool CDCLSolverIncremental::impliedByBinaries(int from, int to) const
+{
+    const size_t max_scan = 32;
+    const auto &direct = db->getBinaryPartners(-from);
+    if (direct.size() > max_scan)
+    {
+        return std::find(direct.begin(), direct.end(), to) != direct.end();
+    }
+
+    for (int mid : direct)
+    {
+        if (mid == to)
+        {
+            return true;
+        }
+        const auto &next = db->getBinaryPartners(-mid);
+        if (next.size() <= max_scan && std::find(next.begin(), next.end(), to) != next.end())
         {
-            int var = std::abs(last_unassigned_lit);
-            bool value = (last_unassigned_lit > 0);
+            return true;
+        }
+    }
+    return false;
+}
+
+// Analyze a conflict above level 0 and derive the first-UIP clause. The
+// asserting literal is placed first and a literal of the backtrack level
+// second, so the clause can be watched as is. Root facts are left out, while
+// assumption literals stay in: they only hold for the current call.
+int CDCLSolverIncremental::analyzeConflict(ClauseID conflict_id, Clause &learned_clause)
+{
+    SAT_TRACE(debug_output)
+    {
+        std::cout << "Analyzing conflict in clause: ";
+        printClause(db->clauses[conflict_id]->literals);
+        std::cout << "\n";
+    }
+
+    if (analyze_seen.size() <= db->getNumVariables())
+    {
+        analyze_seen.resize(db->getNumVariables() + 1, 0);
+    }
+    std::vector<int> marked;
+
+    learned_clause.assign(1, 0); // Slot for the asserting literal
+    int pending = 0;             // Marked current-level literals not resolved yet
+    int resolved_var = 0;
+    size_t index = trail.size();
+    const Clause *reason = &db->clauses[conflict_id]->literals;
+    ClauseID reason_id = conflict_id;
+    db->bumpClauseActivity(conflict_id);
 
-            // Check for direct contradiction with existing assignment
-            auto existing_assignment = assignments.find(var);
-            if (existing_assignment != assignments.end() && existing_assignment->second != value)
+    while (true)
+    {
+        if (reason != nullptr)
+        {
+            // Distinct literals besides the pivot and root facts; variables
+            // counted for this reason carry mark 2 until the count is done
+            size_t reason_size = 0;
+            for (int lit : *reason)
             {
-                // We have a contradiction! The variable is already assigned the opposite value
-                if (debug_output)
+                int var = std::abs(lit);
+                if (var == resolved_var || analyze_seen[var] == 2)
+                {
+                    continue;
+                }
+                if (analyze_seen[var])
                 {
-                    std::cout << "Contradiction detected: x" << var << " would be assigned both "
-                              << existing_assignment->second << " and " << value << "\n";
+                    analyze_seen[var] = 2;
+                    reason_size++;
+                    continue;
                 }
 
-                // Find the clause that assigned the variable to its current value
-                ClauseID conflicting_clause_id = std::numeric_limits<ClauseID>::max();
-                for (size_t j = 0; j < trail.size(); j++)
+                auto it = var_to_trail.find(var);
+                if (it == var_to_trail.end() || it->second < root_level_units)
                 {
-                    const auto &node = trail[j];
-                    if (std::abs(node.literal) == var)
-                    {
-                        conflicting_clause_id = node.antecedent_id;
-                        break;
-                    }
+                    continue;
                 }
 
-                // If we couldn't find the conflicting clause, use the current clause
-                if (conflicting_clause_id == std::numeric_limits<ClauseID>::max())
+                reason_size++;
+                analyze_seen[var] = 2;
+                marked.push_back(var);
+                if (trail[it->second].decision_level == decision_level)
+                {
+                    pending++;
+                }
+                else
                 {
-                    conflicting_clause_id = i; // Current clause ID
+                    learned_clause.push_back(lit);
                 }
+            }
 
-                // Set the conflict clause ID
-                conflict_clause_id = conflicting_clause_id;
-                return false;
+            for (int lit : *reason)
+            {
+                if (analyze_seen[std::abs(lit)] == 2)
+                {
+                    analyze_seen[std::abs(lit)] = 1;
+                }
             }
 
-            // Add to trail
-            trail.emplace_back(last_unassigned_lit, decision_level, i);
-            var_to_trail[var] = trail.size() - 1;
+            // The resolvent holds all other literals of the antecedent; if it
+            // holds nothing else, it is the antecedent without the pivot. With
+            // two literals of this level left it stays watchable after backjumping.
+            size_t resolvent_size = pending + learned_clause.size() - 1;
+            if (reason_id != conflict_id && pending >= 2 && resolvent_size == reason_size)
+            {
+                strengthenReason(reason_id, trail[index].literal);
+            }
+        }
 
-            // Update assignment
-            assignments[var] = value;
-            decision_levels[var] = decision_level;
+        // Walk back to the most recent marked literal of this level
+        while (index > 0 && !analyze_seen[std::abs(trail[--index].literal)])
+        {
+        }
 
-            propagations++;
+        const auto &node = trail[index];
+        resolved_var = std::abs(node.literal);
+        if (--pending <= 0)
+        {
+            break;
+        }
 
-            if (debug_output)
+        reason = reasonOf(node);
+        reason_id = node.antecedent_id;
+        if (reason == nullptr)
+        {
+            // The reason was lost to a database reduction: keep the literal
+            learned_clause.push_back(-node.literal);
+        }
+        else
+        {
+            // Clauses used in the resolution gain activity and may improve their LBD
+            db->bumpClauseActivity(node.antecedent_id);
+            if (use_lbd)
             {
-                std::cout << "Unit propagation from clause scan: x" << var << " = " << value
-                          << " at level " << decision_level << "\n";
+                db->updateClauseLBD(node.antecedent_id, decision_levels);
             }
+        }
 
-            // Start over since this new assignment might trigger more propagations
-            return unitPropagate();
+        SAT_TRACE(debug_output)
+        {
+            std::cout << "Resolving on x" << resolved_var << ", " << pending << " literals of this level left\n";
         }
     }
+    learned_clause[0] = -trail[index].literal;
 
-    return true;
+    for (int var : marked)
+    {
+        analyze_seen[var] = 0;
+    }
+
+    // Backtrack to the highest level among the other literals
+    int backtrack_level = 0;
+    for (size_t i = 1; i < learned_clause.size(); i++)
+    {
+        int level = decision_levels[std::abs(learned_clause[i])];
+        if (level > backtrack_level)
+        {
+            backtrack_level = level;
+            std::swap(learned_clause[1], learned_clause[i]);
+        }
+    }
+
+    // Kept literals of this level make the clause non-asserting
+    if (backtrack_level >= decision_level)
+    {
+        backtrack_level = decision_level - 1;
+    }
+
+    SAT_TRACE(debug_output)
+    {
+        std::cout << "Final learned clause: ";
+        printClause(learned_clause);
+        std::cout << "Backtrack level: " << backtrack_level << "\n";
+    }
+
+    return backtrack_level;
 }
 
-// Analyze conflict and learn a new clause
-int CDCLSolverIncremental::analyzeConflict(ClauseID conflict_id, Clause &learned_clause)
+// Collect the assumptions a level-0 conflict depends on into core
+void CDCLSolverIncremental::analyzeFinal(ClauseID conflict_id)
 {
-    if (debug_output)
+    core.clear();
+
+    if (analyze_seen.size() <= db->getNumVariables())
     {
-        std::cout << "Analyzing conflict in clause: ";
-        printClause(db->clauses[conflict_id]->literals);
-        std::cout << "\n";
+        analyze_seen.resize(db->getNumVariables() + 1, 0);
     }
+    std::vector<int> marked;
 
-    // Initialize the learned clause with the conflict clause
-    learned_clause = db->clauses[conflict_id]->literals;
-
-    // Count literals from the current decision level
-    std::unordered_set<int> current_level_vars;
-    for (int lit : learned_clause)
+    auto mark = [&](const Clause &clause, int skip_var)
     {
-        int var = std::abs(lit);
-        auto it = var_to_trail.find(var);
-        if (it != var_to_trail.end())
+        for (int lit : clause)
         {
-            const auto &node = trail[it->second];
-            if (node.decision_level == decision_level)
+            int var = std::abs(lit);
+            auto it = var_to_trail.find(var);
+            if (var != skip_var && !analyze_seen[var] &&
+                it != var_to_trail.end() && it->second >= root_level_units)
             {
-                current_level_vars.insert(var);
+                analyze_seen[var] = 1;
+                marked.push_back(var);
             }
         }
+    };
+
+    mark(db->clauses[conflict_id]->literals, 0);
+
+    bool complete = true;
+    for (size_t i = trail.size(); i-- > root_level_units;)
+    {
+        const auto &node = trail[i];
+        int var = std::abs(node.literal);
+        if (!analyze_seen[var])
+        {
+            continue;
+        }
+
+        if (node.is_decision)
+        {
+            core.push_back(node.literal);
+        }
+        else if (const Clause *reason = reasonOf(node))
+        {
+            mark(*reason, var);
+        }
+        else
+        {
+            complete = false;
+        }
     }
 
-    if (debug_output)
+    for (int var : marked)
     {
-        std::cout << "Current level variables in conflict: " << current_level_vars.size() << "\n";
+        analyze_seen[var] = 0;
     }
 
-    // Find the second highest decision level in the clause
-    int backtrack_level = 0;
+    // Without the full implication graph every assumption may be involved
+    if (!complete)
+    {
+        core = assumptions;
+    }
+}
 
-    // Create a vector of trail indices for variables at the current decision level
-    // for deterministic processing
-    std::vector<size_t> current_level_indices;
-    for (int var : current_level_vars)
+// On-the-fly strengthening: the resolvent proved the antecedent holds without
+// its pivot, so the pivot is removed in place. Literals of the conflict level
+// go first; they are all unassigned after backjumping and take the watches.
+void CDCLSolverIncremental::strengthenReason(ClauseID id, int pivot)
+{
+    Clause literals;
+    for (int lit : db->clauses[id]->literals)
     {
-        auto it = var_to_trail.find(var);
-        if (it != var_to_trail.end())
+        if (lit != pivot)
         {
-            current_level_indices.push_back(it->second);
+            literals.push_back(lit);
         }
     }
+    std::stable_partition(literals.begin(), literals.end(), [&](int lit)
+                          { return decision_levels[std::abs(lit)] == decision_level; });
+
+    db->detachClause(id);
+    db->replaceLiterals(id, literals);
+    db->attachClause(id);
+    strengthened++;
 
-    // Sort indices in reverse order for deterministic processing
-    std::sort(current_level_indices.begin(), current_level_indices.end(),
-              [](size_t a, size_t b)
-              { return a > b; });
+    SAT_TRACE(debug_output)
+    {
+        std::cout << "Strengthened clause " << id << " by removing " << pivot << "\n";
+    }
+}
 
-    // Resolve the conflict by combining with antecedent clauses
-    size_t trail_index_pos = 0;
-    while (current_level_vars.size() > 1 && trail_index_pos < current_level_indices.size())
+// Delete recently learned clauses that the new learned clause subsumes. A
+// clause can only be subsumed if its signature covers the new clause's
+// signature; the literal check runs on those candidates only. Clauses that
+// are reasons on the trail stay.
+void CDCLSolverIncremental::subsumeRecentLearned(ClauseID learned_id)
+{
+    auto signature = [](const Clause &clause)
     {
-        if (trail_index_pos % 100 == 0)
+        uint64_t sig = 0;
+        for (int lit : clause)
         {
-            if (checkTimeout())
-            {
-                return 0;
-            }
+            sig |= uint64_t(1) << (litIndex(lit) & 63);
         }
+        return sig;
+    };
 
-        // Keep one literal from current level for UIP
-        size_t trail_index = current_level_indices[trail_index_pos];
-        const auto &node = trail[trail_index];
-        int var = std::abs(node.literal);
+    const Clause &learned = db->clauses[learned_id]->literals;
+    uint64_t learned_sig = signature(learned);
 
-        // Skip if this variable is not in current_level_vars or is a decision
-        if (current_level_vars.find(var) == current_level_vars.end() ||
-            node.is_decision ||
-            node.antecedent_id == std::numeric_limits<size_t>::max())
+    bool marked = false;
+    for (const auto &[id, sig] : recent_learned)
+    {
+        if ((learned_sig & ~sig) != 0 || !db->clauses[id] || db->clauses[id]->size() <= learned.size())
         {
-            trail_index_pos++;
             continue;
         }
 
-        // Get the antecedent clause
-        const auto &antecedent = db->clauses[node.antecedent_id]->literals;
-
-        if (debug_output)
+        // Mark the new clause's literals once: 1 = positive, 2 = negative
+        if (!marked)
         {
-            std::cout << "Resolving with antecedent of x" << var << ": ";
-            printClause(antecedent);
-            std::cout << "\n";
+            for (int lit : learned)
+            {
+                analyze_seen[std::abs(lit)] = lit > 0 ? 1 : 2;
+            }
+            marked = true;
         }
 
-        // Resolve the learned clause with the antecedent
-        // Remove the current variable from the learned clause
-        learned_clause.erase(
-            std::remove_if(learned_clause.begin(), learned_clause.end(),
-                           [var](int lit)
-                           { return std::abs(lit) == var; }),
-            learned_clause.end());
+        size_t common = 0;
+        for (int lit : db->clauses[id]->literals)
+        {
+            common += analyze_seen[std::abs(lit)] == (lit > 0 ? 1 : 2);
+        }
+        if (common == learned.size() && !isLocked(id))
+        {
+            db->removeClause(id);
+            subsumed++;
+        }
+    }
 
-        // Add literals from the antecedent (except the current variable)
-        for (int lit : antecedent)
+    if (marked)
+    {
+        for (int lit : learned)
         {
-            if (std::abs(lit) != var &&
-                std::find(learned_clause.begin(), learned_clause.end(), lit) == learned_clause.end())
-            {
-                learned_clause.push_back(lit);
+            analyze_seen[std::abs(lit)] = 0;
+        }
+    }
 
-                // Check if this is a variable from the current decision level
-                int lit_var = std::abs(lit);
-                auto it = var_to_trail.find(lit_var);
-                if (it != var_to_trail.end())
-                {
-                    const auto &lit_node = trail[it->second];
-                    if (lit_node.decision_level == decision_level)
-                    {
-                        if (current_level_vars.find(lit_var) == current_level_vars.end())
-                        {
-                            current_level_vars.insert(lit_var);
-                            current_level_indices.push_back(it->second);
-                        }
-                    }
-                    else if (lit_node.decision_level > backtrack_level &&
-                             lit_node.decision_level != decision_level)
-                    {
-                        // Update the second highest decision level
-                        backtrack_level = lit_node.decision_level;
-                    }
-                }
-            }
+    recent_learned.emplace_back(learned_id, learned_sig);
+    if (recent_learned.size() > RECENT_LEARNED)
+    {
+        recent_learned.pop_front();
+    }
+}
+
+// Whether a clause is the antecedent of one of its assigned literals
+bool CDCLSolverIncremental::isLocked(ClauseID id) const
+{
+    for (int lit : db->clauses[id]->literals)
+    {
+        auto it = var_to_trail.find(std::abs(lit));
+        if (it != var_to_trail.end() && !trail[it->second].is_decision && trail[it->second].antecedent_id == id)
+        {
+            return true;
         }
+    }
+    return false;
+}
 
-        // Remove the variable from the current level set
-        current_level_vars.erase(var);
+// Reason clause of a trail node, nullptr for decisions, assumptions and
+// reasons deleted by a database reduction
+const Clause *CDCLSolverIncremental::reasonOf(const ImplicationNodeIncremental &node) const
+{
+    if (node.is_decision || node.antecedent_id >= db->clauses.size() || !db->clauses[node.antecedent_id])
+    {
+        return nullptr;
+    }
+    return &db->clauses[node.antecedent_id]->literals;
+}
+
+// Level of the most recent literal of a conflicting clause
+int CDCLSolverIncremental::conflictLevel(ClauseID conflict_id) const
+{
+    int level = 0;
+    for (int lit : db->clauses[conflict_id]->literals)
+    {
+        level = std::max(level, decision_levels[std::abs(lit)]);
+    }
+    return level;
+}
+
+// Backtrack to a specific decision level
+void CDCLSolverIncremental::backtrack(int level)
+{
+    SAT_TRACE(debug_output)
+    {
+        std::cout << "Backtracking from level " << decision_level << " to level " << level << "\n";
+    }
 
-        // Resort the indices after adding new variables
-        std::sort(current_level_indices.begin(), current_level_indices.end(),
-                  [](size_t a, size_t b)
-                  { return a > b; });
+    // Remove assignments made after the backtrack level
+    while (!trail.empty())
+    {
+        const auto &node = trail.back();
+        if (node.decision_level <= level)
+        {
+            break;
+        }
 
-        if (debug_output)
+        // Remove the variable from assignments, remembering its phase
+        int var = std::abs(node.literal);
+        if (use_phase_saving)
         {
-            std::cout << "After resolution, learned clause: ";
-            printClause(learned_clause);
-            std::cout << "Current level variables remaining: " << current_level_vars.size() << "\n";
+            saved_phase[var] = node.literal > 0 ? 1 : -1;
         }
+        assignments.erase(var);
+        clearVarValue(var);
+        var_to_trail.erase(var);
+        decision_levels[var] = 0;
+
+        // Remove from trail
+        trail.pop_back();
+    }
+
+    // Update the decision level
+    decision_level = level;
+    propagate_head = std::min(propagate_head, trail.size());
 
-        // Move to the next position
-        trail_index_pos = 0; // Restart with the sorted indices
+    // Restarts and root-level work start over without a saved trail
+    if (level == 0)
+    {
+        saved_trail.clear();
+    }
+
+    SAT_TRACE(debug_output)
+    {
+        std::cout << "After backtracking, trail size: " << trail.size() << "\n";
+        printTrail();
+    }
+}
+
+// Trail saving: keep the segment a backjump to level is about to undo, so
+// the implications can be restored instead of rediscovered
+void CDCLSolverIncremental::saveTrail(int level)
+{
+    saved_trail.clear();
+    saved_head = 0;
+    if (!use_trail_saving || level == 0)
+    {
+        return;
     }
 
-    // Remove duplicates from the learned clause
-    std::sort(learned_clause.begin(), learned_clause.end());
-    learned_clause.erase(std::unique(learned_clause.begin(), learned_clause.end()), learned_clause.end());
+    size_t start = trail.size();
+    while (start > 0 && trail[start - 1].decision_level > level)
+    {
+        start--;
+    }
+    saved_trail.assign(trail.begin() + start, trail.end());
+}
 
-    // Preserve all literals from assumptions
-    for (int assumption : assumptions)
+// Walk the saved trail from saved_head. True entries are skipped; an implied
+// entry whose saved reason is still unit under the current trail is assigned
+// with that reason, and one whose reason is already false is a conflict. The
+// walk pauses at the first entry that is not implied yet and the saved trail
+// is dropped once it contradicts the current trail.
+bool CDCLSolverIncremental::replaySavedTrail()
+{
+    while (saved_head < saved_trail.size())
     {
-        int var = std::abs(assumption);
-        bool has_var = false;
-        for (int lit : learned_clause)
+        const auto &node = saved_trail[saved_head];
+        int value = litValue(node.literal);
+        if (value > 0)
+        {
+            saved_head++;
+            continue;
+        }
+        if (node.is_decision)
         {
-            if (std::abs(lit) == var)
+            // A saved decision is not implied; replay resumes once it is made again
+            if (value < 0)
             {
-                has_var = true;
-                break;
+                saved_trail.clear();
             }
+            return true;
         }
 
-        // If the assumption variable is not in the learned clause,
-        // check if it was involved in the conflict path
-        if (!has_var)
+        // The saved reason must still exist, contain the literal and have all
+        // of its other literals false
+        const Clause *reason = reasonOf(node);
+        bool unit = reason != nullptr;
+        bool contains = false;
+        for (size_t i = 0; unit && i < reason->size(); i++)
         {
-            auto it = var_to_trail.find(var);
-            if (it != var_to_trail.end() && decision_levels[var] == 0)
+            int lit = (*reason)[i];
+            if (lit == node.literal)
+            {
+                contains = true;
+            }
+            else if (litValue(lit) >= 0)
             {
-                // Add this assumption to ensure it's captured for UNSAT core
-                learned_clause.push_back(assumption);
+                unit = false;
             }
         }
+        unit = unit && contains;
+
+        if (value < 0)
+        {
+            if (unit)
+            {
+                conflict_clause_id = node.antecedent_id;
+                saved_trail.clear();
+                return false;
+            }
+            saved_trail.clear();
+            return true;
+        }
+        if (!unit)
+        {
+            return true;
+        }
+
+        assignLiteral(node.literal, node.antecedent_id);
+        propagations++;
+        replayed++;
+        saved_head++;
+    }
+
+    saved_trail.clear();
+    return true;
+}
+
+// Propagate at level 0 without assumptions and simplify with the result.
+// Returns false if the formula itself is unsatisfiable (or the search was
+// interrupted).
+bool CDCLSolverIncremental::propagateRootLevel()
+{
+    if (!assertUnitClauses() || !unitPropagate())
+    {
+        return false;
+    }
+    simplifyRootLevel();
+    return true;
+}
+
+// When the propagated, assumption-free level 0 fixes literals that were not
+// fixed at the previous simplification, record them as unit facts and let
+// the database drop satisfied clauses and false literals
+void CDCLSolverIncremental::simplifyRootLevel()
+{
+    if (trail.size() <= root_level_units)
+    {
+        return;
+    }
+
+    // The reason clauses of root literals are about to be removed as satisfied,
+    // so give every implied root literal its own unit clause as antecedent.
+    // Learned units are copied too: clauses removed on their account must not
+    // come back unconstrained once learned clauses are cleared.
+    for (auto &node : trail)
+    {
+        const auto &reason = node.antecedent_id < db->clauses.size() ? db->clauses[node.antecedent_id] : nullptr;
+        if (!reason || reason->size() > 1 || reason->is_learned)
+        {
+            node.antecedent_id = db->addClause({node.literal});
+        }
+    }
+
+    size_t removed = db->simplify(assignments);
+    root_level_units = trail.size();
+
+    SAT_DEBUG(debug_output)
+    {
+        std::cout << "Root-level simplification: " << root_level_units << " fixed literals, "
+                  << removed << " clauses removed\n";
+    }
+}
+
+// Units learned during the search are root facts too. At a restart that finds
+// new ones, the assumptions are lifted as for vivification, the facts are
+// propagated on their own and the database is simplified with them; then the
+// assumptions go back for the search to propagate.
+void CDCLSolverIncremental::simplifyAtRestart()
+{
+    if (decision_level != 0 || propagate_head != trail.size())
+    {
+        return;
+    }
+
+    size_t start = assumptionStart();
+    bool new_facts = start > root_level_units;
+    for (size_t i = start; i < trail.size() && !new_facts; i++)
+    {
+        const Clause *reason = reasonOf(trail[i]);
+        new_facts = reason && reason->size() == 1;
+    }
+    if (!new_facts)
+    {
+        return;
+    }
+
+    std::vector<ImplicationNodeIncremental> lifted = liftAssumptions();
+    size_t head = trail.size();
+    for (const auto &node : lifted)
+    {
+        const Clause *reason = reasonOf(node);
+        if (reason && reason->size() == 1 && litValue(node.literal) == 0)
+        {
+            assignLiteral(node.literal, node.antecedent_id);
+        }
+    }
+
+    // Facts that refute the formula or an assumption are left to the search,
+    // which runs into the conflict again and reports it as usual
+    bool consistent = unitPropagate();
+    for (const auto &node : lifted)
+    {
+        consistent &= !node.is_decision || litValue(node.literal) >= 0;
+    }
+    if (consistent)
+    {
+        simplifyRootLevel();
+    }
+    else
+    {
+        truncateLevelZero(head);
     }
+    restoreAssumptions(lifted);
+}
 
-    if (debug_output)
+// Assumptions follow the root facts on the level-0 trail as decisions
+size_t CDCLSolverIncremental::assumptionStart() const
+{
+    size_t start = root_level_units;
+    while (start < trail.size() && !trail[start].is_decision)
     {
-        std::cout << "Final learned clause: ";
-        printClause(learned_clause);
-        std::cout << "Backtrack level: " << backtrack_level << "\n";
+        start++;
     }
+    return start;
+}
 
-    return backtrack_level;
+// Undo level 0 from the first assumption on, leaving the formula's own root
+// facts. Returns the removed entries for restoreAssumptions.
+std::vector<ImplicationNodeIncremental> CDCLSolverIncremental::liftAssumptions()
+{
+    size_t start = assumptionStart();
+    std::vector<ImplicationNodeIncremental> lifted(trail.begin() + start, trail.end());
+    truncateLevelZero(start);
+    return lifted;
 }
 
-// Backtrack to a specific decision level
-void CDCLSolverIncremental::backtrack(int level)
+// Unassign the level-0 trail from index start on
+void CDCLSolverIncremental::truncateLevelZero(size_t start)
 {
-    if (debug_output)
+    while (trail.size() > start)
     {
-        std::cout << "Backtracking from level " << decision_level << " to level " << level << "\n";
+        int var = std::abs(trail.back().literal);
+        assignments.erase(var);
+        clearVarValue(var);
+        var_to_trail.erase(var);
+        trail.pop_back();
     }
+    propagate_head = std::min(propagate_head, trail.size());
+}
 
-    // Remove assignments made after the backtrack level
-    while (!trail.empty())
+// Re-assign the lifted unit facts, then the assumptions; the search
+// propagates them again and reports a conflict as usual
+void CDCLSolverIncremental::restoreAssumptions(const std::vector<ImplicationNodeIncremental> &lifted)
+{
+    for (const auto &node : lifted)
     {
-        const auto &node = trail.back();
-        if (node.decision_level <= level)
+        const Clause *reason = reasonOf(node);
+        if (reason && reason->size() == 1 && litValue(node.literal) == 0)
         {
-            break;
+            assignLiteral(node.literal, node.antecedent_id);
         }
-
-        // Remove the variable from assignments
-        int var = std::abs(node.literal);
-        assignments.erase(var);
-        var_to_trail.erase(var);
-        decision_levels[var] = 0;
-
-        // Remove from trail
-        trail.pop_back();
     }
-
-    // Update the decision level
-    decision_level = level;
-
-    if (debug_output)
+    for (const auto &node : lifted)
     {
-        std::cout << "After backtracking, trail size: " << trail.size() << "\n";
-        printTrail();
+        if (node.is_decision && litValue(node.literal) == 0)
+        {
+            trail.emplace_back(node.literal, 0, std::numeric_limits<size_t>::max(), true);
+            int var = std::abs(node.literal);
+            var_to_trail[var] = trail.size() - 1;
+            assignments[var] = node.literal > 0;
+            setVarValue(var, node.literal > 0);
+        }
     }
 }
 
 // Make a new decision
 bool CDCLSolverIncremental::makeDecision()
 {
-    // Use VSIDS to select the next variable
-    int var = selectVarVSIDS();
+    // Projected variables first during enumeration, VSIDS otherwise
+    int var = selectPriorityVar();
+    if (var == 0)
+    {
+        var = selectVarVSIDS();
+    }
 
     if (var == 0)
     {
-        if (debug_output)
+        SAT_TRACE(debug_output)
         {
             std::cout << "No unassigned variables left for decisions.\n";
         }
@@ -1216,34 +2008,21 @@ bool CDCLSolverIncremental::makeDecision()
     static std::mt19937 gen(rd());
     static std::uniform_real_distribution<> dis(0.0, 1.0);
 
-    // 1. Count positive and negative occurrences for balanced selection
-    int pos_count = 0, neg_count = 0;
-    for (size_t i = 0; i < db->clauses.size(); i++)
-    {
-        if (!db->clauses[i])
-            continue;
-        for (int lit : db->clauses[i]->literals)
-        {
-            if (std::abs(lit) == var)
-            {
-                if (lit > 0)
-                    pos_count++;
-                else
-                    neg_count++;
-            }
-        }
-    }
+    // 1. Positive and negative occurrences for balanced selection
+    size_t pos_count = db->getOccurrences(var);
+    size_t neg_count = db->getOccurrences(-var);
 
-    // 2. Calculate activity-based bias
-    double activity_bias = 0.0;
-    auto it = activity.find(var);
-    if (it != activity.end())
-    {
-        activity_bias = it->second;
-    }
+    // 2. Phase hint from the forced/target/saved phase stores
+    int preferred = preferredPhase(var);
+    double phase_bias = preferred;
 
     // 3. Phase transition-aware decision making
-    if (ratio >= 4.0 && ratio <= 4.5)
+    if (forced_phase[var] != 0)
+    {
+        // User-forced polarity is always honored
+        value = forced_phase[var] > 0;
+    }
+    else if (ratio >= 4.0 && ratio <= 4.5)
     {
         // In phase transition region
         // Calculate randomization probability based on distance from critical ratio and solver progress
@@ -1253,16 +2032,15 @@ bool CDCLSolverIncremental::makeDecision()
 
         if (dis(gen) < rand_prob)
         {
-            // Random decision with slight bias towards activity
-            value = (dis(gen) < 0.5 + (activity_bias * 0.1));
+            // Random decision with slight bias towards the stored phase
+            value = (dis(gen) < 0.5 + (phase_bias * 0.1));
         }
         else
         {
-            // Activity-based decision with occurrence count influence
-            if (std::abs(activity_bias) > 0.1)
+            // Stored phase first, occurrence counts otherwise
+            if (preferred != 0)
             {
-                // Strong activity bias
-                value = (activity_bias > 0);
+                value = (preferred > 0);
             }
             else
             {
@@ -1277,13 +2055,13 @@ bool CDCLSolverIncremental::makeDecision()
         double progress_factor = (stuck_counter > 0) ? 0.15 : 0.0;
         if (dis(gen) < 0.4 + progress_factor)
         {
-            // 40-55% chance for random decision with activity bias
-            value = (dis(gen) < 0.5 + (activity_bias * 0.15));
+            // 40-55% chance for random decision with phase bias
+            value = (dis(gen) < 0.5 + (phase_bias * 0.15));
         }
         else
         {
-            // Activity-based with occurrence count influence
-            value = (activity_bias > 0) == (pos_count >= neg_count);
+            // Stored phase with occurrence count fallback
+            value = (preferred != 0) ? (preferred > 0) : (pos_count >= neg_count);
         }
     }
     else
@@ -1292,14 +2070,14 @@ bool CDCLSolverIncremental::makeDecision()
         if (stuck_counter > 0)
         {
             // When stuck, use more randomization
-            value = (dis(gen) < 0.5 + (activity_bias * 0.05));
+            value = (dis(gen) < 0.5 + (phase_bias * 0.05));
         }
         else
         {
             // Normal deterministic selection
-            if (std::abs(activity_bias) > 0.1)
+            if (preferred != 0)
             {
-                value = (activity_bias > 0);
+                value = (preferred > 0);
             }
             else
             {
@@ -1315,13 +2093,14 @@ bool CDCLSolverIncremental::makeDecision()
 
     // Update assignment
     assignments[var] = value;
+    setVarValue(var, value);
     decision_levels[var] = decision_level;
 
-    if (debug_output)
+    SAT_TRACE(debug_output)
     {
         std::cout << "Decision: x" << var << " = " << value
                   << " at level " << decision_level
-                  << " (ratio: " << ratio << ", activity: " << activity_bias
+                  << " (ratio: " << ratio << ", phase: " << preferred
                   << ", pos/neg: " << pos_count << "/" << neg_count << ")\n";
     }
 
@@ -1378,7 +2157,7 @@ void CDCLSolverIncremental::initializeVSIDS()
         }
     }
 
-    if (debug_output)
+    SAT_TRACE(debug_output)
     {
         std::cout << "Initialized VSIDS activities:\n";
         for (const auto &[var, score] : activity)
@@ -1445,7 +2224,7 @@ int CDCLSolverIncremental::selectVarVSIDS()
             std::uniform_int_distribution<> var_dis(0, unassigned.size() - 1);
             best_var = unassigned[var_dis(gen)];
 
-            if (debug_output)
+            SAT_TRACE(debug_output)
             {
                 std::cout << "Randomly selected var " << best_var << " (ratio: " << ratio
                           << ", random_prob: " << random_prob << ")\n";
@@ -1485,7 +2264,7 @@ int CDCLSolverIncremental::selectVarVSIDS()
         }
     }
 
-    if (debug_output && best_var != 0)
+    SAT_TRACE(debug_output && best_var != 0)
     {
         std::cout << "VSIDS selected var " << best_var << " with score "
                   << (activity.find(best_var) != activity.end() ? activity[best_var] : 0.0)
@@ -1495,6 +2274,31 @@ int CDCLSolverIncremental::selectVarVSIDS()
     return best_var;
 }
 
+// Most active unassigned variable among the priority (projected) variables
+int CDCLSolverIncremental::selectPriorityVar() const
+{
+    int best_var = 0;
+    double best_score = -1.0;
+
+    for (int var : priority_vars)
+    {
+        if (litValue(var) != 0)
+        {
+            continue;
+        }
+
+        auto it = activity.find(var);
+        double score = (it != activity.end()) ? std::abs(it->second) : 0.0;
+        if (score > best_score)
+        {
+            best_score = score;
+            best_var = var;
+        }
+    }
+
+    return best_var;
+}
+
 // Bump variable activity
 void CDCLSolverIncremental::bumpVarActivity(int var)
 {
@@ -1518,201 +2322,112 @@ void CDCLSolverIncremental::decayVarActivities()
     var_inc /= var_decay;
 }
 
-// Minimize learned clause using self-subsumption
+// Remove literals implied by the rest of the clause (recursive minimization).
+// A literal is redundant when every literal of its reason is in the clause, a
+// root fact, or redundant itself. The asserting literal is always kept.
 void CDCLSolverIncremental::minimizeClause(Clause &clause)
 {
-    // Skip minimization for very large clauses
-    if (clause.size() > 100)
+    if (clause.size() <= 1)
     {
         return;
     }
 
-    // Set a local timer for this specific operation
-    auto minimize_start = std::chrono::high_resolution_clock::now();
-    const auto max_minimize_time = std::chrono::milliseconds(100); // 100ms max
-
-    // Add timeout check at the start
-    if (checkTimeout())
+    if (analyze_seen.size() <= db->getNumVariables())
     {
-        return; // Skip minimization if timeout or solution found
+        analyze_seen.resize(db->getNumVariables() + 1, 0);
     }
-
-    if (clause.size() <= 1)
-        return;
-
-    std::unordered_set<int> seen;
-    std::vector<int> minimized;
-
-    // Counter for periodic timeout checks
-    int timeout_check_counter = 0;
-
-    // Mark all literals in the clause
+    std::vector<int> marked;
     for (int lit : clause)
     {
-        seen.insert(lit);
+        analyze_seen[std::abs(lit)] = 1;
+        marked.push_back(std::abs(lit));
     }
 
-    // Try to remove each literal
-    for (int lit : clause)
+    size_t kept = 1;
+    for (size_t i = 1; i < clause.size(); i++)
     {
-        // Check timeout periodically
-        if ((timeout_check_counter++ % 50) == 0)
-        {
-            // Check local timeout
-            auto current_time = std::chrono::high_resolution_clock::now();
-            auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(
-                current_time - minimize_start);
-            if (elapsed > max_minimize_time || checkTimeout())
-            {
-                // If timeout detected, just return the original clause
-                return;
-            }
-        }
-
-        int var = std::abs(lit);
-
-        // Never remove literals at decision level 0
-        auto it = var_to_trail.find(var);
-        if (it != var_to_trail.end() && decision_levels[var] == 0)
-        {
-            minimized.push_back(lit);
-            continue;
-        }
-
-        // Never remove literals that correspond to assumptions
-        bool is_assumption = false;
-        for (int assumption : assumptions)
-        {
-            if (lit == assumption)
-            { // Check exact literal match, not just variable
-                is_assumption = true;
-                break;
-            }
-        }
-
-        if (is_assumption)
+        if (!isRedundant(clause[i], marked))
         {
-            minimized.push_back(lit);
-            continue;
+            clause[kept++] = clause[i];
         }
+    }
 
-        // Check if this literal is redundant
-        if (!isRedundant(lit, seen, timeout_check_counter, minimize_start, max_minimize_time))
-        {
-            minimized.push_back(lit);
-        }
+    for (int var : marked)
+    {
+        analyze_seen[var] = 0;
     }
 
-    // Update the clause if we removed any literals
-    if (minimized.size() < clause.size())
+    if (kept < clause.size())
     {
-        if (debug_output)
+        SAT_TRACE(debug_output)
         {
-            std::cout << "Minimized clause from " << clause.size() << " to " << minimized.size() << " literals\n";
+            std::cout << "Minimized clause from " << clause.size() << " to " << kept << " literals\n";
         }
-        clause = minimized;
+        clause.resize(kept);
     }
 
-    // Clear the seen set to prevent tracking issues between different calls
-    seen.clear();
-}
+    // Literals implied through binary clauses on the asserting literal
+    minimizer->minimizeWithBinaries(clause);
 
-// Check if a literal is redundant in the learned clause
-// Modified isRedundant to include timeout checks
-bool CDCLSolverIncremental::isRedundant(int lit, std::unordered_set<int> &seen, int &timeout_check_counter,
-                                        const std::chrono::time_point<std::chrono::high_resolution_clock> &start_time,
-                                        const std::chrono::milliseconds &max_time)
-{
-    // Check timeout periodically
-    if ((timeout_check_counter++ % 50) == 0)
+    // Keep a literal of the highest remaining level in the second watch
+    for (size_t i = 2; i < clause.size(); i++)
     {
-        // Check local timeout
-        auto current_time = std::chrono::high_resolution_clock::now();
-        auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(
-            current_time - start_time);
-        if (elapsed > max_time || checkTimeout())
+        if (decision_levels[std::abs(clause[i])] > decision_levels[std::abs(clause[1])])
         {
-            return false; // Conservative approach: if timeout, don't consider redundant
+            std::swap(clause[1], clause[i]);
         }
     }
+}
 
-    int var = std::abs(lit);
-    auto it = var_to_trail.find(var);
-    if (it == var_to_trail.end())
-        return false;
-
-    const auto &node = trail[it->second];
-
-    // Decision variables or assumptions are never redundant
-    if (node.is_decision || node.antecedent_id == std::numeric_limits<size_t>::max())
+// Check whether a clause literal follows from the other marked literals. Marks
+// made while proving redundancy stay set (in marked) so later checks reuse
+// them; a failed check undoes its own marks.
+bool CDCLSolverIncremental::isRedundant(int lit, std::vector<int> &marked)
+{
+    auto start = var_to_trail.find(std::abs(lit));
+    if (start == var_to_trail.end() || reasonOf(trail[start->second]) == nullptr)
     {
         return false;
     }
 
-    // Literals from assumptions should never be considered redundant
-    for (int assumption : assumptions)
-    {
-        if (lit == assumption)
-        { // Exact literal match to preserve polarity
-            return false;
-        }
-    }
-
-    // Check if the reason clause allows us to remove this literal
-    if (node.antecedent_id >= db->clauses.size() || !db->clauses[node.antecedent_id])
+    size_t top = marked.size();
+    std::vector<size_t> stack = {start->second};
+    while (!stack.empty())
     {
-        return false; // The antecedent clause has been deleted
-    }
-
-    const auto &reason = db->clauses[node.antecedent_id]->literals;
+        const auto &node = trail[stack.back()];
+        stack.pop_back();
+        int var = std::abs(node.literal);
 
-    // Check each literal in the reason clause
-    for (int reason_lit : reason)
-    {
-        // Periodic timeout check
-        if ((timeout_check_counter++ % 50) == 0)
+        for (int other : *reasonOf(node))
         {
-            // Check local timeout
-            auto current_time = std::chrono::high_resolution_clock::now();
-            auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(
-                current_time - start_time);
-            if (elapsed > max_time || checkTimeout())
+            int other_var = std::abs(other);
+            if (other_var == var || analyze_seen[other_var])
             {
-                return false; // Conservative approach
+                continue;
             }
-        }
-
-        if (std::abs(reason_lit) == var)
-            continue; // Skip the literal itself
-
-        // Calculate the negated reason literal (for seen check)
-        int neg_reason_lit = -reason_lit;
-
-        // If the negation is not in seen, this literal is not redundant
-        if (seen.find(neg_reason_lit) == seen.end())
-        {
-            int reason_var = std::abs(reason_lit);
-            auto reason_it = var_to_trail.find(reason_var);
 
-            // If the reason variable is not in the trail or is from a deeper level,
-            // this literal is not redundant
-            if (reason_it == var_to_trail.end() ||
-                decision_levels[reason_var] > decision_levels[var])
+            auto it = var_to_trail.find(other_var);
+            if (it != var_to_trail.end() && it->second < root_level_units)
             {
-                return false;
+                continue;
             }
 
-            // Check if this reason literal is derived from an assumption
-            // If it is, we should not consider the current literal redundant
-            const auto &reason_node = trail[reason_it->second];
-            if (reason_node.decision_level == 0)
+            if (it == var_to_trail.end() || reasonOf(trail[it->second]) == nullptr)
             {
+                for (size_t i = top; i < marked.size(); i++)
+                {
+                    analyze_seen[marked[i]] = 0;
+                }
+                marked.resize(top);
                 return false;
             }
+
+            analyze_seen[other_var] = 1;
+            marked.push_back(other_var);
+            stack.push_back(it->second);
         }
     }
 
-    // If we got here, the literal is redundant
     return true;
 }
 
@@ -1734,7 +2449,7 @@ bool CDCLSolverIncremental::shouldRestart()
 // Perform a restart
 void CDCLSolverIncremental::restart()
 {
-    if (debug_output)
+    SAT_DEBUG(debug_output)
     {
         std::cout << "Restarting after " << conflicts_since_restart << " conflicts\n";
     }
@@ -1742,6 +2457,29 @@ void CDCLSolverIncremental::restart()
     // Backtrack to decision level 0 (keep assumptions)
     backtrack(0);
 
+    // Memory pressure: lower the limit, shed and compact while only level-0
+    // literals are on the trail
+    size_t max_learnts = requested_max_learnts.exchange(0);
+    if (max_learnts > 0)
+    {
+        setMaxLearnts(max_learnts);
+        std::unordered_map<int, bool> no_assignments; // Satisfied clauses may be reasons
+        db->reduceLearnedClauses(no_assignments);
+    }
+    if (compaction_requested.exchange(false))
+    {
+        compactClauseDatabase();
+    }
+
+    // Simplify with the units learned since the last simplification
+    simplifyAtRestart();
+
+    // Strengthen the clauses learned since the last restart
+    minimizer->vivifyLearnedClauses(50);
+
+    // Start collecting a new target phase
+    target_trail_size = 0;
+
     // Update restart parameters
     if (use_luby_restarts)
     {
@@ -1754,30 +2492,68 @@ void CDCLSolverIncremental::restart()
 
     conflicts_since_restart = 0;
     restarts++;
+
+    if (!checkpoint_path.empty())
+    {
+        checkpointInBackground();
+    }
 }
 
-// Compute the Luby sequence
-int CDCLSolverIncremental::lubySequence(int i)
+// Reasons of the level-0 trail are marked used so the reduction keeps them,
+// then every stored clause ID follows the compaction
+void CDCLSolverIncremental::compactClauseDatabase()
 {
-    // Compute the largest power of 2 that divides i
-    int power = 0;
-    int temp = i;
-    while (temp % 2 == 0)
+    for (const auto &node : trail)
     {
-        temp /= 2;
-        power++;
+        if (node.antecedent_id < db->clauses.size() && db->clauses[node.antecedent_id])
+        {
+            db->clauses[node.antecedent_id]->used = true;
+        }
     }
+    std::unordered_map<int, bool> no_assignments; // Satisfied clauses may be reasons
+    db->reduceLearnedClauses(no_assignments);
 
-    // Check if i is one less than a power of 2
-    if (temp == 1)
+    std::vector<ClauseID> remap = db->compact();
+    for (auto &node : trail)
+    {
+        if (node.antecedent_id < remap.size())
+        {
+            node.antecedent_id = remap[node.antecedent_id];
+        }
+    }
+    if (conflict_clause_id < remap.size())
     {
-        return 1 << power;
+        conflict_clause_id = remap[conflict_clause_id];
     }
-    else
+    saved_trail.clear();
+    saved_head = 0;
+    recent_learned.clear();
+    minimizer->remapClauses(remap);
+    compactions++;
+}
+
+// Compute the Luby sequence 1, 1, 2, 1, 1, 2, 4, 1, 1, 2, ... (1-based index)
+int CDCLSolverIncremental::lubySequence(int i)
+{
+    // Find the smallest complete subsequence (size 2^k - 1) containing index i
+    int x = std::max(i, 1) - 1;
+    int size = 1;
+    int seq = 0;
+    while (size < x + 1)
     {
-        // Recursively compute luby(i - 2^k + 1)
-        return lubySequence(i - (1 << power) + 1);
+        seq++;
+        size = 2 * size + 1;
     }
+
+    // Descend into the half that holds x until x is the last element
+    while (size - 1 != x)
+    {
+        size = (size - 1) >> 1;
+        seq--;
+        x = x % size;
+    }
+
+    return 1 << seq;
 }
 
 // Print the current trail
@@ -1858,6 +2634,20 @@ void CDCLSolverIncremental::printStatistics() const
     std::cout << "  Propagations: " << propagations << "\n";
     std::cout << "  Restarts: " << restarts << "\n";
     std::cout << "  Max Decision Level: " << max_decision_level << "\n";
+    if (use_hyper_binary)
+    {
+        std::cout << "  Hyper-binary Resolvents: " << hyper_binaries << "\n";
+    }
+    std::cout << "  Strengthened Antecedents: " << strengthened << "\n";
+    std::cout << "  Subsumed Learned Clauses: " << subsumed << "\n";
+    if (use_trail_saving)
+    {
+        std::cout << "  Replayed Implications: " << replayed << "\n";
+    }
+    if (compactions > 0)
+    {
+        std::cout << "  Database Compactions: " << compactions << "\n";
+    }
 
     // Print clause database statistics
     db->printStatistics();
@@ -1870,11 +2660,13 @@ bool CDCLSolverIncremental::checkTimeout()
     auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(
         current_time - start_time);
 
-    // Check both timeout and solution found status from portfolio
+    // Check timeout, portfolio termination and external termination
     if (elapsed > timeout_duration ||
-        (portfolio_manager != nullptr && portfolio_manager->isSolutionFound()))
+        (portfolio_manager != nullptr && portfolio_manager->shouldTerminate()) ||
+        (terminate_callback && terminate_callback()))
     {
-        if (debug_output)
+        interrupted = true;
+        SAT_DEBUG(debug_output)
         {
             std::cout << "Timeout reached or solution already found. Stopping search.\n";
         }
@@ -1885,7 +2677,8 @@ bool CDCLSolverIncremental::checkTimeout()
 
 int CDCLSolverIncremental::newVariable()
 {
-    int new_var = db->getNumVariables();
+    // Update the number of variables in the database
+    int new_var = db->addVariable();
 
     // Initialize activity for the new variable
     activity[new_var] = 0.0;
@@ -1895,9 +2688,228 @@ int CDCLSolverIncremental::newVariable()
     {
         decision_levels.resize(new_var + 1, 0);
     }
-
-    // Update the number of variables in the database
-    db->addVariable();
+    lit_values.resize(2 * (new_var + 1), 0);
+    forced_phase.resize(new_var + 1, 0);
+    target_phase.resize(new_var + 1, 0);
+    saved_phase.resize(new_var + 1, 0);
 
     return new_var;
-}
\ No newline at end of file
+}
+
+// Create variables up to and including var
+void CDCLSolverIncremental::ensureVariable(int var)
+{
+    while (static_cast<int>(db->getNumVariables()) < var)
+    {
+        newVariable();
+    }
+}
+// Write the current state to path; call between solves
+bool CDCLSolverIncremental::saveCheckpoint(const std::string &path) const
+{
+    return writeCheckpoint(path, takeCheckpoint());
+}
+
+// Replace the formula and search state with a saved checkpoint
+bool CDCLSolverIncremental::loadCheckpoint(const std::string &path)
+{
+    SolverCheckpoint checkpoint;
+    if (!readCheckpoint(path, checkpoint))
+    {
+        return false;
+    }
+    restoreCheckpoint(checkpoint);
+    return true;
+}
+
+void CDCLSolverIncremental::setCheckpointing(const std::string &path, std::chrono::milliseconds interval)
+{
+    checkpoint_path = path;
+    checkpoint_interval = interval;
+    last_checkpoint = std::chrono::steady_clock::now();
+}
+
+// Snapshot of what a resumed search needs. Clause IDs are not kept: outside a
+// search, and at restarts, only level-0 literals are assigned, and the reasons
+// of root facts are their unit clauses.
+SolverCheckpoint CDCLSolverIncremental::takeCheckpoint() const
+{
+    SolverCheckpoint checkpoint;
+    size_t num_vars = db->getNumVariables();
+    checkpoint.num_vars = static_cast<uint32_t>(num_vars);
+    checkpoint.has_empty_clause = has_empty_clause;
+    checkpoint.restart_threshold = restart_threshold;
+    checkpoint.luby_index = luby_index;
+    checkpoint.var_inc = var_inc;
+    checkpoint.clause_activity_inc = db->clause_activity_inc;
+    checkpoint.conflicts = conflicts;
+    checkpoint.decisions = decisions;
+    checkpoint.propagations = propagations;
+    checkpoint.restarts = restarts;
+
+    checkpoint.clauses.reserve(db->clauses.size());
+    for (const auto &clause : db->clauses)
+    {
+        if (!clause)
+        {
+            continue;
+        }
+        uint32_t flags = (clause->is_learned ? CHECKPOINT_LEARNED : 0) | (clause->used ? CHECKPOINT_USED : 0);
+        checkpoint.clauses.push_back({static_cast<uint32_t>(clause->size()), clause->lbd, clause->activity, flags});
+        checkpoint.literals.insert(checkpoint.literals.end(), clause->literals.begin(), clause->literals.end());
+    }
+
+    checkpoint.activity.assign(num_vars + 1, 0.0);
+    for (const auto &[var, score] : activity)
+    {
+        if (var > 0 && static_cast<size_t>(var) <= num_vars)
+        {
+            checkpoint.activity[var] = score;
+        }
+    }
+    checkpoint.saved_phase.assign(saved_phase.begin(), saved_phase.end());
+    checkpoint.target_phase.assign(target_phase.begin(), target_phase.end());
+    checkpoint.forced_phase.assign(forced_phase.begin(), forced_phase.end());
+    checkpoint.saved_phase.resize(num_vars + 1, 0);
+    checkpoint.target_phase.resize(num_vars + 1, 0);
+    checkpoint.forced_phase.resize(num_vars + 1, 0);
+
+    // Root facts, not literals implied by assumptions
+    for (const auto &node : trail)
+    {
+        if (node.decision_level != 0)
+        {
+            break;
+        }
+        const auto &reason = node.antecedent_id < db->clauses.size() ? db->clauses[node.antecedent_id] : nullptr;
+        if (!node.is_decision && reason && reason->size() == 1)
+        {
+            checkpoint.root_trail.push_back(node.literal);
+        }
+    }
+
+    // The one-shot group of the current call is dropped with the call
+    for (int group : temporary_groups)
+    {
+        if (group != next_solve_group)
+        {
+            checkpoint.temporary_groups.push_back(group);
+        }
+    }
+    return checkpoint;
+}
+
+// Bulk load the saved clauses and build every watch list in one pass, then
+// restore the per-variable state. Settings (decay, restart strategy, learned
+// clause limit, callbacks) stay as configured on this solver.
+void CDCLSolverIncremental::restoreCheckpoint(const SolverCheckpoint &checkpoint)
+{
+    size_t num_vars = checkpoint.num_vars;
+    size_t max_learnts = db->max_learnt_clauses;
+
+    db = std::make_unique<ClauseDatabase>(num_vars, debug_output);
+    db->is_locked = [this](ClauseID id)
+    { return isLocked(id); };
+    db->max_learnt_clauses = max_learnts;
+    db->clause_activity_inc = checkpoint.clause_activity_inc;
+    db->reserve(checkpoint.clauses.size() + checkpoint.root_trail.size());
+
+    std::unordered_set<int> units;
+    auto next_literal = checkpoint.literals.begin();
+    for (const auto &record : checkpoint.clauses)
+    {
+        Clause literals(next_literal, next_literal + record.size);
+        next_literal += record.size;
+        if (literals.size() == 1)
+        {
+            units.insert(literals[0]);
+        }
+
+        if (record.flags & CHECKPOINT_LEARNED)
+        {
+            ClauseID id = db->appendLearnedClause(literals, record.lbd, record.activity);
+            db->clauses[id]->used = (record.flags & CHECKPOINT_USED) != 0;
+        }
+        else
+        {
+            db->appendClause(literals);
+        }
+    }
+
+    // Every solve rebuilds its trail from the unit clauses, so root facts come back as units
+    for (int lit : checkpoint.root_trail)
+    {
+        if (units.insert(lit).second)
+        {
+            db->appendClause({lit});
+        }
+    }
+    db->initWatches();
+    minimizer = std::make_unique<ClauseMinimizer>(*db, debug_output, this);
+
+    decision_levels.assign(num_vars + 1, 0);
+    lit_values.assign(2 * (num_vars + 1), 0);
+    saved_phase.assign(checkpoint.saved_phase.begin(), checkpoint.saved_phase.end());
+    target_phase.assign(checkpoint.target_phase.begin(), checkpoint.target_phase.end());
+    forced_phase.assign(checkpoint.forced_phase.begin(), checkpoint.forced_phase.end());
+    activity.clear();
+    for (size_t var = 1; var <= num_vars; var++)
+    {
+        activity[var] = checkpoint.activity[var];
+    }
+    var_inc = checkpoint.var_inc;
+
+    restart_threshold = checkpoint.restart_threshold;
+    luby_index = checkpoint.luby_index;
+    conflicts = static_cast<int>(checkpoint.conflicts);
+    decisions = static_cast<int>(checkpoint.decisions);
+    propagations = static_cast<int>(checkpoint.propagations);
+    restarts = static_cast<int>(checkpoint.restarts);
+    has_empty_clause = checkpoint.has_empty_clause;
+    temporary_groups = std::unordered_set<int>(checkpoint.temporary_groups.begin(), checkpoint.temporary_groups.end());
+    next_solve_group = 0;
+
+    // Nothing of the previous search carries over
+    trail.clear();
+    var_to_trail.clear();
+    assignments.clear();
+    saved_trail.clear();
+    saved_head = 0;
+    recent_learned.clear();
+    analyze_seen.clear();
+    assumptions.clear();
+    core.clear();
+    propagate_head = 0;
+    watch_epoch = db->getWatchEpoch();
+    decision_level = 0;
+    conflicts_since_restart = 0;
+    target_trail_size = 0;
+    root_level_units = 0;
+    last_solved_until = 0; // Watches are already built
+    interrupted = false;
+}
+
+// Periodic checkpoint at a restart. Copying the state is the only work done on
+// the search thread; the writer thread encodes, writes and syncs the file.
+void CDCLSolverIncremental::checkpointInBackground()
+{
+    auto now = std::chrono::steady_clock::now();
+    if (now - last_checkpoint < checkpoint_interval || checkpoint_busy)
+    {
+        return;
+    }
+
+    if (checkpoint_writer.joinable())
+    {
+        checkpoint_writer.join(); // Already finished: checkpoint_busy is clear
+    }
+    last_checkpoint = now;
+    checkpoint_busy = true;
+    checkpoint_writer = std::thread([this, path = checkpoint_path, snapshot = takeCheckpoint()]()
+                                    {
+        if (writeCheckpoint(path, snapshot))
+        {
+            checkpoints_written++;
+        }
+        checkpoint_busy = false; });
+}
@@ -3,11 +3,10 @@
 #include <algorithm>
 #include <cassert>
 #include <limits>
-#include <unordered_set>
 
 // ClauseInfo implementation
 ClauseInfo::ClauseInfo(const Clause &lits, bool learned, bool core)
-    : literals(lits), is_learned(learned), is_core(core), activity(0), lbd(0)
+    : literals(lits), activity(0), lbd(0), is_learned(learned), is_core(core), used(false)
 {
     // Initialize watched literals to first two if possible
     if (literals.size() >= 2)
@@ -24,10 +23,29 @@ ClauseInfo::ClauseInfo(const Clause &lits, bool learned, bool core)
     }
 }
 
+ClauseInfo::ClauseInfo(Clause &&lits, bool learned, bool core)
+    : literals(std::move(lits)), activity(0), lbd(0), is_learned(learned), is_core(core), used(false)
+{
+    if (literals.size() >= 2)
+    {
+        watched_lits = {literals[0], literals[1]};
+    }
+    else if (literals.size() == 1)
+    {
+        watched_lits = {literals[0], 0};
+    }
+    else
+    {
+        watched_lits = {0, 0};
+    }
+}
+
 // ClauseDatabase implementation
 ClauseDatabase::ClauseDatabase(size_t num_vars, bool debug)
-    : clause_activity_inc(1),
+    : watch_epoch(0),
+      clause_activity_inc(1),
       clause_decay_factor(0.999),
+      lbd_stamp(0),
       num_variables(num_vars),
       original_clauses(0),
       total_learned(0),
@@ -37,17 +55,16 @@ ClauseDatabase::ClauseDatabase(size_t num_vars, bool debug)
       clause_deletion_threshold(2.5),   // Lowered from 3.0 to be more aggressive
       allow_clause_deletion(true),
       debug_output(debug),
-      current_memory_usage(0)
+      current_memory_usage(0),
+      pending_tautology(false)
 {
 
-    // Initialize watches array with pre-allocated space
-    watches.resize(2 * num_vars + 1);
-    for (auto &watch_list : watches)
-    {
-        watch_list.reserve(num_vars); // Pre-allocate space
-    }
+    // Watch lists are sized when clauses arrive (initWatches sizes them exactly)
+    watches.resize(2 * (num_vars + 1));
+    occurrences.resize(2 * (num_vars + 1), 0);
+    binary_partners.resize(2 * (num_vars + 1));
 
-    if (debug_output)
+    SAT_INFO(debug_output)
     {
         std::cout << "ClauseDatabase initialized with " << num_vars << " variables\n";
         std::cout << "Max learned clauses: " << max_learnt_clauses << "\n";
@@ -58,7 +75,57 @@ ClauseDatabase::ClauseDatabase(size_t num_vars, bool debug)
 ClauseID ClauseDatabase::addClause(const Clause &clause, bool is_learned)
 {
     // Create a new clause with the given literals
-    auto clause_ref = std::make_shared<ClauseInfo>(clause, is_learned, !is_learned);
+    return storeClause(std::make_shared<ClauseInfo>(clause, is_learned, !is_learned));
+}
+
+// Append one literal to the clause under construction
+void ClauseDatabase::addLiteral(int lit)
+{
+    size_t var = std::abs(lit);
+    if (var >= pending_marks.size())
+    {
+        pending_marks.resize(std::max(var + 1, 2 * pending_marks.size()), 0);
+    }
+
+    signed char sign = lit > 0 ? 1 : -1;
+    signed char mark = pending_marks[var];
+    if (mark == sign)
+    {
+        return; // Duplicate literal
+    }
+    if (mark == -sign)
+    {
+        pending_tautology = true; // Clause contains x and -x
+        return;
+    }
+
+    pending_marks[var] = sign;
+    pending_clause.push_back(lit);
+}
+
+// Finish the clause under construction and move it into the database
+ClauseID ClauseDatabase::commitClause()
+{
+    for (int lit : pending_clause)
+    {
+        pending_marks[std::abs(lit)] = 0;
+    }
+
+    ClauseID id = NO_CLAUSE;
+    if (!pending_tautology && !pending_clause.empty())
+    {
+        id = storeClause(std::make_shared<ClauseInfo>(std::move(pending_clause)));
+    }
+
+    pending_clause.clear();
+    pending_tautology = false;
+    return id;
+}
+
+ClauseID ClauseDatabase::storeClause(ClauseRef clause_ref)
+{
+    const Clause &clause = clause_ref->literals;
+    bool is_learned = clause_ref->is_learned;
     ClauseID id = clauses.size();
 
     // Add to the clause vector
@@ -75,6 +142,13 @@ ClauseID ClauseDatabase::addClause(const Clause &clause, bool is_learned)
     {
         original_clauses++;
     }
+    current_memory_usage += clauseMemory(*clause_ref);
+    updateOccurrences(clause, true);
+    addBinaryPartners(clause);
+    if (clause.size() == 1)
+    {
+        unit_clauses.push_back(id);
+    }
 
     // Set up watches if clause has at least 2 literals
     if (clause.size() >= 2)
@@ -82,8 +156,8 @@ ClauseID ClauseDatabase::addClause(const Clause &clause, bool is_learned)
         int lit1 = clause[0];
         int lit2 = clause[1];
 
-        size_t watch_idx1 = lit1 > 0 ? lit1 : num_variables + std::abs(lit1);
-        size_t watch_idx2 = lit2 > 0 ? lit2 : num_variables + std::abs(lit2);
+        size_t watch_idx1 = litIndex(lit1);
+        size_t watch_idx2 = litIndex(lit2);
 
         watches[watch_idx1].push_back(id);
         watches[watch_idx2].push_back(id);
@@ -92,11 +166,11 @@ ClauseID ClauseDatabase::addClause(const Clause &clause, bool is_learned)
     {
         // Unit clause - watch the only literal
         int lit = clause[0];
-        size_t watch_idx = lit > 0 ? lit : num_variables + std::abs(lit);
+        size_t watch_idx = litIndex(lit);
         watches[watch_idx].push_back(id);
     }
 
-    if (debug_output)
+    SAT_TRACE(debug_output)
     {
         std::cout << "Added " << (is_learned ? "learned" : "original") << " clause: ";
         for (int lit : clause)
@@ -114,6 +188,7 @@ ClauseID ClauseDatabase::addLearnedClause(const Clause &clause, int lbd)
     // Create a new clause with the given literals
     auto clause_ref = std::make_shared<ClauseInfo>(clause, true, false);
     clause_ref->lbd = lbd;
+    clause_ref->activity = static_cast<float>(clause_activity_inc);
 
     ClauseID id = clauses.size();
 
@@ -124,6 +199,13 @@ ClauseID ClauseDatabase::addLearnedClause(const Clause &clause, int lbd)
     // Update statistics
     total_learned++;
     active_learned++;
+    current_memory_usage += clauseMemory(*clause_ref);
+    updateOccurrences(clause, true);
+    addBinaryPartners(clause);
+    if (clause.size() == 1)
+    {
+        unit_clauses.push_back(id);
+    }
 
     // Set up watches if clause has at least 2 literals
     if (clause.size() >= 2)
@@ -131,8 +213,8 @@ ClauseID ClauseDatabase::addLearnedClause(const Clause &clause, int lbd)
         int lit1 = clause[0];
         int lit2 = clause[1];
 
-        size_t watch_idx1 = lit1 > 0 ? lit1 : num_variables + std::abs(lit1);
-        size_t watch_idx2 = lit2 > 0 ? lit2 : num_variables + std::abs(lit2);
+        size_t watch_idx1 = litIndex(lit1);
+        size_t watch_idx2 = litIndex(lit2);
 
         watches[watch_idx1].push_back(id);
         watches[watch_idx2].push_back(id);
@@ -144,7 +226,7 @@ ClauseID ClauseDatabase::addLearnedClause(const Clause &clause, int lbd)
     {
         // Unit clause - watch the only literal
         int lit = clause[0];
-        size_t watch_idx = lit > 0 ? lit : num_variables + std::abs(lit);
+        size_t watch_idx = litIndex(lit);
         watches[watch_idx].push_back(id);
 
         // Store watched literal
@@ -162,7 +244,7 @@ ClauseID ClauseDatabase::addLearnedClause(const Clause &clause, int lbd)
         reduceLearnedClauses(empty_assignments);
     }
 
-    if (debug_output)
+    SAT_TRACE(debug_output)
     {
         std::cout << "Added learned clause with LBD " << lbd << ": ";
         for (int lit : clause)
@@ -176,6 +258,15 @@ ClauseID ClauseDatabase::addLearnedClause(const Clause &clause, int lbd)
     return id;
 }
 
+// Learned binary derived while propagating. It never triggers a reduction,
+// since watch lists are being walked, and binaries are never reduced anyway.
+ClauseID ClauseDatabase::addHyperBinary(int implied, int other)
+{
+    auto clause_ref = std::make_shared<ClauseInfo>(Clause{implied, other}, true, false);
+    clause_ref->lbd = 2;
+    return storeClause(clause_ref);
+}
+
 void ClauseDatabase::removeClause(ClauseID id)
 {
     if (id >= clauses.size() || !clauses[id])
@@ -192,8 +283,8 @@ void ClauseDatabase::removeClause(ClauseID id)
         int lit1 = clause->watched_lits.first;
         int lit2 = clause->watched_lits.second;
 
-        size_t watch_idx1 = lit1 > 0 ? lit1 : num_variables + std::abs(lit1);
-        size_t watch_idx2 = lit2 > 0 ? lit2 : num_variables + std::abs(lit2);
+        size_t watch_idx1 = litIndex(lit1);
+        size_t watch_idx2 = litIndex(lit2);
 
         auto &watch_list1 = watches[watch_idx1];
         auto &watch_list2 = watches[watch_idx2];
@@ -204,7 +295,7 @@ void ClauseDatabase::removeClause(ClauseID id)
     else if (clause->size() == 1)
     {
         int lit = clause->literals[0];
-        size_t watch_idx = lit > 0 ? lit : num_variables + std::abs(lit);
+        size_t watch_idx = litIndex(lit);
 
         auto &watch_list = watches[watch_idx];
         watch_list.erase(std::remove(watch_list.begin(), watch_list.end(), id), watch_list.end());
@@ -216,24 +307,140 @@ void ClauseDatabase::removeClause(ClauseID id)
         active_learned--;
         deleted_learned++;
     }
+    current_memory_usage -= std::min(current_memory_usage, clauseMemory(*clause));
+    updateOccurrences(clause->literals, false);
 
     // Mark the clause as deleted by setting its pointer to nullptr
     // We don't actually remove it from the vector to keep IDs stable
     clauses[id] = nullptr;
 
-    if (debug_output)
+    SAT_TRACE(debug_output)
     {
         std::cout << "Removed clause with ID: " << id << "\n";
     }
 }
 
+// Reserve storage for a formula of known size before bulk loading it
+void ClauseDatabase::reserve(size_t num_clauses)
+{
+    clauses.reserve(clauses.size() + num_clauses);
+}
+
+// Append an original clause without watches or memory checks. Call
+// initWatches() once after the last appended clause. Like commitClause,
+// duplicate literals are dropped and tautologies return NO_CLAUSE.
+ClauseID ClauseDatabase::appendClause(const Clause &clause)
+{
+    Clause literals;
+    literals.reserve(clause.size());
+    bool tautology = false;
+    for (int lit : clause)
+    {
+        size_t var = std::abs(lit);
+        if (var >= append_marks.size())
+        {
+            append_marks.resize(std::max(var + 1, 2 * append_marks.size()), 0);
+        }
+
+        signed char sign = lit > 0 ? 1 : -1;
+        if (append_marks[var] == -sign)
+        {
+            tautology = true;
+            break;
+        }
+        if (append_marks[var] == 0)
+        {
+            append_marks[var] = sign;
+            literals.push_back(lit);
+        }
+    }
+    for (int lit : literals)
+    {
+        append_marks[std::abs(lit)] = 0;
+    }
+    if (tautology || literals.empty())
+    {
+        return NO_CLAUSE;
+    }
+
+    ClauseID id = clauses.size();
+    updateOccurrences(literals, true);
+    clauses.push_back(std::make_shared<ClauseInfo>(std::move(literals), false, true));
+    original_clauses++;
+    return id;
+}
+
+// Learned counterpart of appendClause, used when restoring a checkpoint
+ClauseID ClauseDatabase::appendLearnedClause(const Clause &clause, int lbd, float activity)
+{
+    ClauseID id = clauses.size();
+    auto clause_ref = std::make_shared<ClauseInfo>(clause, true, false);
+    clause_ref->lbd = lbd;
+    clause_ref->activity = activity;
+    clauses.push_back(clause_ref);
+    learned_clauses.push_back(std::move(clause_ref));
+    total_learned++;
+    active_learned++;
+    updateOccurrences(clause, true);
+    return id;
+}
+
+// Keep the per-literal occurrence counters in step with added/removed literals
+void ClauseDatabase::updateOccurrences(const Clause &lits, bool add)
+{
+    for (int lit : lits)
+    {
+        if (add)
+        {
+            occurrences[litIndex(lit)]++;
+        }
+        else
+        {
+            occurrences[litIndex(lit)]--;
+        }
+    }
+}
+
+void ClauseDatabase::addBinaryPartners(const Clause &lits)
+{
+    if (lits.size() == 2)
+    {
+        binary_partners[litIndex(lits[0])].push_back(lits[1]);
+        binary_partners[litIndex(lits[1])].push_back(lits[0]);
+    }
+}
+
+size_t ClauseDatabase::getOccurrences(int lit) const
+{
+    return occurrences[litIndex(lit)];
+}
+
 void ClauseDatabase::initWatches()
 {
-    // Clear existing watches
-    for (auto &watch_list : watches)
+    // Count the watches per literal first so every list is allocated exactly once
+    std::vector<size_t> counts(watches.size(), 0);
+    for (const auto &clause : clauses)
     {
-        watch_list.clear();
+        if (!clause || clause->empty())
+            continue;
+
+        int lit1 = clause->literals[0];
+        counts[litIndex(lit1)]++;
+        if (clause->size() >= 2)
+        {
+            int lit2 = clause->literals[1];
+            counts[litIndex(lit2)]++;
+        }
+    }
+
+    for (size_t i = 0; i < watches.size(); i++)
+    {
+        watches[i].clear();
+        watches[i].reserve(counts[i]);
+        binary_partners[i].clear();
     }
+    unit_clauses.clear();
+    watch_epoch++;
 
     // Set up watches for all clauses
     for (size_t id = 0; id < clauses.size(); id++)
@@ -248,28 +455,33 @@ void ClauseDatabase::initWatches()
             int lit1 = clause->literals[0];
             int lit2 = clause->literals[1];
 
-            size_t watch_idx1 = lit1 > 0 ? lit1 : num_variables + std::abs(lit1);
-            size_t watch_idx2 = lit2 > 0 ? lit2 : num_variables + std::abs(lit2);
+            size_t watch_idx1 = litIndex(lit1);
+            size_t watch_idx2 = litIndex(lit2);
 
             watches[watch_idx1].push_back(id);
             watches[watch_idx2].push_back(id);
 
             // Store watched literals
             clause->watched_lits = {lit1, lit2};
+            addBinaryPartners(clause->literals);
         }
         else if (clause->size() == 1)
         {
             int lit = clause->literals[0];
-            size_t watch_idx = lit > 0 ? lit : num_variables + std::abs(lit);
+            size_t watch_idx = litIndex(lit);
 
             watches[watch_idx].push_back(id);
+            unit_clauses.push_back(id);
 
             // Store watched literal
             clause->watched_lits = {lit, 0};
         }
     }
 
-    if (debug_output)
+    // Resynchronize the running memory estimate while we have walked everything
+    current_memory_usage = calculateMemoryUsage();
+
+    SAT_TRACE(debug_output)
     {
         std::cout << "Watched literals initialized\n";
         printWatches();
@@ -285,12 +497,12 @@ void ClauseDatabase::updateWatches(ClauseID id, int old_lit, int new_lit)
     }
 
     // Remove the old watch
-    size_t old_watch_idx = old_lit > 0 ? old_lit : num_variables + std::abs(old_lit);
+    size_t old_watch_idx = litIndex(old_lit);
     auto &old_watch_list = watches[old_watch_idx];
     old_watch_list.erase(std::remove(old_watch_list.begin(), old_watch_list.end(), id), old_watch_list.end());
 
     // Add the new watch
-    size_t new_watch_idx = new_lit > 0 ? new_lit : num_variables + std::abs(new_lit);
+    size_t new_watch_idx = litIndex(new_lit);
     watches[new_watch_idx].push_back(id);
 
     // Update the watched literals in the clause
@@ -305,16 +517,82 @@ void ClauseDatabase::updateWatches(ClauseID id, int old_lit, int new_lit)
     }
     else
     {
-        if (debug_output)
+        SAT_TRACE(debug_output)
         {
             std::cout << "Warning: Updating watch for literal that is not watched\n";
         }
     }
 }
 
+// Remove a clause from the watch lists of its two watched literals
+void ClauseDatabase::detachClause(ClauseID id)
+{
+    if (id >= clauses.size() || !clauses[id])
+    {
+        return;
+    }
+
+    const auto &clause = clauses[id];
+    for (int lit : {clause->watched_lits.first, clause->watched_lits.second})
+    {
+        if (lit == 0)
+        {
+            continue;
+        }
+        auto &watch_list = watches[litIndex(lit)];
+        watch_list.erase(std::remove(watch_list.begin(), watch_list.end(), id), watch_list.end());
+    }
+}
+
+// Swap in a strengthened literal set for a detached clause
+void ClauseDatabase::replaceLiterals(ClauseID id, const Clause &literals)
+{
+    if (id >= clauses.size() || !clauses[id])
+    {
+        return;
+    }
+
+    auto &clause = clauses[id];
+    current_memory_usage -= std::min(current_memory_usage, clauseMemory(*clause));
+    updateOccurrences(clause->literals, false);
+
+    clause->literals = literals;
+    clause->lbd = std::min(clause->lbd, static_cast<int>(literals.size()));
+
+    current_memory_usage += clauseMemory(*clause);
+    updateOccurrences(clause->literals, true);
+}
+
+// Watch the first two literals of a detached clause (or register a unit)
+void ClauseDatabase::attachClause(ClauseID id)
+{
+    if (id >= clauses.size() || !clauses[id] || clauses[id]->empty())
+    {
+        return;
+    }
+
+    auto &clause = clauses[id];
+    if (clause->size() >= 2)
+    {
+        int lit1 = clause->literals[0];
+        int lit2 = clause->literals[1];
+        watches[litIndex(lit1)].push_back(id);
+        watches[litIndex(lit2)].push_back(id);
+        clause->watched_lits = {lit1, lit2};
+        addBinaryPartners(clause->literals);
+    }
+    else
+    {
+        int lit = clause->literals[0];
+        watches[litIndex(lit)].push_back(id);
+        clause->watched_lits = {lit, 0};
+        unit_clauses.push_back(id);
+    }
+}
+
 const std::vector<ClauseID> &ClauseDatabase::getWatches(int literal) const
 {
-    size_t watch_idx = literal > 0 ? literal : num_variables + std::abs(literal);
+    size_t watch_idx = litIndex(literal);
     return watches[watch_idx];
 }
 
@@ -329,28 +607,51 @@ void ClauseDatabase::bumpClauseActivity(ClauseID id)
     if (!clause->is_learned)
         return; // Only bump learned clauses
 
-    clause->activity += clause_activity_inc;
+    clause->activity += static_cast<float>(clause_activity_inc);
 
     // Check for activity overflow
-    if (clause->activity > 1e20)
+    if (clause->activity > 1e20f)
     {
         // Rescale all activities
-        for (auto &c : clauses)
+        for (auto &c : learned_clauses)
         {
-            if (c && c->is_learned)
-            {
-                c->activity *= 1e-20;
-            }
+            c->activity *= 1e-20f;
         }
         clause_activity_inc *= 1e-20;
     }
 }
 
+// Growing the increment instead of shrinking every activity decays all
+// clauses exponentially at constant cost per conflict
 void ClauseDatabase::decayClauseActivities()
 {
     clause_activity_inc /= clause_decay_factor;
 }
 
+// Learned clauses get their LBD recomputed under the current levels whenever
+// they are used as a reason; an improved clause is protected from the next
+// reduction.
+void ClauseDatabase::updateClauseLBD(ClauseID id, const std::vector<int> &levels)
+{
+    if (id >= clauses.size() || !clauses[id])
+    {
+        return;
+    }
+
+    auto &clause = clauses[id];
+    if (!clause->is_learned || clause->lbd <= 2)
+    {
+        return;
+    }
+
+    int lbd = computeLBD(clause->literals, levels);
+    if (lbd > 0 && lbd < clause->lbd)
+    {
+        clause->lbd = lbd;
+        clause->used = true;
+    }
+}
+
 void ClauseDatabase::garbageCollect(const std::unordered_map<int, bool> &assignments)
 {
     // Count satisfied clauses
@@ -388,12 +689,92 @@ void ClauseDatabase::garbageCollect(const std::unordered_map<int, bool> &assignm
         }
     }
 
-    if (debug_output)
+    SAT_DEBUG(debug_output)
     {
         std::cout << "Garbage collection removed " << satisfied << " satisfied learned clauses\n";
     }
 }
 
+// Simplify under literals fixed at decision level 0: remove every satisfied
+// clause except the unit facts themselves, strip false literals from the rest
+// and rebuild the watch lists. Returns the number of removed clauses.
+size_t ClauseDatabase::simplify(const std::unordered_map<int, bool> &root_assignments)
+{
+    auto value_of = [&](int lit) -> int
+    {
+        auto it = root_assignments.find(std::abs(lit));
+        if (it == root_assignments.end())
+            return 0;
+        return (it->second == (lit > 0)) ? 1 : -1;
+    };
+
+    size_t removed = 0;
+    for (auto &clause : clauses)
+    {
+        if (!clause || clause->size() <= 1)
+            continue;
+
+        bool satisfied = false;
+        bool has_false = false;
+        for (int lit : clause->literals)
+        {
+            int value = value_of(lit);
+            if (value > 0)
+            {
+                satisfied = true;
+                break;
+            }
+            has_false |= (value < 0);
+        }
+
+        if (satisfied)
+        {
+            if (clause->is_learned)
+            {
+                active_learned--;
+                deleted_learned++;
+            }
+            current_memory_usage -= std::min(current_memory_usage, clauseMemory(*clause));
+            updateOccurrences(clause->literals, false);
+            clause = nullptr;
+            removed++;
+        }
+        else if (has_false)
+        {
+            // Root propagation is complete, so at least two literals remain unassigned
+            auto &lits = clause->literals;
+            auto first_false = std::stable_partition(lits.begin(), lits.end(),
+                                                     [&](int lit)
+                                                     { return value_of(lit) >= 0; });
+            for (auto it = first_false; it != lits.end(); ++it)
+            {
+                occurrences[litIndex(*it)]--;
+            }
+            lits.erase(first_false, lits.end());
+        }
+    }
+
+    // Drop removed clauses from the learned clause list as well
+    learned_clauses.erase(std::remove_if(learned_clauses.begin(), learned_clauses.end(),
+                                         [&](const ClauseRef &clause)
+                                         {
+                                             return clause->size() > 1 &&
+                                                    std::any_of(clause->literals.begin(), clause->literals.end(),
+                                                                [&](int lit)
+                                                                { return value_of(lit) > 0; });
+                                         }),
+                          learned_clauses.end());
+
+    initWatches();
+
+    SAT_DEBUG(debug_output)
+    {
+        std::cout << "Level-0 simplification removed " << removed << " satisfied clauses\n";
+    }
+
+    return removed;
+}
+
 size_t ClauseDatabase::reduceLearnedClauses(const std::unordered_map<int, bool> &assignments)
 {
     if (!allow_clause_deletion || active_learned <= max_learnt_clauses)
@@ -407,75 +788,152 @@ size_t ClauseDatabase::reduceLearnedClauses(const std::unordered_map<int, bool>
     // If we're still over the limit, remove the least active clauses
     if (active_learned > max_learnt_clauses)
     {
-        // Sort learned clauses by activity and LBD
-        std::vector<std::pair<ClauseID, double>> clause_scores;
+        // Glue clauses (low LBD), binaries, the clause just learned, clauses
+        // whose LBD improved since the last reduction and reasons of the
+        // solver's trail are kept; the rest compete on activity, with the
+        // higher LBD losing ties
+        std::vector<ClauseID> candidates;
+        ClauseID newest = clauses.size() - 1;
         for (size_t id = 0; id < clauses.size(); id++)
         {
-            if (!clauses[id] || !clauses[id]->is_learned || clauses[id]->is_core)
+            const auto &clause = clauses[id];
+            if (!clause || !clause->is_learned || clause->is_core || id == newest)
             {
                 continue;
             }
 
-            const auto &clause = clauses[id];
+            if (clause->used)
+            {
+                clause->used = false;
+                continue;
+            }
+
+            if (clause->size() <= 2 || clause->lbd <= clause_deletion_threshold)
+            {
+                continue;
+            }
+
+            // Reductions run mid-search, where conflict analysis still needs the reasons
+            if (is_locked && is_locked(id))
+            {
+                continue;
+            }
 
-            // Score is a combination of activity and LBD (lower LBD is better)
-            double score = clause->activity / (clause->lbd > 0 ? clause->lbd : 1.0);
-            clause_scores.push_back({id, score});
+            candidates.push_back(id);
         }
 
-        // Sort by score (ascending)
-        std::sort(clause_scores.begin(), clause_scores.end(),
-                  [](const auto &a, const auto &b)
-                  { return a.second < b.second; });
+        std::sort(candidates.begin(), candidates.end(),
+                  [&](ClauseID a, ClauseID b)
+                  {
+                      const auto &ca = clauses[a];
+                      const auto &cb = clauses[b];
+                      if (ca->activity != cb->activity)
+                          return ca->activity < cb->activity;
+                      return ca->lbd > cb->lbd;
+                  });
 
         // Target: remove clauses to get to about 3/4 of the max
         size_t target = max_learnt_clauses * 3 / 4;
-        size_t to_remove = active_learned - target;
-        size_t removed = 0;
+        size_t to_remove = std::min(active_learned - target, candidates.size());
 
-        for (const auto &[id, score] : clause_scores)
+        for (size_t i = 0; i < to_remove; i++)
         {
-            if (removed >= to_remove)
-                break;
-
-            const auto &clause = clauses[id];
+            removeClause(candidates[i]);
+        }
 
-            // Don't remove clauses with low LBD (they are high quality)
-            if (clause->lbd <= clause_deletion_threshold)
+        // Release the removed clauses held by the learned clause list
+        learned_clauses.clear();
+        for (const auto &clause : clauses)
+        {
+            if (clause && clause->is_learned)
             {
-                continue;
+                learned_clauses.push_back(clause);
             }
-
-            removeClause(id);
-            removed++;
         }
 
-        if (debug_output)
+        SAT_DEBUG(debug_output)
         {
-            std::cout << "Clause reduction removed " << removed << " low-quality learned clauses\n";
+            std::cout << "Clause reduction removed " << to_remove << " low-activity learned clauses\n";
             std::cout << "Active learned clauses: " << active_learned << "/" << max_learnt_clauses << "\n";
         }
 
-        return removed;
+        return to_remove;
     }
 
     return 0;
 }
 
+std::vector<ClauseID> ClauseDatabase::compact()
+{
+    std::vector<ClauseID> remap(clauses.size(), NO_CLAUSE);
+    size_t next = 0;
+    for (size_t id = 0; id < clauses.size(); id++)
+    {
+        if (clauses[id])
+        {
+            remap[id] = next;
+            clauses[id]->literals.shrink_to_fit();
+            clauses[next++] = std::move(clauses[id]);
+        }
+    }
+    clauses.resize(next);
+    clauses.shrink_to_fit();
+
+    learned_clauses.clear();
+    for (const auto &clause : clauses)
+    {
+        if (clause->is_learned)
+        {
+            learned_clauses.push_back(clause);
+        }
+    }
+    learned_clauses.shrink_to_fit();
+
+    // Swapping with empty lists frees their capacity; initWatches reserves exact sizes
+    for (auto &list : watches)
+    {
+        std::vector<ClauseID>().swap(list);
+    }
+    for (auto &partners : binary_partners)
+    {
+        std::vector<int>().swap(partners);
+    }
+    initWatches();
+
+    SAT_DEBUG(debug_output)
+    {
+        std::cout << "Compacted clause database to " << next << " clauses, "
+                  << current_memory_usage / 1024 << "KB\n";
+    }
+
+    return remap;
+}
+
 int ClauseDatabase::computeLBD(const Clause &clause, const std::vector<int> &levels)
 {
-    std::unordered_set<int> distinct_levels;
+    // Each call gets a fresh stamp, so no per-call set or clearing is needed
+    lbd_stamp++;
+    int lbd = 0;
 
     for (int lit : clause)
     {
         int var = std::abs(lit);
         if (var < levels.size() && levels[var] > 0)
         {
-            distinct_levels.insert(levels[var]);
+            size_t level = levels[var];
+            if (level >= lbd_stamps.size())
+            {
+                lbd_stamps.resize(std::max(level + 1, 2 * lbd_stamps.size()), 0);
+            }
+            if (lbd_stamps[level] != lbd_stamp)
+            {
+                lbd_stamps[level] = lbd_stamp;
+                lbd++;
+            }
         }
     }
 
-    return distinct_levels.size();
+    return lbd;
 }
 
 void ClauseDatabase::addAssumption(int literal)
@@ -541,15 +999,8 @@ void ClauseDatabase::printWatches() const
     {
         if (!watches[i].empty())
         {
-            int lit;
-            if (i <= num_variables)
-            {
-                lit = i; // Positive literal
-            }
-            else
-            {
-                lit = -(i - num_variables); // Negative literal
-            }
+            int var = static_cast<int>(i / 2);
+            int lit = (i % 2 == 0) ? var : -var;
 
             std::cout << "  Literal " << lit << " is watched by clauses: ";
             for (ClauseID id : watches[i])
@@ -577,8 +1028,8 @@ bool ClauseDatabase::checkWatchesConsistency() const
             int lit1 = clause->watched_lits.first;
             int lit2 = clause->watched_lits.second;
 
-            size_t watch_idx1 = lit1 > 0 ? lit1 : num_variables + std::abs(lit1);
-            size_t watch_idx2 = lit2 > 0 ? lit2 : num_variables + std::abs(lit2);
+            size_t watch_idx1 = litIndex(lit1);
+            size_t watch_idx2 = litIndex(lit2);
 
             bool found1 = false, found2 = false;
 
@@ -609,7 +1060,7 @@ bool ClauseDatabase::checkWatchesConsistency() const
         else if (clause->size() == 1)
         {
             int lit = clause->literals[0];
-            size_t watch_idx = lit > 0 ? lit : num_variables + std::abs(lit);
+            size_t watch_idx = litIndex(lit);
 
             bool found = false;
             for (ClauseID w_id : watches[watch_idx])
@@ -632,40 +1083,42 @@ bool ClauseDatabase::checkWatchesConsistency() const
     return consistent;
 }
 
+// Approximate memory held by one clause, including its watch list entries
+size_t ClauseDatabase::clauseMemory(const ClauseInfo &clause)
+{
+    return sizeof(ClauseInfo) +
+           clause.literals.size() * sizeof(int) +
+           sizeof(std::shared_ptr<ClauseInfo>) +
+           std::min<size_t>(clause.literals.size(), 2) * sizeof(ClauseID);
+}
+
 // Add memory usage tracking
 size_t ClauseDatabase::calculateMemoryUsage() const
 {
     size_t total = 0;
 
-    // Count memory used by clauses
+    // Count memory used by clauses and their watches
     for (const auto &clause : clauses)
     {
         if (clause)
         {
-            total += sizeof(ClauseInfo) +
-                     clause->literals.size() * sizeof(int) +
-                     sizeof(std::shared_ptr<ClauseInfo>);
+            total += clauseMemory(*clause);
         }
     }
 
-    // Count memory used by watch lists
-    for (const auto &watch_list : watches)
-    {
-        total += watch_list.size() * sizeof(ClauseID) +
-                 sizeof(std::vector<ClauseID>);
-    }
+    // Count memory used by the watch list headers
+    total += watches.size() * sizeof(std::vector<ClauseID>);
 
     return total;
 }
 
+// Check the running memory estimate (kept up to date by add/remove) against the limit
 void ClauseDatabase::updateMemoryUsage()
 {
-    current_memory_usage = calculateMemoryUsage();
-
     // If memory usage exceeds limit, force clause deletion
     if (current_memory_usage > MAX_MEMORY_MB * 1024 * 1024)
     {
-        if (debug_output)
+        SAT_DEBUG(debug_output)
         {
             std::cout << "Memory usage (" << current_memory_usage / (1024 * 1024)
                       << "MB) exceeds limit, forcing clause deletion.\n";
@@ -680,11 +1133,13 @@ int ClauseDatabase::addVariable()
 {
     num_variables++;
 
-    // Ensure the watches array is large enough
-    if (watches.size() <= 2 * num_variables)
-    {
-        watches.resize(2 * num_variables + 1);
-    }
+    // Literal slots 2v and 2v+1 are appended; existing watch lists stay where they are
+    watches.resize(2 * (num_variables + 1));
+    occurrences.resize(2 * (num_variables + 1), 0);
+    binary_partners.resize(2 * (num_variables + 1));
+
+    // Keep the learned clause budget in step with the formula size
+    max_learnt_clauses = std::max(max_learnt_clauses, num_variables * 4);
 
     return num_variables;
 }
\ No newline at end of file
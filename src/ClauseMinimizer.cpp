@@ -4,562 +4,229 @@
 #include <limits>
 
 ClauseMinimizer::ClauseMinimizer(
-    const std::vector<ImplicationNodeIncremental> &trail_ref,
-    const std::unordered_map<int, bool> &assignments_ref,
-    const std::unordered_map<int, size_t> &var_to_trail_ref,
-    const std::vector<int> &decision_levels_ref,
     ClauseDatabase &db_ref,
-    bool debug)
-    : trail(trail_ref),
-      assignments(assignments_ref),
-      var_to_trail(var_to_trail_ref),
-      decision_levels(decision_levels_ref),
-      db(db_ref),
+    bool debug,
+    CDCLSolverIncremental *solver_ref)
+    : db(db_ref),
+      solver(solver_ref),
+      vivify_cursor(0),
+      current_stamp(0),
       use_binary_resolution(true),
-      use_vivification(false),
+      use_vivification(true),
       debug_output(debug)
 {
 }
 
-// Main method to minimize a newly learned conflict clause
-void ClauseMinimizer::minimizeConflictClause(Clause &clause)
+// Binary-implication minimization around the first literal u. A binary
+// clause (u v x) resolves any -x out of the clause, since (C v -x) and (u v x)
+// give C when u is in C. Only u's binary partners are visited and clause
+// membership is a stamp lookup, so the cost is independent of database size.
+void ClauseMinimizer::binaryResolution(Clause &clause)
 {
     if (clause.size() <= 1)
         return;
 
-    if (debug_output)
+    const auto &partners = db.getBinaryPartners(clause[0]);
+    if (partners.empty())
+        return;
+
+    if (lit_stamps.size() < db.binary_partners.size())
     {
-        std::cout << "Before minimization: ";
-        printClause(clause);
-        std::cout << " (" << clause.size() << " literals)\n";
+        lit_stamps.resize(db.binary_partners.size(), 0);
     }
-
-    // Recursive minimization
-    seen.clear();
-
-    // Mark literals in the learned clause
-    for (int lit : clause)
+    if (++current_stamp == 0)
     {
-        seen.insert(lit);
+        // Stamp counter wrapped around: clear stale marks
+        std::fill(lit_stamps.begin(), lit_stamps.end(), 0);
+        current_stamp = 1;
     }
 
-    std::vector<int> minimized;
-
-    // Try to remove each literal
-    for (int lit : clause)
+    for (size_t i = 1; i < clause.size(); i++)
     {
-        // Don't remove literals of decision level 0
-        int var = std::abs(lit);
-        auto it = var_to_trail.find(var);
-        if (it != var_to_trail.end() && decision_levels[var] == 0)
-        {
-            minimized.push_back(lit);
-            continue;
-        }
-
-        // Check if this literal is redundant
-        if (!isRedundant(lit))
-        {
-            minimized.push_back(lit);
-        }
+        lit_stamps[litIndex(clause[i])] = current_stamp;
     }
 
-    // Update the clause if we removed any literals
-    if (minimized.size() < clause.size())
+    size_t removed = 0;
+    for (int partner : partners)
     {
-        if (debug_output)
+        size_t idx = litIndex(-partner);
+        if (lit_stamps[idx] == current_stamp)
         {
-            std::cout << "Minimized clause from " << clause.size() << " to " << minimized.size() << " literals\n";
+            lit_stamps[idx] = 0;
+            removed++;
         }
-        clause = minimized;
     }
 
-    seen.clear();
-
-    // Apply binary resolution if enabled
-    if (use_binary_resolution)
-    {
-        binaryResolution(clause);
-    }
+    if (removed == 0)
+        return;
 
-    // Apply vivification if enabled
-    if (use_vivification)
+    size_t kept = 1;
+    for (size_t i = 1; i < clause.size(); i++)
     {
-        vivification(clause);
+        if (lit_stamps[litIndex(clause[i])] == current_stamp)
+        {
+            clause[kept++] = clause[i];
+        }
     }
 
-    if (debug_output)
+    SAT_TRACE(debug_output)
     {
-        std::cout << "After minimization: ";
-        printClause(clause);
-        std::cout << " (" << clause.size() << " literals)\n";
+        std::cout << "Binary resolution removed " << removed << " literals\n";
     }
+    clause.resize(kept);
 }
 
-// Minimize all learned clauses
-void ClauseMinimizer::minimizeLearnedClauses()
+// Binary minimization step for a freshly learned clause
+void ClauseMinimizer::minimizeWithBinaries(Clause &clause)
 {
-    if (debug_output)
+    if (use_binary_resolution)
     {
-        std::cout << "Minimizing all learned clauses...\n";
+        binaryResolution(clause);
     }
+}
 
-    // Count of clauses and literals before minimization
-    size_t clauses_before = 0;
-    size_t literals_before = 0;
+// Vivification on the solver's trail. Each literal of the clause is falsified
+// in turn as a decision on one new level and propagated by the solver:
+//  - a literal already false follows from the earlier ones and is dropped,
+//  - a literal already true ends the clause right there,
+//  - a conflict shows the literals tried so far form a clause on their own.
+// Backtracking undoes exactly the implied literals, so the cost depends only on
+// what the clause implies. Runs at level 0 with no assumption on the trail
+// (the result must hold for the formula alone) and the clause must not be
+// watched.
+void ClauseMinimizer::vivification(Clause &clause)
+{
+    if (clause.size() <= 1 || !canVivify())
+        return;
 
-    // Count of clauses and literals after minimization
-    size_t clauses_after = 0;
-    size_t literals_after = 0;
+    Clause vivified;
+    bool aborted = false;
+    solver->decision_level = 1;
 
-    // Process all learned clauses
-    for (size_t i = 0; i < db.clauses.size(); i++)
+    for (int lit : clause)
     {
-        if (!db.clauses[i] || !db.clauses[i]->is_learned)
-            continue;
-
-        auto &clause = db.clauses[i]->literals;
-
-        clauses_before++;
-        literals_before += clause.size();
-
-        // Skip unit clauses
-        if (clause.size() <= 1)
+        int value = solver->litValue(lit);
+        if (value < 0)
         {
-            clauses_after++;
-            literals_after += clause.size();
-            continue;
+            continue; // Implied false by the literals before it
         }
 
-        // Minimize this clause
-        size_t before_size = clause.size();
-
-        // Self-subsumption
-        selfSubsumption(clause);
-
-        // Binary resolution
-        if (use_binary_resolution)
+        vivified.push_back(lit);
+        if (value > 0)
         {
-            binaryResolution(clause);
+            break; // Implied true by the literals before it
         }
 
-        if (debug_output && clause.size() < before_size)
+        solver->assignLiteral(-lit, std::numeric_limits<size_t>::max());
+        solver->trail.back().is_decision = true;
+        if (!solver->unitPropagate())
         {
-            std::cout << "Minimized clause " << i << " from " << before_size
-                      << " to " << clause.size() << " literals\n";
+            aborted = solver->interrupted;
+            break;
         }
-
-        clauses_after++;
-        literals_after += clause.size();
-    }
-
-    if (debug_output)
-    {
-        std::cout << "Minimization results:\n";
-        std::cout << "  Clauses: " << clauses_before << " -> " << clauses_after << "\n";
-        std::cout << "  Literals: " << literals_before << " -> " << literals_after << "\n";
-        std::cout << "  Reduction: " << (literals_before - literals_after) << " literals ("
-                  << (100.0 * (literals_before - literals_after) / literals_before) << "%)\n";
-    }
-}
-
-// Check if a literal is redundant in a conflict clause
-bool ClauseMinimizer::isRedundant(int lit)
-{
-    int var = std::abs(lit);
-    auto it = var_to_trail.find(var);
-    if (it == var_to_trail.end())
-        return false;
-
-    const auto &node = trail[it->second];
-
-    // Decision variables or assumptions are never redundant
-    if (node.is_decision || node.antecedent_id == std::numeric_limits<size_t>::max())
-    {
-        return false;
-    }
-
-    // Check if the reason clause allows us to remove this literal
-    if (node.antecedent_id >= db.clauses.size() || !db.clauses[node.antecedent_id])
-    {
-        return false; // The antecedent clause has been deleted
     }
 
-    const auto &reason = db.clauses[node.antecedent_id]->literals;
+    // Undo the probe without touching the saved phases
+    bool phase_saving = solver->use_phase_saving;
+    solver->use_phase_saving = false;
+    solver->backtrack(0);
+    solver->use_phase_saving = phase_saving;
 
-    // Check each literal in the reason clause
-    for (int reason_lit : reason)
+    // Update the clause if we removed any literals
+    if (!aborted && vivified.size() < clause.size())
     {
-        if (std::abs(reason_lit) == var)
-            continue; // Skip the literal itself
-
-        // Calculate the negated reason literal (for seen check)
-        int neg_reason_lit = -reason_lit;
-
-        // If the negation is not in seen, this literal is not redundant
-        if (seen.find(neg_reason_lit) == seen.end())
+        SAT_TRACE(debug_output)
         {
-            int reason_var = std::abs(reason_lit);
-            auto reason_it = var_to_trail.find(reason_var);
-
-            // If the reason variable is not in the trail or is from a deeper level,
-            // this literal is not redundant
-            if (reason_it == var_to_trail.end() ||
-                decision_levels[reason_var] > decision_levels[var])
-            {
-                return false;
-            }
-
-            // Try recursive minimization
-            if (!recursiveMinimize(reason_lit, seen))
-            {
-                return false;
-            }
+            std::cout << "Vivification reduced clause from " << clause.size()
+                      << " to " << vivified.size() << " literals\n";
         }
+        clause = vivified;
     }
-
-    // If we got here, the literal is redundant
-    return true;
 }
 
-// Recursive minimization of learned clauses
-bool ClauseMinimizer::recursiveMinimize(int lit, std::unordered_set<int> &seen, int depth)
+// Vivification needs a fully propagated level 0 free of assumptions
+bool ClauseMinimizer::canVivify() const
 {
-    // Avoid deep recursion
-    if (depth > 100)
-        return false;
-
-    int var = std::abs(lit);
-    auto it = var_to_trail.find(var);
-    if (it == var_to_trail.end())
-        return false;
-
-    const auto &node = trail[it->second];
-
-    // Cannot minimize using decisions or assumptions
-    if (node.is_decision || node.antecedent_id == std::numeric_limits<size_t>::max())
-    {
-        return false;
-    }
-
-    // Decision level 0 literals are always safe to remove
-    if (decision_levels[var] == 0)
-    {
-        return true;
-    }
-
-    // Check if the reason allows recursive minimization
-    if (node.antecedent_id >= db.clauses.size() || !db.clauses[node.antecedent_id])
-    {
-        return false; // Antecedent not found
-    }
-
-    const auto &reason = db.clauses[node.antecedent_id]->literals;
-
-    for (int reason_lit : reason)
-    {
-        if (std::abs(reason_lit) == var)
-            continue; // Skip the literal itself
-
-        // Check if this reason literal is already in the seen set
-        int neg_reason_lit = -reason_lit;
-        if (seen.find(neg_reason_lit) == seen.end())
-        {
-            // Not in seen, check recursively
-            int reason_var = std::abs(reason_lit);
-            auto reason_it = var_to_trail.find(reason_var);
-
-            // If not assigned or at a deeper level, cannot minimize
-            if (reason_it == var_to_trail.end() ||
-                decision_levels[reason_var] > decision_levels[var])
-            {
-                return false;
-            }
-
-            // Recurse
-            if (!recursiveMinimize(reason_lit, seen, depth + 1))
-            {
-                return false;
-            }
-        }
-    }
-
-    return true;
+    return solver != nullptr && solver->decision_level == 0 &&
+           solver->propagate_head == solver->trail.size() &&
+           solver->assumptionStart() == solver->trail.size();
 }
 
-// Self-subsumption minimization
-void ClauseMinimizer::selfSubsumption(Clause &clause)
+// The cursor moves down by the deleted clauses before it
+void ClauseMinimizer::remapClauses(const std::vector<ClauseID> &remap)
 {
-    if (clause.size() <= 1)
-        return;
-
-    std::vector<int> minimized;
-
-    // Try each literal in the clause
-    for (int lit : clause)
+    ClauseID cursor = 0;
+    for (ClauseID id = 0; id < vivify_cursor && id < remap.size(); id++)
     {
-        int neg_lit = -lit;
-        bool is_redundant = false;
-
-        // Check if this literal is redundant by self-subsumption
-        for (size_t i = 0; i < db.clauses.size(); i++)
-        {
-            if (!db.clauses[i])
-                continue;
-
-            const auto &other_clause = db.clauses[i]->literals;
-
-            // Skip the clause itself
-            if (&other_clause == &clause)
-                continue;
-
-            // Check if this clause subsumes our clause without lit
-            if (isImplied(neg_lit, other_clause))
-            {
-                is_redundant = true;
-                break;
-            }
-        }
-
-        if (!is_redundant)
-        {
-            minimized.push_back(lit);
-        }
-        else if (debug_output)
+        if (remap[id] != ClauseDatabase::NO_CLAUSE)
         {
-            std::cout << "Removed literal " << lit << " by self-subsumption\n";
+            cursor++;
         }
     }
-
-    if (minimized.size() < clause.size())
-    {
-        clause = minimized;
-    }
+    vivify_cursor = cursor;
 }
 
-// Binary resolution minimization
-void ClauseMinimizer::binaryResolution(Clause &clause)
+// Vivify learned clauses added since the last call, at most max_clauses of
+// them. Clauses touching a root-level literal are left to simplification.
+// Under assumptions the round runs below them: they are lifted off the trail
+// and put back afterwards for the search to propagate.
+size_t ClauseMinimizer::vivifyLearnedClauses(size_t max_clauses)
 {
-    if (clause.size() <= 1)
-        return;
+    if (!use_vivification || solver == nullptr || solver->decision_level != 0 ||
+        solver->propagate_head != solver->trail.size())
+        return 0;
 
-    std::unordered_set<int> clause_lits(clause.begin(), clause.end());
-    bool changed = false;
+    std::vector<ImplicationNodeIncremental> lifted = solver->liftAssumptions();
 
-    // Try each binary clause in the database
-    for (size_t i = 0; i < db.clauses.size(); i++)
+    size_t strengthened = 0;
+    size_t tried = 0;
+    for (; vivify_cursor < db.clauses.size() && tried < max_clauses; vivify_cursor++)
     {
-        if (!db.clauses[i] || db.clauses[i]->size() != 2)
+        const auto &clause_ref = db.clauses[vivify_cursor];
+        if (!clause_ref || !clause_ref->is_learned || clause_ref->size() <= 2)
             continue;
 
-        const auto &binary = db.clauses[i]->literals;
-        int lit1 = binary[0];
-        int lit2 = binary[1];
-
-        // Check if the first literal is in our clause
-        if (clause_lits.find(-lit1) != clause_lits.end())
+        bool touches_root = false;
+        for (int lit : clause_ref->literals)
         {
-            // Add the second literal if not already present
-            if (clause_lits.find(lit2) == clause_lits.end())
+            if (solver->litValue(lit) != 0)
             {
-                clause_lits.insert(lit2);
-                changed = true;
-
-                if (debug_output)
-                {
-                    std::cout << "Added literal " << lit2 << " by binary resolution\n";
-                }
-            }
-        }
-
-        // Check if the second literal is in our clause
-        if (clause_lits.find(-lit2) != clause_lits.end())
-        {
-            // Add the first literal if not already present
-            if (clause_lits.find(lit1) == clause_lits.end())
-            {
-                clause_lits.insert(lit1);
-                changed = true;
-
-                if (debug_output)
-                {
-                    std::cout << "Added literal " << lit1 << " by binary resolution\n";
-                }
+                touches_root = true;
+                break;
             }
         }
-    }
-
-    if (changed)
-    {
-        // Rebuild the clause
-        clause.clear();
-        for (int lit : clause_lits)
-        {
-            clause.push_back(lit);
-        }
-
-        // Ensure deterministic order
-        std::sort(clause.begin(), clause.end());
-    }
-}
-
-// Vivification minimization
-void ClauseMinimizer::vivification(Clause &clause)
-{
-    if (clause.size() <= 1)
-        return;
-
-    // Save current assignments
-    auto saved_assignments = assignments;
-
-    // Sort clause literals by decision level (lowest first)
-    std::vector<std::pair<int, int>> sorted_lits;
-    for (int lit : clause)
-    {
-        int var = std::abs(lit);
-        int level = var_to_trail.find(var) != var_to_trail.end() ? decision_levels[var] : std::numeric_limits<int>::max();
-        sorted_lits.push_back({lit, level});
-    }
-
-    std::sort(sorted_lits.begin(), sorted_lits.end(),
-              [](const auto &a, const auto &b)
-              { return a.second < b.second; });
-
-    // Try to falsify each literal and detect forced assignments
-    std::vector<int> vivified;
-    std::unordered_set<int> forced_true;
-
-    for (const auto &[lit, _] : sorted_lits)
-    {
-        int var = std::abs(lit);
-        bool value_to_set = (lit < 0); // Falsify the literal
-
-        // If this literal is already forced true, keep it
-        if (forced_true.find(lit) != forced_true.end())
-        {
-            vivified.push_back(lit);
+        if (touches_root)
             continue;
-        }
-
-        // Tentatively assign the opposite value to falsify this literal
-        auto &temp_assignments = const_cast<std::unordered_map<int, bool> &>(assignments);
-        temp_assignments[var] = value_to_set;
 
-        // Check if this forces any other literals to be true
-        bool conflict = false;
-        for (size_t i = 0; i < db.clauses.size() && !conflict; i++)
+        tried++;
+        Clause literals = clause_ref->literals;
+        db.detachClause(vivify_cursor);
+        vivification(literals);
+        if (literals.size() < clause_ref->size())
         {
-            if (!db.clauses[i])
-                continue;
-
-            const auto &c = db.clauses[i]->literals;
-
-            // Count false and unassigned literals
-            int false_count = 0;
-            int unassigned_count = 0;
-            int last_unassigned = 0;
-
-            for (int l : c)
-            {
-                int v = std::abs(l);
-                auto it = temp_assignments.find(v);
-
-                if (it == temp_assignments.end())
-                {
-                    unassigned_count++;
-                    last_unassigned = l;
-                }
-                else if ((l > 0 && !it->second) || (l < 0 && it->second))
-                {
-                    false_count++;
-                }
-            }
-
-            // If all literals are false, we have a conflict
-            if (false_count == c.size())
-            {
-                conflict = true;
-                break;
-            }
-
-            // If all but one are false, the last one is forced true
-            if (false_count == c.size() - 1 && unassigned_count == 1)
-            {
-                forced_true.insert(last_unassigned);
-                temp_assignments[std::abs(last_unassigned)] = (last_unassigned > 0);
-
-                // If this forces one of our literals true, mark it
-                for (int l : clause)
-                {
-                    if (l == last_unassigned)
-                    {
-                        vivified.push_back(l);
-                        break;
-                    }
-                }
-            }
+            db.replaceLiterals(vivify_cursor, literals);
+            strengthened++;
         }
+        db.attachClause(vivify_cursor);
 
-        // If we got a conflict, this literal must stay in the clause
-        if (conflict)
+        // A clause shrunk to one literal is a new root fact, to be propagated
+        // by the search before the next round. With assumptions lifted it
+        // stays a watched unit clause until the next solve asserts it.
+        if (literals.size() == 1 && lifted.empty())
         {
-            vivified.push_back(lit);
+            solver->assignLiteral(literals[0], vivify_cursor);
+            vivify_cursor++;
+            break;
         }
-    }
 
-    // Restore original assignments
-    const_cast<std::unordered_map<int, bool> &>(assignments) = saved_assignments;
-
-    // Update the clause if we removed any literals
-    if (vivified.size() < clause.size())
-    {
-        if (debug_output)
-        {
-            std::cout << "Vivification reduced clause from " << clause.size()
-                      << " to " << vivified.size() << " literals\n";
-        }
-        clause = vivified;
+        if (solver->interrupted)
+            break;
     }
-}
+    solver->restoreAssumptions(lifted);
 
-// Check if a literal is implied by a clause
-bool ClauseMinimizer::isImplied(int lit, const Clause &by_clause)
-{
-    // Check if the clause contains the negation of any literal in our clause
-    for (int clause_lit : by_clause)
+    SAT_DEBUG(debug_output && strengthened > 0)
     {
-        if (clause_lit == lit)
-        {
-            return true;
-        }
+        std::cout << "Vivification strengthened " << strengthened << " of " << tried << " learned clauses\n";
     }
-
-    return false;
+    return strengthened;
 }
-
-// Print a clause
-void ClauseMinimizer::printClause(const Clause &clause) const
-{
-    if (!debug_output)
-        return;
-
-    std::cout << "(";
-    for (size_t i = 0; i < clause.size(); i++)
-    {
-        int lit = clause[i];
-        if (lit > 0)
-        {
-            std::cout << "x" << lit;
-        }
-        else
-        {
-            std::cout << "~x" << -lit;
-        }
-
-        if (i < clause.size() - 1)
-        {
-            std::cout << " ∨ ";
-        }
-    }
-    std::cout << ")";
-}
\ No newline at end of file
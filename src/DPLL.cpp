@@ -21,7 +21,7 @@ bool unitPropagation(SATInstance &instance)
                 // Conflict detection
                 if (instance.assignments.count(var) && instance.assignments[var] != value)
                 {
-                    if (instance.debug_output)
+                    SAT_TRACE(instance.debug_output)
                     {
                         std::cout << "Conflict detected: x" << var << " already assigned " << instance.assignments[var] << "\n";
                     }
@@ -34,7 +34,7 @@ bool unitPropagation(SATInstance &instance)
 
                 // Assign the variable and remove the clause
                 instance.assignments[var] = value;
-                if (instance.debug_output)
+                SAT_TRACE(instance.debug_output)
                 {
                     std::cout << "Unit Propagation: Assigning x" << var << " = " << value << "\n";
                 }
@@ -51,7 +51,7 @@ bool unitPropagation(SATInstance &instance)
                         clause.erase(negPos);
                         if (clause.empty())
                         {
-                            if (instance.debug_output)
+                            SAT_TRACE(instance.debug_output)
                             {
                                 std::cout << "Empty clause detected after removing x" << var << "\n";
                             }
@@ -94,7 +94,7 @@ bool unitPropagation(SATInstance &instance)
                     // Conflict detection
                     if (instance.assignments.count(var) && instance.assignments[var] != value)
                     {
-                        if (instance.debug_output)
+                        SAT_TRACE(instance.debug_output)
                         {
                             std::cout << "Conflict detected: x" << var << " already assigned " << instance.assignments[var] << "\n";
                         }
@@ -107,7 +107,7 @@ bool unitPropagation(SATInstance &instance)
 
                     // Assign the variable and remove the clause
                     instance.assignments[var] = value;
-                    if (instance.debug_output)
+                    SAT_TRACE(instance.debug_output)
                     {
                         std::cout << "Implied Unit: Assigning x" << var << " = " << value << "\n";
                     }
@@ -124,7 +124,7 @@ bool unitPropagation(SATInstance &instance)
                             clause.erase(negPos);
                             if (clause.empty())
                             {
-                                if (instance.debug_output)
+                                SAT_TRACE(instance.debug_output)
                                 {
                                     std::cout << "Empty clause detected after removing x" << var << "\n";
                                 }
@@ -146,7 +146,7 @@ bool unitPropagation(SATInstance &instance)
         }
     } while (changed);
 
-    if (instance.debug_output)
+    SAT_TRACE(instance.debug_output)
     {
         std::cout << "Unit propagation done. Formula size: " << instance.formula.size() << "\n";
     }
@@ -178,7 +178,7 @@ void pureLiteralElimination(SATInstance &instance)
     for (int literal : pureLiterals)
     {
         instance.assignments[abs(literal)] = (literal > 0);
-        if (instance.debug_output)
+        SAT_TRACE(instance.debug_output)
         {
             std::cout << "Pure Literal Elimination: Assigning x" << abs(literal) << " = " << (literal > 0) << "\n";
         }
@@ -194,7 +194,7 @@ bool DPLL(SATInstance &instance)
 {
     dpll_calls++;
 
-    if (instance.debug_output)
+    SAT_TRACE(instance.debug_output)
     {
         std::cout << "DPLL Call #" << dpll_calls << "\n";
         std::cout << "Current Assignments:\n";
@@ -208,7 +208,7 @@ bool DPLL(SATInstance &instance)
     // Base Case: All clauses satisfied
     if (instance.formula.empty())
     {
-        if (instance.debug_output)
+        SAT_TRACE(instance.debug_output)
         {
             std::cout << "Formula empty. SATISFIABLE.\n";
         }
@@ -220,7 +220,7 @@ bool DPLL(SATInstance &instance)
     {
         if (clause.empty())
         {
-            if (instance.debug_output)
+            SAT_TRACE(instance.debug_output)
             {
                 std::cout << "Empty clause detected. UNSATISFIABLE.\n";
             }
@@ -236,7 +236,7 @@ bool DPLL(SATInstance &instance)
     // Apply optimizations
     if (!unitPropagation(instance))
     {
-        if (instance.debug_output)
+        SAT_TRACE(instance.debug_output)
         {
             std::cout << "Conflict detected during unit propagation. UNSATISFIABLE.\n";
         }
@@ -253,7 +253,7 @@ bool DPLL(SATInstance &instance)
 
     if (variable == 0)
     {
-        if (instance.debug_output)
+        SAT_TRACE(instance.debug_output)
         {
             std::cout << "No unassigned variables left. SATISFIABLE.\n";
         }
@@ -261,7 +261,7 @@ bool DPLL(SATInstance &instance)
     }
 
     // Try assigning variable = true
-    if (instance.debug_output)
+    SAT_TRACE(instance.debug_output)
     {
         std::cout << "Trying x" << variable << " = true (VSIDS activity: " << instance.activity[variable] << ")\n";
     }
@@ -272,7 +272,7 @@ bool DPLL(SATInstance &instance)
         return true;
 
     // Try assigning variable = false
-    if (instance.debug_output)
+    SAT_TRACE(instance.debug_output)
     {
         std::cout << "Backtracking: Trying x" << variable << " = false\n";
     }
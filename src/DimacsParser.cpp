@@ -0,0 +1,156 @@
+#include "../include/DimacsParser.h"
+#include <fstream>
+#include <sstream>
+#include <limits>
+
+namespace
+{
+    // Skip whitespace and comment lines; false at end of input
+    bool skipToToken(std::istream &in)
+    {
+        while (true)
+        {
+            in >> std::ws;
+            int next = in.peek();
+            if (next == EOF)
+            {
+                return false;
+            }
+            if (next != 'c')
+            {
+                return true;
+            }
+            in.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
+        }
+    }
+
+    // Literals up to the terminating 0
+    bool readClause(std::istream &in, Clause &clause)
+    {
+        clause.clear();
+        long long lit;
+        while (in >> lit)
+        {
+            if (lit == 0)
+            {
+                return true;
+            }
+            if (lit > std::numeric_limits<int>::max() || lit < -std::numeric_limits<int>::max())
+            {
+                return false;
+            }
+            clause.push_back(static_cast<int>(lit));
+        }
+        return false;
+    }
+}
+
+bool readDimacs(std::istream &in, CNF &formula)
+{
+    formula.clear();
+
+    std::string token;
+    size_t declared_clauses = 0;
+    if (skipToToken(in) && in.peek() == 'p')
+    {
+        std::string format;
+        size_t vars = 0;
+        if (!(in >> token >> format >> vars >> declared_clauses) || format != "cnf")
+        {
+            return false;
+        }
+        formula.reserve(declared_clauses);
+    }
+
+    Clause clause;
+    while (skipToToken(in))
+    {
+        if (!readClause(in, clause))
+        {
+            return false;
+        }
+        formula.push_back(clause);
+    }
+    return true;
+}
+
+bool readWcnf(std::istream &in, CNF &hard, CNF &soft, std::vector<int> &weights)
+{
+    hard.clear();
+    soft.clear();
+    weights.clear();
+
+    // Classic header with an optional top weight
+    long long top = std::numeric_limits<long long>::max();
+    if (skipToToken(in) && in.peek() == 'p')
+    {
+        std::string line;
+        std::getline(in, line);
+        std::istringstream header(line);
+        std::string p, format;
+        size_t vars = 0, clauses = 0;
+        if (!(header >> p >> format >> vars >> clauses) || format != "wcnf")
+        {
+            return false;
+        }
+        long long declared_top;
+        if (header >> declared_top)
+        {
+            top = declared_top;
+        }
+    }
+
+    Clause clause;
+    while (skipToToken(in))
+    {
+        if (in.peek() == 'h')
+        {
+            in.get();
+            if (!readClause(in, clause))
+            {
+                return false;
+            }
+            hard.push_back(clause);
+            continue;
+        }
+
+        long long weight;
+        if (!(in >> weight) || weight <= 0 || !readClause(in, clause))
+        {
+            return false;
+        }
+        if (weight >= top)
+        {
+            hard.push_back(clause);
+        }
+        else if (weight > std::numeric_limits<int>::max())
+        {
+            return false;
+        }
+        else
+        {
+            soft.push_back(clause);
+            weights.push_back(static_cast<int>(weight));
+        }
+    }
+    return true;
+}
+
+bool readFormulaFile(const std::string &path, CNF &hard, CNF &soft, std::vector<int> &weights, bool &weighted)
+{
+    std::ifstream file(path);
+    if (!file)
+    {
+        return false;
+    }
+
+    weighted = path.size() >= 5 && path.compare(path.size() - 5, 5, ".wcnf") == 0;
+    if (weighted)
+    {
+        return readWcnf(file, hard, soft, weights);
+    }
+
+    soft.clear();
+    weights.clear();
+    return readDimacs(file, hard);
+}
@@ -0,0 +1,699 @@
+#include "../include/DistributedPortfolio.h"
+#include "../include/CDCLSolverIncremental.h"
+#include "../include/PortfolioManager.h"
+#include <arpa/inet.h>
+#include <iostream>
+#include <netdb.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+namespace
+{
+    // Shared clauses kept per job on a worker; later ones are not shared
+    constexpr size_t MAX_SHARED_CLAUSES = 1 << 18;
+
+    int maxVariable(const CNF &formula)
+    {
+        int num_vars = 0;
+        for (const auto &clause : formula)
+        {
+            for (int lit : clause)
+            {
+                num_vars = std::max(num_vars, std::abs(lit));
+            }
+        }
+        return num_vars;
+    }
+
+    // Model as literals over variables 1..n; checked before the coordinator accepts it
+    bool satisfies(const CNF &formula, const std::vector<int> &model)
+    {
+        for (const auto &clause : formula)
+        {
+            bool satisfied = false;
+            for (int lit : clause)
+            {
+                size_t var = std::abs(lit);
+                if (var <= model.size() && model[var - 1] == lit)
+                {
+                    satisfied = true;
+                    break;
+                }
+            }
+            if (!satisfied)
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    // Frames are small and interactive, so do not let Nagle hold them back
+    void setNoDelay(int fd)
+    {
+        int one = 1;
+        setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+    }
+}
+
+DistributedCoordinator::DistributedCoordinator(const Config &config)
+    : config(config),
+      listen_fd(-1),
+      port(0),
+      next_job_id(1),
+      next_task_id(1),
+      stopping(false),
+      shared_clauses(0)
+{
+}
+
+// Closing the connections releases the workers
+DistributedCoordinator::~DistributedCoordinator()
+{
+    for (auto &worker : workers)
+    {
+        if (worker.fd >= 0)
+        {
+            close(worker.fd);
+        }
+    }
+    if (listen_fd >= 0)
+    {
+        close(listen_fd);
+    }
+}
+
+bool DistributedCoordinator::listen()
+{
+    sockaddr_in address{};
+    address.sin_family = AF_INET;
+    address.sin_port = htons(config.port);
+    if (inet_pton(AF_INET, config.bind_address.c_str(), &address.sin_addr) != 1)
+    {
+        return false;
+    }
+
+    listen_fd = socket(AF_INET, SOCK_STREAM, 0);
+    if (listen_fd < 0)
+    {
+        return false;
+    }
+    int one = 1;
+    setsockopt(listen_fd, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one));
+
+    socklen_t length = sizeof(address);
+    if (bind(listen_fd, reinterpret_cast<sockaddr *>(&address), sizeof(address)) < 0 ||
+        ::listen(listen_fd, 64) < 0 ||
+        getsockname(listen_fd, reinterpret_cast<sockaddr *>(&address), &length) < 0)
+    {
+        close(listen_fd);
+        listen_fd = -1;
+        return false;
+    }
+    port = ntohs(address.sin_port);
+    return true;
+}
+
+size_t DistributedCoordinator::acceptWorkers()
+{
+    auto deadline = std::chrono::steady_clock::now() + config.connect_timeout;
+    while (listen_fd >= 0 && workers.size() < static_cast<size_t>(config.num_workers) && !stopping)
+    {
+        auto remaining = std::chrono::duration_cast<std::chrono::milliseconds>(
+            deadline - std::chrono::steady_clock::now());
+        if (remaining.count() <= 0)
+        {
+            break;
+        }
+
+        pollfd listener{listen_fd, POLLIN, 0};
+        if (poll(&listener, 1, static_cast<int>(std::min<int64_t>(remaining.count(), 200))) <= 0)
+        {
+            continue;
+        }
+        int fd = accept(listen_fd, nullptr, nullptr);
+        if (fd < 0)
+        {
+            continue;
+        }
+        setNoDelay(fd);
+
+        // A connection that does not introduce itself in time is dropped
+        timeval hello_timeout{5, 0};
+        setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &hello_timeout, sizeof(hello_timeout));
+        Worker worker;
+        worker.fd = fd;
+        MessageType type;
+        std::vector<uint8_t> payload;
+        if (!receiveFrame(fd, type, payload) || type != MessageType::HELLO || !decodeHello(payload, worker.slots))
+        {
+            close(fd);
+            continue;
+        }
+        timeval no_timeout{0, 0};
+        setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &no_timeout, sizeof(no_timeout));
+
+        workers.push_back(worker);
+        std::cout << "Worker " << workers.size() << " connected with " << worker.slots << " slots" << std::endl;
+    }
+    return workers.size();
+}
+
+// One task per slot for the configuration portfolio, or one per cube. Cubes
+// split on the most frequent variables and rotate through the configurations.
+std::deque<DistributedTask> DistributedCoordinator::makeTasks(const CNF &formula)
+{
+    std::deque<DistributedTask> tasks;
+    int num_vars = maxVariable(formula);
+
+    std::vector<size_t> occurrences(num_vars + 1, 0);
+    for (const auto &clause : formula)
+    {
+        for (int lit : clause)
+        {
+            occurrences[std::abs(lit)]++;
+        }
+    }
+    std::vector<int> vars;
+    for (int var = 1; var <= num_vars; var++)
+    {
+        if (occurrences[var] > 0)
+        {
+            vars.push_back(var);
+        }
+    }
+
+    size_t k = std::min<size_t>(std::clamp(config.cube_variables, 0, 16), vars.size());
+    if (k == 0)
+    {
+        uint32_t slots = 0;
+        for (const auto &worker : workers)
+        {
+            slots += worker.fd >= 0 ? worker.slots : 0;
+        }
+        for (uint32_t i = 0; i < slots; i++)
+        {
+            tasks.push_back({next_task_id++, i, {}});
+        }
+        return tasks;
+    }
+
+    std::partial_sort(vars.begin(), vars.begin() + k, vars.end(), [&](int a, int b)
+                      { return occurrences[a] > occurrences[b] || (occurrences[a] == occurrences[b] && a < b); });
+    for (uint32_t mask = 0; mask < (1u << k); mask++)
+    {
+        DistributedTask task{next_task_id++, mask, {}};
+        for (size_t j = 0; j < k; j++)
+        {
+            task.cube.push_back((mask >> j) & 1 ? vars[j] : -vars[j]);
+        }
+        tasks.push_back(std::move(task));
+    }
+    return tasks;
+}
+
+// Fill free slots from the queue. A failed send shuts the socket down; the
+// event loop then sees the worker drop and requeues its tasks.
+void DistributedCoordinator::dispatch(std::deque<DistributedTask> &queue)
+{
+    for (auto &worker : workers)
+    {
+        while (worker.fd >= 0 && worker.running.size() < worker.slots && !queue.empty())
+        {
+            if (!sendFrame(worker.fd, MessageType::TASK, encodeTask(queue.front())))
+            {
+                shutdown(worker.fd, SHUT_RDWR);
+                break;
+            }
+            worker.running.push_back(queue.front());
+            queue.pop_front();
+        }
+    }
+}
+
+void DistributedCoordinator::dropWorker(Worker &worker, std::deque<DistributedTask> &queue)
+{
+    std::cout << "Worker lost, requeueing " << worker.running.size() << " tasks" << std::endl;
+    close(worker.fd);
+    worker.fd = -1;
+    queue.insert(queue.begin(), worker.running.begin(), worker.running.end());
+    worker.running.clear();
+}
+
+void DistributedCoordinator::broadcast(MessageType type, const std::vector<uint8_t> &payload, const Worker *except)
+{
+    for (auto &worker : workers)
+    {
+        if (worker.fd >= 0 && &worker != except && !sendFrame(worker.fd, type, payload))
+        {
+            shutdown(worker.fd, SHUT_RDWR);
+        }
+    }
+}
+
+JobResult DistributedCoordinator::solve(const CNF &formula)
+{
+    JobResult result;
+    result.status = JobStatus::TIMEOUT;
+    stopping = false;
+
+    uint64_t job_id = next_job_id++;
+    auto deadline = std::chrono::steady_clock::now() + config.timeout;
+
+    DistributedFormula message;
+    message.job_id = job_id;
+    message.share_max_length = config.share_max_length;
+    message.clauses = formula;
+    broadcast(MessageType::FORMULA, encodeFormula(message));
+
+    // Tasks of an earlier job were cancelled; their results are ignored by id
+    for (auto &worker : workers)
+    {
+        worker.running.clear();
+    }
+    std::deque<DistributedTask> queue = makeTasks(formula);
+    bool cube_mode = !queue.empty() && !queue.front().cube.empty();
+    size_t cubes_left = cube_mode ? queue.size() : 0;
+    dispatch(queue);
+
+    bool settled = false;
+    MessageType type;
+    std::vector<uint8_t> payload;
+    while (!settled)
+    {
+        if (stopping)
+        {
+            result.status = JobStatus::CANCELLED;
+            break;
+        }
+        auto remaining = std::chrono::duration_cast<std::chrono::milliseconds>(
+            deadline - std::chrono::steady_clock::now());
+        if (remaining.count() <= 0)
+        {
+            break;
+        }
+
+        std::vector<pollfd> fds;
+        std::vector<Worker *> owners;
+        for (auto &worker : workers)
+        {
+            if (worker.fd >= 0)
+            {
+                fds.push_back({worker.fd, POLLIN, 0});
+                owners.push_back(&worker);
+            }
+        }
+        if (fds.empty())
+        {
+            result.status = JobStatus::ERROR; // Every worker is gone
+            break;
+        }
+        if (poll(fds.data(), fds.size(), static_cast<int>(std::min<int64_t>(remaining.count(), 200))) <= 0)
+        {
+            continue;
+        }
+
+        for (size_t i = 0; i < fds.size() && !settled; i++)
+        {
+            if (fds[i].revents == 0)
+            {
+                continue;
+            }
+            Worker &worker = *owners[i];
+            if (!receiveFrame(worker.fd, type, payload))
+            {
+                dropWorker(worker, queue);
+                dispatch(queue);
+                continue;
+            }
+
+            // Learned clauses go on to every other worker unchanged
+            if (type == MessageType::CLAUSES)
+            {
+                uint64_t batch_job;
+                CNF clauses;
+                if (decodeClauseBatch(payload, batch_job, clauses) && batch_job == job_id && !clauses.empty())
+                {
+                    shared_clauses += clauses.size();
+                    broadcast(MessageType::CLAUSES, payload, &worker);
+                }
+                continue;
+            }
+
+            JobResult task_result;
+            if (type != MessageType::RESULT || !decodeJobResult(payload, task_result))
+            {
+                continue;
+            }
+            auto it = std::find_if(worker.running.begin(), worker.running.end(), [&](const DistributedTask &task)
+                                   { return task.id == task_result.id; });
+            if (it == worker.running.end())
+            {
+                continue; // From an earlier job
+            }
+            DistributedTask task = std::move(*it);
+            worker.running.erase(it);
+
+            if (task_result.status == JobStatus::SAT)
+            {
+                if (satisfies(formula, task_result.literals))
+                {
+                    result.status = JobStatus::SAT;
+                    result.literals = std::move(task_result.literals);
+                    settled = true;
+                    break;
+                }
+                std::cout << "Discarding a model that does not satisfy the formula" << std::endl;
+            }
+            else if (task_result.status == JobStatus::UNSAT)
+            {
+                // Without cube literals in the refutation, the formula itself is refuted
+                if (!cube_mode || task_result.literals.empty())
+                {
+                    result.status = JobStatus::UNSAT;
+                    settled = true;
+                    break;
+                }
+
+                // The refutation also covers every queued cube containing its literals
+                const auto &core = task_result.literals;
+                auto covered = [&](const DistributedTask &queued)
+                {
+                    return std::all_of(core.begin(), core.end(), [&](int lit)
+                                       { return std::find(queued.cube.begin(), queued.cube.end(), lit) != queued.cube.end(); });
+                };
+                size_t before = queue.size();
+                queue.erase(std::remove_if(queue.begin(), queue.end(), covered), queue.end());
+                cubes_left -= 1 + (before - queue.size());
+                if (cubes_left == 0)
+                {
+                    result.status = JobStatus::UNSAT;
+                    settled = true;
+                    break;
+                }
+            }
+            else
+            {
+                queue.push_back(std::move(task)); // Stopped or failed without an answer, run it again
+            }
+            dispatch(queue);
+        }
+    }
+
+    // First answer wins: everything still running is cancelled
+    broadcast(MessageType::CANCEL, encodeCancel(job_id));
+    for (auto &worker : workers)
+    {
+        worker.running.clear();
+    }
+    result.id = job_id;
+    return result;
+}
+
+DistributedWorker::DistributedWorker(const Config &config)
+    : config(config),
+      fd(-1),
+      pool(std::max(1, config.num_threads)),
+      tasks_completed(0)
+{
+}
+
+DistributedWorker::~DistributedWorker()
+{
+    stop();
+    pool.wait();
+    if (fd >= 0)
+    {
+        close(fd);
+    }
+}
+
+// Retry until the coordinator is up or the connect timeout passes
+bool DistributedWorker::connectToCoordinator()
+{
+    addrinfo hints{};
+    hints.ai_family = AF_UNSPEC;
+    hints.ai_socktype = SOCK_STREAM;
+    addrinfo *addresses = nullptr;
+    std::string service = std::to_string(config.port);
+    if (getaddrinfo(config.host.c_str(), service.c_str(), &hints, &addresses) != 0)
+    {
+        return false;
+    }
+
+    auto deadline = std::chrono::steady_clock::now() + config.connect_timeout;
+    int connected = -1;
+    while (connected < 0)
+    {
+        for (addrinfo *address = addresses; address != nullptr && connected < 0; address = address->ai_next)
+        {
+            int candidate = socket(address->ai_family, address->ai_socktype, address->ai_protocol);
+            if (candidate >= 0 && connect(candidate, address->ai_addr, address->ai_addrlen) == 0)
+            {
+                connected = candidate;
+            }
+            else if (candidate >= 0)
+            {
+                close(candidate);
+            }
+        }
+        if (connected < 0)
+        {
+            if (std::chrono::steady_clock::now() >= deadline)
+            {
+                break;
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds(100));
+        }
+    }
+    freeaddrinfo(addresses);
+
+    if (connected < 0)
+    {
+        return false;
+    }
+    setNoDelay(connected);
+    fd = connected;
+    return true;
+}
+
+bool DistributedWorker::run()
+{
+    if (!connectToCoordinator())
+    {
+        return false;
+    }
+    send(MessageType::HELLO, encodeHello(static_cast<uint32_t>(pool.size())));
+
+    MessageType type;
+    std::vector<uint8_t> payload;
+    while (receiveFrame(fd, type, payload))
+    {
+        std::lock_guard<std::mutex> lock(job_mutex);
+        if (type == MessageType::FORMULA)
+        {
+            DistributedFormula message;
+            if (!decodeFormula(payload, message))
+            {
+                continue;
+            }
+            if (job)
+            {
+                job->cancelled = true;
+            }
+            job = std::make_shared<Job>();
+            job->id = message.job_id;
+            job->share_max_length = message.share_max_length;
+            job->formula = std::move(message.clauses);
+            job->num_vars = maxVariable(job->formula);
+        }
+        else if (type == MessageType::TASK)
+        {
+            DistributedTask task;
+            if (job && decodeTask(payload, task))
+            {
+                std::shared_ptr<Job> current = job;
+                pool.submit([this, current, task]()
+                            { runTask(current, task); });
+            }
+        }
+        else if (type == MessageType::CLAUSES)
+        {
+            uint64_t job_id;
+            CNF clauses;
+            if (job && decodeClauseBatch(payload, job_id, clauses) && job_id == job->id)
+            {
+                std::lock_guard<std::mutex> clauses_lock(job->clauses_mutex);
+                for (auto &clause : clauses)
+                {
+                    if (job->clauses.size() >= MAX_SHARED_CLAUSES)
+                    {
+                        break;
+                    }
+                    job->clauses.emplace_back(0, std::move(clause));
+                }
+            }
+        }
+        else if (type == MessageType::CANCEL)
+        {
+            uint64_t job_id;
+            if (job && decodeCancel(payload, job_id) && job_id == job->id)
+            {
+                job->cancelled = true;
+            }
+        }
+    }
+
+    // The coordinator is gone: nothing left to report to
+    {
+        std::lock_guard<std::mutex> lock(job_mutex);
+        if (job)
+        {
+            job->cancelled = true;
+        }
+    }
+    pool.wait();
+    return true;
+}
+
+void DistributedWorker::stop()
+{
+    {
+        std::lock_guard<std::mutex> lock(job_mutex);
+        if (job)
+        {
+            job->cancelled = true;
+        }
+    }
+    if (fd >= 0)
+    {
+        shutdown(fd, SHUT_RDWR);
+    }
+}
+
+// Solve in slices of slice_conflicts conflicts; between slices the clauses
+// learned so far are published and the other solvers' clauses imported
+void DistributedWorker::runTask(std::shared_ptr<Job> job, const DistributedTask &task)
+{
+    JobResult result;
+    result.id = task.id;
+    result.status = JobStatus::CANCELLED;
+
+    try
+    {
+        if (!job->cancelled)
+        {
+            CDCLSolverIncremental solver(job->formula);
+            solver.ensureVariable(job->num_vars);
+            PortfolioManager::applyConfiguration(solver, static_cast<int>(task.config));
+            solver.setTimeout(std::chrono::hours(24 * 365)); // The coordinator decides when to stop
+
+            std::vector<Clause> learned;
+            if (job->share_max_length > 0)
+            {
+                solver.setLearnCallback(job->share_max_length, [&learned](const Clause &clause)
+                                        { learned.push_back(clause); });
+            }
+            int slice_end = 0;
+            solver.setTerminateCallback([&]()
+                                        { return job->cancelled.load() || solver.getConflicts() >= slice_end; });
+
+            size_t cursor = 0;
+            CNF imported;
+            while (!job->cancelled)
+            {
+                slice_end = solver.getConflicts() + std::max(1, config.slice_conflicts);
+                if (solver.solve(task.cube))
+                {
+                    result.status = JobStatus::SAT;
+                    const auto &assignment = solver.getAssignments();
+                    for (int var = 1; var <= job->num_vars; var++)
+                    {
+                        auto it = assignment.find(var);
+                        result.literals.push_back(it != assignment.end() && it->second ? var : -var);
+                    }
+                    break;
+                }
+                if (!solver.wasInterrupted())
+                {
+                    result.status = JobStatus::UNSAT;
+                    result.literals = solver.getUnsatCore();
+                    break;
+                }
+
+                // Learned clauses are implied by the formula alone (assumption
+                // literals stay in them), so they are safe to add as permanent clauses
+                if (job->share_max_length > 0)
+                {
+                    exchangeClauses(*job, task.id, learned, cursor, imported);
+                    for (const auto &clause : imported)
+                    {
+                        solver.addClause(clause);
+                    }
+                }
+            }
+        }
+    }
+    catch (const std::exception &e)
+    {
+        // Out of memory on a large formula or clause import: this task fails,
+        // the worker and its other tasks carry on
+        std::cerr << "Task " << task.id << " failed: " << e.what() << std::endl;
+        result = JobResult();
+        result.id = task.id;
+        result.status = JobStatus::ERROR;
+    }
+
+    tasks_completed++;
+    send(MessageType::RESULT, encodeJobResult(result));
+}
+
+// Publish this task's new clauses, collect everyone else's since cursor, and
+// send the clauses learned on this worker that the coordinator has not seen
+void DistributedWorker::exchangeClauses(Job &job, uint64_t task_id, std::vector<Clause> &learned, size_t &cursor,
+                                        CNF &imported)
+{
+    imported.clear();
+    CNF outgoing;
+    {
+        std::lock_guard<std::mutex> lock(job.clauses_mutex);
+        for (auto &clause : learned)
+        {
+            if (job.clauses.size() >= MAX_SHARED_CLAUSES)
+            {
+                break;
+            }
+            job.clauses.emplace_back(task_id, std::move(clause));
+        }
+        learned.clear();
+
+        for (; cursor < job.clauses.size(); cursor++)
+        {
+            if (job.clauses[cursor].first != task_id)
+            {
+                imported.push_back(job.clauses[cursor].second);
+            }
+        }
+        for (; job.sent < job.clauses.size(); job.sent++)
+        {
+            if (job.clauses[job.sent].first != 0)
+            {
+                outgoing.push_back(job.clauses[job.sent].second);
+            }
+        }
+    }
+
+    if (!outgoing.empty())
+    {
+        send(MessageType::CLAUSES, encodeClauseBatch(job.id, outgoing));
+    }
+}
+
+void DistributedWorker::send(MessageType type, const std::vector<uint8_t> &payload)
+{
+    std::lock_guard<std::mutex> lock(write_mutex);
+    sendFrame(fd, type, payload);
+}
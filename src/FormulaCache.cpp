@@ -0,0 +1,621 @@
+#include "../include/FormulaCache.h"
+#include <algorithm>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/file.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace
+{
+    // splitmix64 finaliser
+    inline uint64_t mix(uint64_t x)
+    {
+        x += 0x9e3779b97f4a7c15ULL;
+        x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+        x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+        return x ^ (x >> 31);
+    }
+
+    constexpr uint64_t SEED_HI = 0x6a09e667f3bcc908ULL;
+    constexpr uint64_t SEED_LO = 0xbb67ae8584caa73bULL;
+    constexpr uint64_t SALT_POS = 0x3c6ef372fe94f82bULL;
+    constexpr uint64_t SALT_NEG = 0xa54ff53a5f1d36f1ULL;
+
+    // Refinement rounds before a formula counts as symmetric
+    constexpr int MAX_REFINEMENT_ROUNDS = 16;
+
+    // Both 64-bit lanes of a running hash
+    struct Hash128
+    {
+        uint64_t hi = SEED_HI;
+        uint64_t lo = SEED_LO;
+
+        void add(uint64_t value)
+        {
+            hi = mix(hi ^ value);
+            lo = mix(lo + value * 0xff51afd7ed558ccdULL);
+        }
+
+        bool operator<(const Hash128 &other) const { return hi != other.hi ? hi < other.hi : lo < other.lo; }
+        bool operator==(const Hash128 &other) const { return hi == other.hi && lo == other.lo; }
+    };
+
+    inline uint64_t litCode(int lit)
+    {
+        return lit > 0 ? 2 * static_cast<uint64_t>(lit) : 2 * static_cast<uint64_t>(-static_cast<int64_t>(lit)) + 1;
+    }
+
+    // Literals by variable, negative first
+    inline bool literalOrder(int a, int b)
+    {
+        return std::abs(a) != std::abs(b) ? std::abs(a) < std::abs(b) : a < b;
+    }
+
+    struct NormalClause
+    {
+        Clause literals; // Sorted by literalOrder, no duplicates
+        int weight;      // 0 = hard
+
+        bool operator<(const NormalClause &other) const
+        {
+            return weight != other.weight ? weight < other.weight : literals < other.literals;
+        }
+        bool operator==(const NormalClause &other) const
+        {
+            return weight == other.weight && literals == other.literals;
+        }
+    };
+
+    // Sort literals, drop duplicate literals, tautologies and repeated hard clauses
+    std::vector<NormalClause> normalize(const CNF &clauses, const std::vector<int> &weights)
+    {
+        std::vector<NormalClause> normal;
+        normal.reserve(clauses.size());
+        for (size_t i = 0; i < clauses.size(); i++)
+        {
+            NormalClause clause{clauses[i], i < weights.size() ? weights[i] : 0};
+            auto &lits = clause.literals;
+            std::sort(lits.begin(), lits.end(), literalOrder);
+            lits.erase(std::unique(lits.begin(), lits.end()), lits.end());
+
+            bool tautology = false;
+            for (size_t j = 1; j < lits.size() && !tautology; j++)
+            {
+                tautology = lits[j] == -lits[j - 1];
+            }
+            if (!tautology)
+            {
+                normal.push_back(std::move(clause));
+            }
+        }
+
+        // Hard clauses sort first (weight 0); duplicate soft clauses add up and stay
+        std::sort(normal.begin(), normal.end());
+        auto hard_end = std::find_if(normal.begin(), normal.end(), [](const NormalClause &c)
+                                     { return c.weight != 0; });
+        auto unique_end = std::unique(normal.begin(), hard_end);
+        normal.erase(unique_end, hard_end);
+        return normal;
+    }
+
+    // Colour refinement over the variable/clause incidence graph. Returns the
+    // labelling by colour rank when every occurring variable ends up with its
+    // own colour, an empty vector otherwise.
+    std::vector<int> refineLabels(const std::vector<NormalClause> &clauses, const std::vector<int> &assumptions,
+                                  int num_vars)
+    {
+        std::vector<uint64_t> colour(num_vars + 1, 0);
+        std::vector<char> occurs(num_vars + 1, 0);
+        for (int lit : assumptions)
+        {
+            occurs[std::abs(lit)] = 1;
+            colour[std::abs(lit)] |= lit > 0 ? 1 : 2;
+        }
+        for (const auto &clause : clauses)
+        {
+            for (int lit : clause.literals)
+            {
+                occurs[std::abs(lit)] = 1;
+            }
+        }
+
+        std::vector<int> vars;
+        for (int var = 1; var <= num_vars; var++)
+        {
+            if (occurs[var])
+            {
+                vars.push_back(var);
+                colour[var] = mix(colour[var]);
+            }
+        }
+
+        auto countColours = [&]()
+        {
+            std::vector<uint64_t> distinct;
+            distinct.reserve(vars.size());
+            for (int var : vars)
+            {
+                distinct.push_back(colour[var]);
+            }
+            std::sort(distinct.begin(), distinct.end());
+            return static_cast<size_t>(std::unique(distinct.begin(), distinct.end()) - distinct.begin());
+        };
+
+        std::vector<uint64_t> signature(num_vars + 1);
+        size_t colours = countColours();
+        for (int round = 0; round < MAX_REFINEMENT_ROUNDS && colours < vars.size(); round++)
+        {
+            // Clause colour: multiset of its literals' colours, plus weight and size
+            std::fill(signature.begin(), signature.end(), 0);
+            for (const auto &clause : clauses)
+            {
+                uint64_t clause_colour = mix(static_cast<uint64_t>(clause.weight) ^ (clause.literals.size() << 32));
+                for (int lit : clause.literals)
+                {
+                    clause_colour += mix(colour[std::abs(lit)] ^ (lit > 0 ? SALT_POS : SALT_NEG));
+                }
+                clause_colour = mix(clause_colour);
+                for (int lit : clause.literals)
+                {
+                    signature[std::abs(lit)] += mix(clause_colour ^ (lit > 0 ? SALT_POS : SALT_NEG));
+                }
+            }
+
+            // Variable colour: old colour plus the multiset of its clause colours
+            for (int var : vars)
+            {
+                colour[var] = mix(colour[var] ^ mix(signature[var]));
+            }
+
+            size_t refined = countColours();
+            if (refined == colours)
+            {
+                break;
+            }
+            colours = refined;
+        }
+
+        if (colours < vars.size())
+        {
+            return {};
+        }
+
+        std::sort(vars.begin(), vars.end(), [&](int a, int b)
+                  { return colour[a] < colour[b]; });
+        std::vector<int> label_of_var(num_vars + 1, 0);
+        for (size_t i = 0; i < vars.size(); i++)
+        {
+            label_of_var[vars[i]] = static_cast<int>(i) + 1;
+        }
+        return label_of_var;
+    }
+
+    inline int relabel(int lit, const std::vector<int> &label_of_var)
+    {
+        int label = label_of_var[std::abs(lit)];
+        return lit > 0 ? label : -label;
+    }
+
+    // File layout: header, then records of RECORD_HEADER bytes plus 4 bytes
+    // per literal, padded to 8 bytes
+    constexpr char FILE_MAGIC[8] = {'S', 'A', 'T', 'F', 'C', 'A', 'C', '1'};
+    constexpr size_t FILE_HEADER = 16; // Magic, record bytes in use
+    constexpr size_t RECORD_HEADER = 32;
+    constexpr size_t INITIAL_FILE_SIZE = 1 << 20;
+
+    inline size_t recordSize(size_t literals)
+    {
+        return (RECORD_HEADER + 4 * literals + 7) & ~static_cast<size_t>(7);
+    }
+}
+
+FormulaCache::FormulaCache(size_t capacity, bool modulo_renaming)
+    : capacity(capacity),
+      modulo_renaming(modulo_renaming),
+      hits(0),
+      misses(0),
+      fd(-1),
+      mapped(nullptr),
+      mapped_size(0),
+      log_bytes(0),
+      live_bytes(0)
+{
+}
+
+FormulaCache::~FormulaCache()
+{
+    flush();
+    closeFile();
+}
+
+CanonicalFormula FormulaCache::canonicalize(const CNF &clauses, const std::vector<int> &weights,
+                                            const std::vector<int> &assumptions) const
+{
+    CanonicalFormula query;
+    for (const auto &clause : clauses)
+    {
+        for (int lit : clause)
+        {
+            query.num_vars = std::max(query.num_vars, std::abs(lit));
+        }
+    }
+    for (int lit : assumptions)
+    {
+        query.num_vars = std::max(query.num_vars, std::abs(lit));
+    }
+
+    std::vector<NormalClause> normal = normalize(clauses, weights);
+    std::vector<int> assumed = assumptions;
+
+    if (modulo_renaming)
+    {
+        std::vector<int> labels = refineLabels(normal, assumptions, query.num_vars);
+        if (!labels.empty())
+        {
+            query.renamed = true;
+            query.var_of_label.assign(query.num_vars + 1, 0);
+            for (int var = 1; var <= query.num_vars; var++)
+            {
+                if (labels[var] != 0)
+                {
+                    query.var_of_label[labels[var]] = var;
+                }
+            }
+            query.label_of_var = std::move(labels);
+
+            for (auto &clause : normal)
+            {
+                for (int &lit : clause.literals)
+                {
+                    lit = relabel(lit, query.label_of_var);
+                }
+                std::sort(clause.literals.begin(), clause.literals.end(), literalOrder);
+            }
+            for (int &lit : assumed)
+            {
+                lit = relabel(lit, query.label_of_var);
+            }
+        }
+    }
+
+    // Clause hashes sorted, so the key ignores clause order
+    std::vector<Hash128> clause_hashes;
+    clause_hashes.reserve(normal.size());
+    for (const auto &clause : normal)
+    {
+        Hash128 h;
+        h.add(static_cast<uint64_t>(clause.weight));
+        for (int lit : clause.literals)
+        {
+            h.add(litCode(lit));
+        }
+        clause_hashes.push_back(h);
+    }
+    std::sort(clause_hashes.begin(), clause_hashes.end());
+
+    std::sort(assumed.begin(), assumed.end());
+    assumed.erase(std::unique(assumed.begin(), assumed.end()), assumed.end());
+
+    Hash128 key;
+    key.add(weights.empty() ? 1 : 2); // Plain and weighted queries have different answers
+    key.add(clause_hashes.size());
+    for (const auto &h : clause_hashes)
+    {
+        key.add(h.hi);
+        key.add(h.lo);
+    }
+    key.add(assumed.size());
+    for (int lit : assumed)
+    {
+        key.add(litCode(lit));
+    }
+
+    query.key.hi = key.hi;
+    query.key.lo = key.lo;
+    return query;
+}
+
+bool FormulaCache::lookup(const CanonicalFormula &query, CachedResult &result)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    auto it = index.find(query.key);
+    if (it == index.end())
+    {
+        misses++;
+        return false;
+    }
+    hits++;
+    entries.splice(entries.begin(), entries, it->second);
+    const CachedResult &cached = it->second->result;
+
+    // Back from canonical labels to the query's variables
+    auto toVar = [&](int lit)
+    {
+        int label = std::abs(lit);
+        if (label > query.num_vars)
+        {
+            return 0;
+        }
+        int var = query.renamed ? query.var_of_label[label] : label;
+        return lit > 0 ? var : -var;
+    };
+
+    result.sat = cached.sat;
+    result.cost = cached.cost;
+    result.literals.clear();
+    if (cached.sat)
+    {
+        // Full model over 1..num_vars; variables outside the formula are false
+        for (int var = 1; var <= query.num_vars; var++)
+        {
+            result.literals.push_back(-var);
+        }
+        for (int lit : cached.literals)
+        {
+            int mapped_lit = toVar(lit);
+            if (mapped_lit != 0)
+            {
+                result.literals[std::abs(mapped_lit) - 1] = mapped_lit;
+            }
+        }
+    }
+    else
+    {
+        for (int lit : cached.literals)
+        {
+            int mapped_lit = toVar(lit);
+            if (mapped_lit != 0)
+            {
+                result.literals.push_back(mapped_lit);
+            }
+        }
+    }
+    return true;
+}
+
+void FormulaCache::store(const CanonicalFormula &query, const CachedResult &result)
+{
+    if (capacity == 0)
+    {
+        return;
+    }
+
+    Entry entry{query.key, {result.sat, result.cost, {}}};
+    entry.result.literals.reserve(result.literals.size());
+    for (int lit : result.literals)
+    {
+        int var = std::abs(lit);
+        if (var == 0 || var > query.num_vars)
+        {
+            continue;
+        }
+        if (!query.renamed)
+        {
+            entry.result.literals.push_back(lit);
+        }
+        else if (query.label_of_var[var] != 0)
+        {
+            // Variables outside the formula have no label and are dropped
+            entry.result.literals.push_back(relabel(lit, query.label_of_var));
+        }
+    }
+
+    std::lock_guard<std::mutex> lock(mutex);
+    appendRecord(entry);
+    insert(std::move(entry));
+
+    // Dead records dominate the log: rewrite it from the live entries
+    if (fd >= 0 && log_bytes > 2 * live_bytes + INITIAL_FILE_SIZE)
+    {
+        rewriteLog();
+    }
+}
+
+size_t FormulaCache::size()
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    return entries.size();
+}
+
+void FormulaCache::insert(Entry entry)
+{
+    auto existing = index.find(entry.key);
+    if (existing != index.end())
+    {
+        live_bytes -= recordSize(existing->second->result.literals.size());
+        entries.erase(existing->second);
+        index.erase(existing);
+    }
+
+    live_bytes += recordSize(entry.result.literals.size());
+    entries.push_front(std::move(entry));
+    index[entries.front().key] = entries.begin();
+
+    while (entries.size() > capacity)
+    {
+        live_bytes -= recordSize(entries.back().result.literals.size());
+        index.erase(entries.back().key);
+        entries.pop_back();
+    }
+}
+
+bool FormulaCache::open(const std::string &path)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    closeFile();
+
+    fd = ::open(path.c_str(), O_RDWR | O_CREAT, 0644);
+    struct stat info;
+    // One process per cache file
+    if (fd < 0 || flock(fd, LOCK_EX | LOCK_NB) < 0 || fstat(fd, &info) < 0)
+    {
+        closeFile();
+        return false;
+    }
+
+    size_t file_size = static_cast<size_t>(info.st_size);
+    bool fresh = file_size < FILE_HEADER;
+    if (fresh)
+    {
+        file_size = INITIAL_FILE_SIZE;
+        if (ftruncate(fd, file_size) < 0)
+        {
+            closeFile();
+            return false;
+        }
+    }
+
+    void *address = mmap(nullptr, file_size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (address == MAP_FAILED)
+    {
+        closeFile();
+        return false;
+    }
+    mapped = static_cast<uint8_t *>(address);
+    mapped_size = file_size;
+
+    if (fresh || std::memcmp(mapped, FILE_MAGIC, sizeof(FILE_MAGIC)) != 0)
+    {
+        // New or foreign file: start an empty log
+        std::memcpy(mapped, FILE_MAGIC, sizeof(FILE_MAGIC));
+        log_bytes = 0;
+        std::memcpy(mapped + 8, &log_bytes, sizeof(log_bytes));
+        return true;
+    }
+
+    loadLog();
+    return true;
+}
+
+// Replay records oldest first, so the last record of a key wins and the
+// newest entries end up most recently used. Reading stops at the first
+// record that does not fit, which drops a torn final write.
+void FormulaCache::loadLog()
+{
+    uint64_t declared;
+    std::memcpy(&declared, mapped + 8, sizeof(declared));
+    size_t end = std::min<size_t>(declared, mapped_size - FILE_HEADER);
+
+    size_t pos = 0;
+    while (pos + RECORD_HEADER <= end)
+    {
+        const uint8_t *record = mapped + FILE_HEADER + pos;
+        Entry entry;
+        uint32_t count;
+        std::memcpy(&entry.key.hi, record, 8);
+        std::memcpy(&entry.key.lo, record + 8, 8);
+        std::memcpy(&entry.result.cost, record + 16, 8);
+        std::memcpy(&count, record + 24, 4);
+        entry.result.sat = record[28] != 0;
+
+        size_t bytes = recordSize(count);
+        if (count > (end - pos) / 4 || pos + bytes > end)
+        {
+            break;
+        }
+        entry.result.literals.resize(count);
+        std::memcpy(entry.result.literals.data(), record + RECORD_HEADER, 4 * static_cast<size_t>(count));
+
+        insert(std::move(entry));
+        pos += bytes;
+    }
+
+    log_bytes = pos;
+    if (log_bytes > 2 * live_bytes + INITIAL_FILE_SIZE)
+    {
+        rewriteLog();
+    }
+}
+
+// Make room for bytes more record data; on failure the cache carries on in memory
+bool FormulaCache::reserveLog(size_t bytes)
+{
+    size_t needed = FILE_HEADER + log_bytes + bytes;
+    if (needed <= mapped_size)
+    {
+        return true;
+    }
+
+    size_t new_size = std::max(needed, 2 * mapped_size);
+    munmap(mapped, mapped_size);
+    mapped = nullptr;
+    void *address = MAP_FAILED;
+    if (ftruncate(fd, new_size) == 0)
+    {
+        address = mmap(nullptr, new_size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    }
+    if (address == MAP_FAILED)
+    {
+        closeFile();
+        return false;
+    }
+    mapped = static_cast<uint8_t *>(address);
+    mapped_size = new_size;
+    return true;
+}
+
+void FormulaCache::appendRecord(const Entry &entry)
+{
+    uint32_t count = static_cast<uint32_t>(entry.result.literals.size());
+    size_t bytes = recordSize(count);
+    if (fd < 0 || !reserveLog(bytes))
+    {
+        return;
+    }
+
+    uint8_t *record = mapped + FILE_HEADER + log_bytes;
+    std::memset(record, 0, bytes);
+    std::memcpy(record, &entry.key.hi, 8);
+    std::memcpy(record + 8, &entry.key.lo, 8);
+    std::memcpy(record + 16, &entry.result.cost, 8);
+    std::memcpy(record + 24, &count, 4);
+    record[28] = entry.result.sat ? 1 : 0;
+    std::memcpy(record + RECORD_HEADER, entry.result.literals.data(), 4 * static_cast<size_t>(count));
+
+    // The header only covers the record once it is complete
+    log_bytes += bytes;
+    std::memcpy(mapped + 8, &log_bytes, sizeof(log_bytes));
+}
+
+// Rewrite the log with the live entries, least recently used first
+void FormulaCache::rewriteLog()
+{
+    log_bytes = 0;
+    std::memcpy(mapped + 8, &log_bytes, sizeof(log_bytes));
+    for (auto it = entries.rbegin(); it != entries.rend() && fd >= 0; ++it)
+    {
+        appendRecord(*it);
+    }
+}
+
+void FormulaCache::flush()
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    if (fd < 0)
+    {
+        return;
+    }
+    rewriteLog();
+    if (fd >= 0)
+    {
+        msync(mapped, mapped_size, MS_SYNC);
+    }
+}
+
+void FormulaCache::closeFile()
+{
+    if (mapped != nullptr)
+    {
+        munmap(mapped, mapped_size);
+        mapped = nullptr;
+    }
+    if (fd >= 0)
+    {
+        close(fd);
+        fd = -1;
+    }
+    mapped_size = 0;
+    log_bytes = 0;
+}
@@ -3,7 +3,7 @@
 #include <iostream>
 
 HybridMaxSATSolver::HybridMaxSATSolver(const CNF &hard_clauses, bool debug)
-    : hard_clauses(hard_clauses), debug_output(debug), solver_calls(0)
+    : hard_clauses(hard_clauses), debug_output(debug), solver_calls(0), interrupted(false)
 {
     // Initialize with default configuration
     config = Config();
@@ -254,9 +254,12 @@ int HybridMaxSATSolver::solveLinear()
         solver.addSoftClause(soft_clauses[i], weights[i]);
     }
 
+    solver.setTerminateCallback(terminate_callback);
+
     // Solve with linear search
     int result = solver.solve();
     solver_calls += solver.getNumSolverCalls();
+    interrupted = solver.wasInterrupted();
 
     // Store the assignment if successful
     if (result >= 0)
@@ -278,9 +281,12 @@ int HybridMaxSATSolver::solveBinary()
         solver.addSoftClause(soft_clauses[i], weights[i]);
     }
 
+    solver.setTerminateCallback(terminate_callback);
+
     // Solve with binary search
     int result = solver.solveBinarySearch();
     solver_calls += solver.getNumSolverCalls();
+    interrupted = solver.wasInterrupted();
 
     // Store the assignment if successful
     if (result >= 0)
@@ -313,9 +319,12 @@ int HybridMaxSATSolver::solveStratified()
         solver.addSoftClause(soft_clauses[i], weights[i]);
     }
 
+    solver.setTerminateCallback(terminate_callback);
+
     // Solve with stratified approach
     int result = solver.solveStratified();
     solver_calls += solver.getNumSolverCalls();
+    interrupted = solver.wasInterrupted();
 
     // Unable to get assignment directly from WeightedMaxSATSolver,
     // so we need to ensure this implementation can access it
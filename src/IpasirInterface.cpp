@@ -0,0 +1,126 @@
+#include "../include/ipasir.h"
+#include "../include/CDCLSolverIncremental.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <vector>
+
+namespace
+{
+    // State behind one IPASIR handle
+    struct IpasirSolver
+    {
+        CDCLSolverIncremental solver;
+        std::vector<int> assumptions;  // Assumptions for the next solve
+        std::vector<int> failed;       // Failed assumptions of the last UNSAT call
+        std::vector<int> learn_buffer; // 0-terminated copy handed to the learn callback
+
+        IpasirSolver() : solver(CNF(), false)
+        {
+            // IPASIR has no time limit; callers stop the search via ipasir_set_terminate
+            solver.setTimeout(std::chrono::milliseconds::max());
+        }
+    };
+
+    IpasirSolver *unwrap(void *solver)
+    {
+        return static_cast<IpasirSolver *>(solver);
+    }
+}
+
+extern "C"
+{
+    const char *ipasir_signature(void)
+    {
+        return "satsolver-cdcl-incremental";
+    }
+
+    void *ipasir_init(void)
+    {
+        return new IpasirSolver();
+    }
+
+    void ipasir_release(void *solver)
+    {
+        delete unwrap(solver);
+    }
+
+    void ipasir_add(void *solver, int lit_or_zero)
+    {
+        unwrap(solver)->solver.add(lit_or_zero);
+    }
+
+    void ipasir_assume(void *solver, int lit)
+    {
+        unwrap(solver)->assumptions.push_back(lit);
+    }
+
+    int ipasir_solve(void *solver)
+    {
+        IpasirSolver *s = unwrap(solver);
+        bool sat = s->solver.solve(s->assumptions);
+        s->assumptions.clear();
+
+        if (sat)
+        {
+            s->failed.clear();
+            return 10;
+        }
+        if (s->solver.wasInterrupted())
+        {
+            s->failed.clear();
+            return 0;
+        }
+
+        s->failed = s->solver.getUnsatCore();
+        std::sort(s->failed.begin(), s->failed.end());
+        return 20;
+    }
+
+    int ipasir_val(void *solver, int lit)
+    {
+        const auto &model = unwrap(solver)->solver.getAssignments();
+        auto it = model.find(std::abs(lit));
+
+        // Variables the search never touched may take either value
+        if (it == model.end())
+        {
+            return lit;
+        }
+        return (it->second == (lit > 0)) ? lit : -lit;
+    }
+
+    int ipasir_failed(void *solver, int lit)
+    {
+        const auto &failed = unwrap(solver)->failed;
+        return std::binary_search(failed.begin(), failed.end(), lit) ? 1 : 0;
+    }
+
+    void ipasir_set_terminate(void *solver, void *data, int (*terminate)(void *data))
+    {
+        if (terminate == nullptr)
+        {
+            unwrap(solver)->solver.setTerminateCallback(nullptr);
+            return;
+        }
+
+        unwrap(solver)->solver.setTerminateCallback([data, terminate]()
+                                                    { return terminate(data) != 0; });
+    }
+
+    void ipasir_set_learn(void *solver, void *data, int max_length, void (*learn)(void *data, int *clause))
+    {
+        IpasirSolver *s = unwrap(solver);
+        if (learn == nullptr || max_length < 0)
+        {
+            s->solver.setLearnCallback(0, nullptr);
+            return;
+        }
+
+        s->solver.setLearnCallback(static_cast<size_t>(max_length), [s, data, learn](const Clause &clause)
+                                   {
+            s->learn_buffer.assign(clause.begin(), clause.end());
+            s->learn_buffer.push_back(0);
+            learn(data, s->learn_buffer.data()); });
+    }
+}
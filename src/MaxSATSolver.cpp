@@ -8,6 +8,7 @@ MaxSATSolver::MaxSATSolver(const CNF &hard_clauses, bool debug)
       next_var(solver.getNumVars() + 1),
       debug_output(debug),
       solver_calls(0),
+      interrupted(false),
       has_previous_solution(false) // Initialize warm start flag
 {
 }
@@ -17,14 +18,15 @@ void MaxSATSolver::addSoftClause(const Clause &soft_clause, int weight)
     if (soft_clause.empty())
         return;
 
-    // Create a relaxation variable
-    int relax_var = next_var++;
-    solver.newVariable();
-
-    // Add the soft clause with a relaxation variable
-    Clause augmented_clause = soft_clause;
-    augmented_clause.push_back(relax_var);
-    solver.addClause(augmented_clause);
+    // Stream the soft clause, then close it with a fresh relaxation variable
+    for (int lit : soft_clause)
+    {
+        solver.add(lit);
+    }
+    int relax_var = solver.newVariable();
+    next_var = relax_var + 1;
+    solver.add(relax_var);
+    solver.add(0);
 
     // Store the relaxation variable and its weight
     relaxation_vars.push_back(relax_var);
@@ -93,6 +95,7 @@ bool MaxSATSolver::solveWithKRelaxed(int k, std::vector<int> &assumptions)
     bool result = solver.solve(assumptions);
     auto end_time = std::chrono::high_resolution_clock::now();
     auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(end_time - start_time).count();
+    interrupted = !result && solver.wasInterrupted();
 
     // Store solution if SAT
     if (result)
@@ -125,6 +128,7 @@ int MaxSATSolver::solve()
         // No soft clauses, just solve the hard clauses
         solver_calls++;
         bool result = solver.solve();
+        interrupted = !result && solver.wasInterrupted();
         return result ? 0 : -1; // -1 indicates unsatisfiable hard clauses
     }
 
@@ -142,6 +146,10 @@ int MaxSATSolver::solve()
     {
         return 0; // All clauses satisfied
     }
+    if (interrupted)
+    {
+        return -1;
+    }
 
     // Linear search from 1 to number of soft clauses
     for (size_t k = 1; k <= relaxation_vars.size(); k++)
@@ -156,6 +164,10 @@ int MaxSATSolver::solve()
             }
             return k;
         }
+        if (interrupted)
+        {
+            return -1;
+        }
     }
 
     // If we get here, even relaxing all soft clauses didn't help
@@ -178,6 +190,7 @@ int MaxSATSolver::solveBinarySearch()
         // No soft clauses, just solve the hard clauses
         solver_calls++;
         bool result = solver.solve();
+        interrupted = !result && solver.wasInterrupted();
         return result ? 0 : -1; // -1 indicates unsatisfiable hard clauses
     }
 
@@ -195,6 +208,10 @@ int MaxSATSolver::solveBinarySearch()
     {
         return 0; // All clauses satisfied
     }
+    if (interrupted)
+    {
+        return -1;
+    }
 
     // Improved exponential probing to find initial upper bound
     int lower_bound = 1; // We know 0 is unsatisfiable
@@ -215,7 +232,7 @@ int MaxSATSolver::solveBinarySearch()
             std::cout << "Early estimation successful at k = " << early_estimate << std::endl;
         }
     }
-    else
+    else if (!interrupted)
     {
         // Use exponential probing with adaptive step sizes
         while (upper_bound < relaxation_vars.size())
@@ -230,6 +247,10 @@ int MaxSATSolver::solveBinarySearch()
                 // Found a satisfiable point, use this as upper bound
                 break;
             }
+            if (interrupted)
+            {
+                break;
+            }
 
             // Update bounds and increase step size
             lower_bound = upper_bound + 1;
@@ -238,6 +259,11 @@ int MaxSATSolver::solveBinarySearch()
         }
     }
 
+    if (interrupted)
+    {
+        return -1;
+    }
+
     // If we've reached the maximum and it's still UNSAT, try with all variables relaxed
     if (upper_bound == relaxation_vars.size() && !solveWithKRelaxed(upper_bound, assumptions))
     {
@@ -259,6 +285,10 @@ int MaxSATSolver::solveBinarySearch()
             // We can satisfy with mid relaxed clauses, try fewer
             upper_bound = mid;
         }
+        else if (interrupted)
+        {
+            return -1;
+        }
         else
         {
             // Need more relaxed clauses
@@ -280,6 +310,11 @@ int MaxSATSolver::solveBinarySearch()
     return -1; // Indicates unsatisfiable hard clauses
 }
 
+void MaxSATSolver::setTerminateCallback(std::function<bool()> callback)
+{
+    solver.setTerminateCallback(std::move(callback));
+}
+
 std::unordered_map<int, bool> MaxSATSolver::getAssignment() const
 {
     return solver.getAssignments();
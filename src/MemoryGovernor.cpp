@@ -0,0 +1,156 @@
+#include "../include/MemoryGovernor.h"
+#include <algorithm>
+#include <cstdlib>
+#include <fstream>
+#include <string>
+#include <unistd.h>
+
+MemoryGovernor::MemoryGovernor()
+    : MemoryGovernor(Config())
+{
+}
+
+MemoryGovernor::MemoryGovernor(const Config &config)
+    : config(config),
+      limit(config.limit_bytes > 0 ? config.limit_bytes : containerMemoryLimit()),
+      peak_usage(0),
+      shrinks(0),
+      compactions(0),
+      suspensions(0)
+{
+    reset();
+}
+
+void MemoryGovernor::reset()
+{
+    std::fill(std::begin(last_action), std::end(last_action), std::chrono::steady_clock::time_point::min());
+}
+
+MemoryGovernor::Decision MemoryGovernor::check(const std::vector<WorkerUsage> &workers)
+{
+    return check(workers, processResidentBytes());
+}
+
+MemoryGovernor::Decision MemoryGovernor::check(const std::vector<WorkerUsage> &workers, size_t resident_bytes)
+{
+    Decision decision;
+    if (!enabled())
+    {
+        return decision;
+    }
+
+    size_t worker_memory = 0;
+    for (const auto &worker : workers)
+    {
+        worker_memory += worker.memory;
+    }
+    size_t used = std::max(resident_bytes, worker_memory);
+    peak_usage = std::max(peak_usage, used);
+
+    double pressure = static_cast<double>(used) / limit;
+    decision.stage = pressure >= config.suspend_at   ? Stage::SUSPEND
+                     : pressure >= config.compact_at ? Stage::COMPACT
+                     : pressure >= config.shrink_at  ? Stage::SHRINK
+                                                     : Stage::NORMAL;
+    auto now = std::chrono::steady_clock::now();
+
+    // Stage 1: fewer learned clauses from now on
+    if (decision.stage >= Stage::SHRINK && due(Stage::SHRINK, now))
+    {
+        for (size_t i = 0; i < workers.size(); i++)
+        {
+            if (workers[i].active && workers[i].max_learnts > config.min_learnts)
+            {
+                size_t lowered = static_cast<size_t>(workers[i].max_learnts * config.shrink_factor);
+                decision.learnt_limits.emplace_back(static_cast<int>(i), std::max(config.min_learnts, lowered));
+            }
+        }
+        shrinks++;
+    }
+
+    // Stage 2: cut down to the lowered limits now and give the memory back
+    if (decision.stage >= Stage::COMPACT && due(Stage::COMPACT, now))
+    {
+        for (size_t i = 0; i < workers.size(); i++)
+        {
+            if (workers[i].active)
+            {
+                decision.compact.push_back(static_cast<int>(i));
+            }
+        }
+        compactions++;
+    }
+
+    // Stage 3: give up the least promising worker, never the last one
+    if (decision.stage >= Stage::SUSPEND && due(Stage::SUSPEND, now))
+    {
+        int active = 0;
+        for (size_t i = 0; i < workers.size(); i++)
+        {
+            if (!workers[i].active)
+            {
+                continue;
+            }
+            active++;
+            if (decision.suspend < 0 || workers[i].progress < workers[decision.suspend].progress)
+            {
+                decision.suspend = static_cast<int>(i);
+            }
+        }
+        if (active < 2)
+        {
+            decision.suspend = -1;
+        }
+        else
+        {
+            suspensions++;
+        }
+    }
+
+    return decision;
+}
+
+bool MemoryGovernor::due(Stage stage, std::chrono::steady_clock::time_point now)
+{
+    auto &last = last_action[static_cast<int>(stage)];
+    if (last != std::chrono::steady_clock::time_point::min() && now - last < config.cooldown)
+    {
+        return false;
+    }
+    last = now;
+    return true;
+}
+
+size_t MemoryGovernor::processResidentBytes()
+{
+#ifdef __linux__
+    std::ifstream statm("/proc/self/statm");
+    size_t total_pages = 0, resident_pages = 0;
+    if (statm >> total_pages >> resident_pages)
+    {
+        return resident_pages * static_cast<size_t>(sysconf(_SC_PAGESIZE));
+    }
+#endif
+    return 0;
+}
+
+// "max" (v2) and the near-2^63 default of v1 both mean no limit
+size_t MemoryGovernor::containerMemoryLimit()
+{
+    const size_t NO_LIMIT = 1ULL << 60;
+    for (const char *path : {"/sys/fs/cgroup/memory.max", "/sys/fs/cgroup/memory/memory.limit_in_bytes"})
+    {
+        std::ifstream file(path);
+        std::string value;
+        if (!(file >> value) || value == "max")
+        {
+            continue;
+        }
+        size_t bytes = std::strtoull(value.c_str(), nullptr, 10);
+        if (bytes > 0 && bytes < NO_LIMIT)
+        {
+            return bytes;
+        }
+    }
+    return 0;
+}
@@ -1,8 +1,11 @@
 #include "../include/PortfolioManager.h"
+#include "../include/FormulaCache.h"
 #include <iostream>
 #include <algorithm>
 #include <random>
 #include <cmath>
+#include <limits>
+#include <cstdio>
 #include <pthread.h>
 #include <sys/resource.h>
 
@@ -12,14 +15,24 @@ PortfolioManager::PortfolioManager(const CNF &cnf,
                                    int num_threads)
     : formula(cnf),
       solution_found(false),
+      unsat_proven(false),
       global_timeout(false),
+      job_generation(0),
+      job_formula(nullptr),
+      job_stagger(0),
+      pending_solvers(0),
+      job_num_vars(0),
+      shutting_down(false),
+      total_slices(0),
+      slice_conflicts(2000),
       total_memory_used(0),
       max_concurrent_solvers(std::max(1, num_threads)),
       active_solvers(0),
-      initialization_complete(false),
+      job_memory_estimate(0),
       global_timeout_duration(timeout),
       portfolio_start_time(std::chrono::high_resolution_clock::now()),
-      winning_solver_id(-1)
+      winning_solver_id(-1),
+      checkpoint_interval(0)
 {
 
     // Initialize solver configurations
@@ -34,6 +47,8 @@ PortfolioManager::PortfolioManager(const CNF &cnf,
     max_concurrent_solvers = std::min(max_concurrent_solvers, memory_based_max);
 
     // Initialize statistics
+    solver_progress = std::shared_ptr<SolverProgress[]>(new SolverProgress[solver_configs.size()]);
+    solver_control = std::unique_ptr<SolverControl[]>(new SolverControl[solver_configs.size()]);
     solver_statistics.resize(solver_configs.size());
     for (auto &stats : solver_statistics)
     {
@@ -48,14 +63,21 @@ PortfolioManager::PortfolioManager(const CNF &cnf,
 // Destructor
 PortfolioManager::~PortfolioManager()
 {
+    // An asynchronous solve still uses this manager
+    if (async_solve.valid())
+    {
+        async_solve.cancel();
+        async_solve.wait();
+    }
+
     // Ensure termination
     terminateAllSolvers();
 
-    // Join monitor thread if running
-    if (monitor_thread.joinable())
     {
-        monitor_thread.join();
+        std::lock_guard<std::mutex> lock(termination_mutex);
+        shutting_down = true;
     }
+    work_cv.notify_all();
 
     // Join all solver threads
     for (auto &thread : solver_threads)
@@ -70,49 +92,61 @@ PortfolioManager::~PortfolioManager()
 // Initialize diverse solver configurations
 void PortfolioManager::initializeConfigs()
 {
-    // Config 1: Aggressive approach for random 3-SAT
-    solver_configs.push_back({
-        .var_decay = 0.98, // More aggressive decay
-        .use_luby_restarts = true,
-        .restart_threshold = 30,      // Aggressive restarts
-        .random_polarity_freq = 0.15, // High randomization for diversity
-        .use_lbd = true,
-        .use_phase_saving = true,
-        .max_learnt_clauses = 20000 // Aggressive learning
-    });
-
-    // Config 2: Very aggressive for hard instances
-    solver_configs.push_back({
-        .var_decay = 0.98, // Very aggressive decay
-        .use_luby_restarts = true,
-        .restart_threshold = 25,      // Very aggressive restarts
-        .random_polarity_freq = 0.10, // Moderate randomization
-        .use_lbd = true,
-        .use_phase_saving = false,  // No phase saving for diversity
-        .max_learnt_clauses = 25000 // Very aggressive learning
-    });
-
-    // Config 3: Balanced for random 3-SAT
-    solver_configs.push_back({
-        .var_decay = 0.97,            // Balanced decay
-        .use_luby_restarts = false,   // Geometric restarts
-        .restart_threshold = 50,      // Moderate restarts
-        .random_polarity_freq = 0.08, // Light randomization
-        .use_lbd = false,
-        .use_phase_saving = true,   // Keep phase information
-        .max_learnt_clauses = 15000 // Balanced learning
-    });
-
-    // Config 4: Conservative backup
-    solver_configs.push_back({
-        .var_decay = 0.95, // Conservative decay
-        .use_luby_restarts = false,
-        .restart_threshold = 100,     // Conservative restarts
-        .random_polarity_freq = 0.05, // Minimal randomization
-        .use_lbd = false,
-        .use_phase_saving = true,  // Keep phase information
-        .max_learnt_clauses = 8000 // Minimal learning
-    });
+    solver_configs = builtinConfigs();
+}
+
+// The built-in configurations, shared by every manager and the distributed workers
+const std::vector<PortfolioManager::SolverConfig> &PortfolioManager::builtinConfigs()
+{
+    static const std::vector<SolverConfig> configs = []
+    {
+        std::vector<SolverConfig> solver_configs;
+        // Config 1: Aggressive approach for random 3-SAT
+        solver_configs.push_back({
+            .var_decay = 0.98, // More aggressive decay
+            .use_luby_restarts = true,
+            .restart_threshold = 30,      // Aggressive restarts
+            .random_polarity_freq = 0.15, // High randomization for diversity
+            .use_lbd = true,
+            .use_phase_saving = true,
+            .max_learnt_clauses = 20000 // Aggressive learning
+        });
+
+        // Config 2: Very aggressive for hard instances
+        solver_configs.push_back({
+            .var_decay = 0.98, // Very aggressive decay
+            .use_luby_restarts = true,
+            .restart_threshold = 25,      // Very aggressive restarts
+            .random_polarity_freq = 0.10, // Moderate randomization
+            .use_lbd = true,
+            .use_phase_saving = false,  // No phase saving for diversity
+            .max_learnt_clauses = 25000 // Very aggressive learning
+        });
+
+        // Config 3: Balanced for random 3-SAT
+        solver_configs.push_back({
+            .var_decay = 0.97,            // Balanced decay
+            .use_luby_restarts = false,   // Geometric restarts
+            .restart_threshold = 50,      // Moderate restarts
+            .random_polarity_freq = 0.08, // Light randomization
+            .use_lbd = false,
+            .use_phase_saving = true,   // Keep phase information
+            .max_learnt_clauses = 15000 // Balanced learning
+        });
+
+        // Config 4: Conservative backup
+        solver_configs.push_back({
+            .var_decay = 0.95, // Conservative decay
+            .use_luby_restarts = false,
+            .restart_threshold = 100,     // Conservative restarts
+            .random_polarity_freq = 0.05, // Minimal randomization
+            .use_lbd = false,
+            .use_phase_saving = true,  // Keep phase information
+            .max_learnt_clauses = 8000 // Minimal learning
+        });
+        return solver_configs;
+    }();
+    return configs;
 }
 
 // Main solving method
@@ -123,9 +157,35 @@ bool PortfolioManager::solve(const CNF &formula)
         std::lock_guard<std::mutex> lock(result_mutex);
         solution_found = false;
         winning_solver_id = -1;
+        best_solution.clear();
+        for (auto &stats : solver_statistics)
+        {
+            stats = SolverStats{};
+            stats.termination_reason = -1; // Not started
+        }
     }
-    active_solvers = 0;
-    initialization_complete = false;
+    for (size_t i = 0; i < solver_configs.size(); i++)
+    {
+        solver_progress[i].conflicts = 0;
+        solver_progress[i].decisions = 0;
+        solver_progress[i].restarts = 0;
+        solver_progress[i].best_trail = 0;
+        solver_progress[i].memory = 0;
+        solver_control[i].learnt_limit = solver_configs[i].max_learnt_clauses;
+        solver_control[i].compact = false;
+        solver_control[i].suspend = false;
+    }
+    memory_governor.reset();
+    {
+        std::lock_guard<std::mutex> lock(schedule_mutex);
+        configuration_runs.clear();
+        configuration_runs.resize(solver_configs.size());
+        total_slices = 0;
+    }
+    unsat_proven = false;
+    global_timeout = false;
+    portfolio_start_time = std::chrono::high_resolution_clock::now();
+    job_memory_estimate = estimateMemoryUsage(formula);
 
     // Calculate formula ratio
     size_t num_vars = 0;
@@ -137,6 +197,17 @@ bool PortfolioManager::solve(const CNF &formula)
         }
     }
     double ratio = static_cast<double>(formula.size()) / num_vars;
+    job_num_vars = std::max<size_t>(1, num_vars);
+
+    // Checkpoint files are named after the formula, so they never resume another one
+    if (!checkpoint_prefix.empty())
+    {
+        FormulaKey key = FormulaCache(0).canonicalize(formula, {}, {}).key;
+        char hex[33];
+        std::snprintf(hex, sizeof(hex), "%016llx%016llx", static_cast<unsigned long long>(key.hi),
+                      static_cast<unsigned long long>(key.lo));
+        checkpoint_key = hex;
+    }
 
     // Optimized adaptive delay based on ratio
     int base_delay = 0; // Removed base delay
@@ -146,103 +217,303 @@ bool PortfolioManager::solve(const CNF &formula)
         adaptive_delay = static_cast<int>((ratio - 4.0) * 2); // Reduced multiplier from 5 to 2
     }
 
-    // Launch monitor thread first
-    monitor_thread = std::thread(&PortfolioManager::monitorThread, this);
-
-    // Launch solver threads with minimal delay
-    for (size_t i = 0; i < solver_configs.size(); i++)
+    startWorkers();
+
+    // Hand the formula to the parked workers; solver i starts after i delays
+    auto deadline = portfolio_start_time + global_timeout_duration;
+    std::unique_lock<std::mutex> lock(termination_mutex);
+    job_formula = &formula;
+    job_stagger = std::chrono::microseconds(adaptive_delay * 100); // Convert to microseconds
+    pending_solvers = solver_threads.size();
+    active_solvers = static_cast<int>(solver_configs.size());
+    job_generation++;
+    work_cv.notify_all();
+
+    // Sleep until every solver is back or the timeout passes; finishing
+    // solvers and stop() wake this thread. Under a memory limit it also
+    // wakes every governor interval to check memory use.
+    bool finished = false;
+    while (true)
+    {
+        auto wake = deadline;
+        if (memory_governor.enabled())
+        {
+            wake = std::min(deadline, std::chrono::high_resolution_clock::now() + memory_governor.getInterval());
+        }
+        if (termination_cv.wait_until(lock, wake, [this]
+                                      { return pending_solvers == 0; }))
+        {
+            finished = true;
+            break;
+        }
+        if (wake == deadline)
+        {
+            break;
+        }
+        lock.unlock();
+        governMemory();
+        lock.lock();
+    }
+    if (!finished)
     {
-        solver_threads.emplace_back(&PortfolioManager::solverThread, this, i, std::ref(formula));
+        auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::high_resolution_clock::now() - portfolio_start_time);
+        std::cout << "Portfolio timeout reached after " << elapsed.count() << "ms" << std::endl;
+
+        lock.unlock();
+        terminateAllSolvers();
+        lock.lock();
+        termination_cv.wait(lock, [this]
+                            { return pending_solvers == 0; });
+    }
+    job_formula = nullptr;
+    lock.unlock();
 
-        // Minimal delay for higher ratios
-        if (adaptive_delay > 0)
+    // A settled formula needs no resume
+    if (!checkpoint_prefix.empty() && (solution_found || unsat_proven))
+    {
+        for (size_t i = 0; i < solver_configs.size(); i++)
         {
-            std::this_thread::sleep_for(std::chrono::microseconds(adaptive_delay * 100)); // Convert to microseconds
+            std::remove(checkpointPath(i).c_str());
         }
     }
 
-    // Wait for all solver threads to complete
-    for (auto &thread : solver_threads)
+    return solution_found;
+}
+
+SolveHandle PortfolioManager::solveAsync(const CNF &formula)
+{
+    if (async_solve.valid() && !async_solve.done())
+    {
+        SolveHandle busy = SolveHandle::create();
+        busy.complete(SolveStatus::UNKNOWN, {}, {});
+        return busy;
+    }
+
+    SolveHandle handle = SolveHandle::create();
+    std::shared_ptr<SolverProgress[]> progress = solver_progress;
+    size_t count = solver_configs.size();
+    handle.state->poll = [progress, count]()
+    { return sumProgress(progress.get(), count); };
+
+    async_solve = handle;
+    SolveHandle::execute([this, handle, formula]() mutable
+                         {
+        active_async = handle;
+        bool sat = solve(formula);
+        active_async = SolveHandle();
+
+        SolveStatus status = sat ? SolveStatus::SAT : unsat_proven ? SolveStatus::UNSAT : SolveStatus::UNKNOWN;
+        std::unordered_map<int, bool> model;
+        if (sat)
+        {
+            std::lock_guard<std::mutex> lock(result_mutex);
+            model = best_solution;
+        }
+        handle.complete(status, std::move(model), {}); });
+    return handle;
+}
+
+SolveProgress PortfolioManager::getProgress() const
+{
+    return sumProgress(solver_progress.get(), solver_configs.size());
+}
+
+SolveProgress PortfolioManager::sumProgress(const SolverProgress *progress, size_t count)
+{
+    SolveProgress total;
+    for (size_t i = 0; i < count; i++)
     {
-        thread.join();
+        total.conflicts += progress[i].conflicts.load(std::memory_order_relaxed);
+        total.decisions += progress[i].decisions.load(std::memory_order_relaxed);
+        total.restarts += progress[i].restarts.load(std::memory_order_relaxed);
+        total.best_trail = std::max(total.best_trail, progress[i].best_trail.load(std::memory_order_relaxed));
     }
+    return total;
+}
 
-    // Signal monitor thread to exit and wait for it
+void PortfolioManager::startWorkers()
+{
+    if (!solver_threads.empty())
     {
-        std::lock_guard<std::mutex> lock(result_mutex);
-        active_solvers = 0;
+        return;
     }
-    if (monitor_thread.joinable())
+    size_t num_workers = std::min(solver_configs.size(), static_cast<size_t>(max_concurrent_solvers));
+    solver_threads.reserve(num_workers);
+    for (size_t i = 0; i < num_workers; i++)
     {
-        monitor_thread.join();
+        solver_threads.emplace_back(&PortfolioManager::workerLoop, this);
     }
+}
 
-    // Clear thread vectors
-    solver_threads.clear();
-    monitor_thread = std::thread();
+// Persistent worker: sleeps on work_cv between solves, so an idle portfolio
+// costs no CPU and a new solve costs no thread creation
+void PortfolioManager::workerLoop()
+{
+    // Set process priority
+    setpriority(PRIO_PROCESS, 0, -10); // High priority
 
-    return solution_found;
+    size_t seen_generation = 0;
+    std::unique_lock<std::mutex> lock(termination_mutex);
+    while (true)
+    {
+        work_cv.wait(lock, [&]
+                     { return shutting_down || job_generation != seen_generation; });
+        if (shutting_down)
+        {
+            return;
+        }
+        seen_generation = job_generation;
+        const CNF &job = *job_formula;
+        lock.unlock();
+
+        // Take configurations, or slices of them, until none is left
+        for (int solver_id = claimConfiguration(); solver_id >= 0; solver_id = claimConfiguration())
+        {
+            runSlice(solver_id, job);
+        }
+
+        lock.lock();
+        if (--pending_solvers == 0)
+        {
+            termination_cv.notify_all();
+        }
+    }
 }
 
-// Individual solver thread
-void PortfolioManager::solverThread(int solver_id, const CNF &formula)
+// UCB1 over the configurations: mean slice reward plus an exploration bonus
+// that grows for configurations left waiting. Configurations that never ran
+// go first, in order. Once the formula is settled only started configurations
+// are handed out, so they can wind down and report.
+int PortfolioManager::claimConfiguration()
 {
+    std::lock_guard<std::mutex> lock(schedule_mutex);
+    bool terminating = shouldTerminate();
+    int best = -1;
+    double best_score = 0.0;
+    for (size_t i = 0; i < configuration_runs.size(); i++)
+    {
+        const ConfigurationRun &run = configuration_runs[i];
+        if (run.claimed || run.finished || (terminating && !run.solver))
+        {
+            continue;
+        }
+        if (solver_control[i].suspend && run.solver)
+        {
+            best = static_cast<int>(i); // Suspended by the memory governor: wind it down first
+            break;
+        }
+        double score = std::numeric_limits<double>::infinity();
+        if (run.slices > 0)
+        {
+            score = run.total_reward / run.slices +
+                    UCB_EXPLORATION * std::sqrt(std::log(static_cast<double>(total_slices)) / run.slices);
+        }
+        if (best < 0 || score > best_score)
+        {
+            best = static_cast<int>(i);
+            best_score = score;
+        }
+    }
+    if (best >= 0)
+    {
+        configuration_runs[best].claimed = true;
+    }
+    return best;
+}
+
+// Start or resume one configuration. Without time slicing the slice is the
+// whole solve. A slice that ends early is rewarded with how much it extended
+// the longest partial assignment of the solve, as a fraction of the variables,
+// so a configuration that has stalled stops scoring on its earlier progress.
+void PortfolioManager::runSlice(int solver_id, const CNF &formula)
+{
+    ConfigurationRun &run = configuration_runs[solver_id];
+    bool sliced = solver_configs.size() > solver_threads.size();
     try
     {
-        // Set process priority
-        setpriority(PRIO_PROCESS, 0, -10); // High priority
+        if (!run.solver)
+        {
+            // Minimal delay for higher ratios
+            auto delay = job_stagger * solver_id;
+            if (!sliced && delay.count() > 0 && !shouldTerminate())
+            {
+                std::this_thread::sleep_for(delay);
+            }
 
-        // Create solver instance
-        CDCLSolverIncremental solver(formula, false, this);
+            // Create solver instance
+            run.solver = std::make_unique<CDCLSolverIncremental>(formula, false, this);
+            CDCLSolverIncremental &solver = *run.solver;
+
+            // Apply configuration
+            configureSolver(solver, solver_id);
+
+            // Publish live counters; an async caller's cancel() stops the solver
+            // and the memory governor's instructions are handed over on this
+            // thread, to be carried out at the solver's next restart
+            SolverProgress &progress = solver_progress[solver_id];
+            SolverControl &control = solver_control[solver_id];
+            size_t applied_limit = solver_configs[solver_id].max_learnt_clauses;
+            solver.setTerminateCallback([this, &solver, &progress, &control, applied_limit]() mutable
+                                        {
+                SolveProgress current = solver.getProgress();
+                progress.conflicts.store(current.conflicts, std::memory_order_relaxed);
+                progress.decisions.store(current.decisions, std::memory_order_relaxed);
+                progress.restarts.store(current.restarts, std::memory_order_relaxed);
+                progress.best_trail.store(current.best_trail, std::memory_order_relaxed);
+                progress.memory.store(solver.getMemoryUsage(), std::memory_order_relaxed);
+
+                size_t limit = control.learnt_limit.load(std::memory_order_relaxed);
+                if (limit != applied_limit)
+                {
+                    solver.requestMaxLearnts(limit);
+                    applied_limit = limit;
+                }
+                if (control.compact.load(std::memory_order_relaxed) && control.compact.exchange(false))
+                {
+                    solver.requestCompaction();
+                }
+                return active_async.cancelRequested() || control.suspend.load(std::memory_order_relaxed); });
+
+            // Pick up where this configuration's last run on the formula stopped
+            if (!checkpoint_prefix.empty())
+            {
+                std::string path = checkpointPath(solver_id);
+                if (solver.loadCheckpoint(path))
+                {
+                    std::cout << "    Solver " << solver_id << " resumed from " << path
+                              << " after " << solver.getConflicts() << " conflicts\n";
+                }
+                solver.setCheckpointing(path, checkpoint_interval);
+            }
 
-        // Apply configuration
-        configureSolver(solver, solver_id);
+            run.task = solver.solveSliced({}, sliced ? slice_conflicts : 0, 0, true);
+        }
 
         // Start timing
         auto start = std::chrono::high_resolution_clock::now();
+        int trail_before = run.solver->getProgress().best_trail;
 
         // Solve
-        bool result = solver.solve();
+        bool done = run.task.resume();
 
         // End timing
-        auto end = std::chrono::high_resolution_clock::now();
-        auto solve_time = std::chrono::duration_cast<std::chrono::microseconds>(end - start);
-
-        // Print result
-        std::cout << "    Solver " << solver_id << " completed with result: "
-                  << (result ? "SAT" : "UNSAT")
-                  << " in " << solve_time.count() << "µs"
-                  << " (conflicts: " << solver.getConflicts()
-                  << ", decisions: " << solver.getDecisions()
-                  << ", restarts: " << solver.getRestarts() << ")\n";
-
-        bool need_termination = false;
-        // Record result if solution found
-        if (result)
+        run.solve_time += std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::high_resolution_clock::now() - start);
+
+        if (!done)
         {
-            std::lock_guard<std::mutex> lock(result_mutex);
-            if (!solution_found)
-            {
-                solution_found = true;
-                best_solution = solver.getAssignments();
-                winning_solver_id = solver_id;
-                solver_statistics[solver_id].termination_reason = 0; // Solution found
-                need_termination = true;
-            }
+            int trail_gain = run.solver->getProgress().best_trail - trail_before;
+            double reward = static_cast<double>(std::max(trail_gain, 0)) / job_num_vars;
+            std::lock_guard<std::mutex> lock(schedule_mutex);
+            run.slices++;
+            run.total_reward += reward;
+            total_slices++;
+            run.claimed = false;
+            return;
         }
 
-        // Call terminate outside the lock to prevent potential deadlock
-        if (need_termination)
-            terminateAllSolvers();
-
-        // Record statistics with the actual solver time
-        recordStatistics(solver_id, solver, solve_time);
-
-        // Decrement active solvers count using atomic directly
-        active_solvers.fetch_sub(1);
-
-        // Notify others of available resources
-        resource_cv.notify_all();
+        finishConfiguration(solver_id, *run.solver, run.task.result());
     }
     catch (const std::exception &e)
     {
@@ -256,49 +527,177 @@ void PortfolioManager::solverThread(int solver_id, const CNF &formula)
         std::lock_guard<std::mutex> lock(result_mutex);
         solver_statistics[solver_id].termination_reason = 2; // Resource limit
     }
+
+    // The configuration is done: free its solver before the next one starts
+    run.task = SolveTask();
+    run.solver.reset();
+    solver_progress[solver_id].memory = 0;
+    std::lock_guard<std::mutex> lock(schedule_mutex);
+    run.finished = true;
+    run.claimed = false;
 }
 
-// Monitor thread for timeouts and resource management
-void PortfolioManager::monitorThread()
+void PortfolioManager::governMemory()
 {
-    while (!solution_found && !global_timeout)
+    std::vector<MemoryGovernor::WorkerUsage> usage(solver_configs.size());
     {
-        // Check global timeout
-        auto current_time = std::chrono::high_resolution_clock::now();
-        auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(
-            current_time - portfolio_start_time);
-
-        if (elapsed >= global_timeout_duration)
+        std::lock_guard<std::mutex> lock(schedule_mutex);
+        for (size_t i = 0; i < usage.size(); i++)
         {
-            std::cout << "Portfolio timeout reached after " << elapsed.count() << "ms" << std::endl;
-            global_timeout = true;
-            terminateAllSolvers();
-            break;
+            usage[i].memory = solver_progress[i].memory.load(std::memory_order_relaxed);
+            usage[i].active = !configuration_runs[i].finished && usage[i].memory > 0 && !solver_control[i].suspend;
+            usage[i].max_learnts = solver_control[i].learnt_limit;
+            usage[i].progress = static_cast<double>(solver_progress[i].best_trail) / job_num_vars;
         }
+    }
+
+    MemoryGovernor::Decision decision = memory_governor.check(usage);
+    for (const auto &[solver_id, limit] : decision.learnt_limits)
+    {
+        solver_control[solver_id].learnt_limit = limit;
+    }
+    for (int solver_id : decision.compact)
+    {
+        solver_control[solver_id].compact = true;
+    }
+    if (decision.suspend >= 0)
+    {
+        std::cout << "    Memory pressure: suspending solver " << decision.suspend << "\n";
+        solver_control[decision.suspend].suspend = true;
+    }
+}
 
-        // Only check for completion if initialization is done
-        if (initialization_complete && active_solvers.load() == 0)
+void PortfolioManager::finishConfiguration(int solver_id, CDCLSolverIncremental &solver, bool result)
+{
+    const ConfigurationRun &run = configuration_runs[solver_id];
+
+    // Print result
+    std::cout << "    Solver " << solver_id << " completed with result: "
+              << (result ? "SAT" : solver.wasInterrupted() ? "STOPPED" : "UNSAT")
+              << " in " << run.solve_time.count() << "µs"
+              << " (conflicts: " << solver.getConflicts()
+              << ", decisions: " << solver.getDecisions()
+              << ", restarts: " << solver.getRestarts();
+    if (run.slices > 0)
+    {
+        std::cout << ", slices: " << run.slices + 1;
+    }
+    std::cout << ")\n";
+
+    bool need_termination = false;
+    // Record result if solution found
+    if (result)
+    {
+        std::lock_guard<std::mutex> lock(result_mutex);
+        if (!solution_found)
         {
-            std::cout << "All solvers completed, exiting monitor thread" << std::endl;
-            break;
+            solution_found = true;
+            best_solution = solver.getAssignments();
+            winning_solver_id = solver_id;
+            solver_statistics[solver_id].termination_reason = 0; // Solution found
+            need_termination = true;
         }
+    }
+
+    // A refutation that was not cut short settles the formula as well
+    if (!result && !solver.wasInterrupted() && !unsat_proven.exchange(true))
+    {
+        std::lock_guard<std::mutex> lock(result_mutex);
+        winning_solver_id = solver_id;
+        solver_statistics[solver_id].termination_reason = 0;
+        need_termination = true;
+    }
+
+    // Call terminate outside the lock to prevent potential deadlock
+    if (need_termination)
+        terminateAllSolvers();
 
-        // Mark initialization as complete after a very short delay
-        if (!initialization_complete && elapsed > std::chrono::milliseconds(1))
-        { // Reduced from 10ms to 1ms
-            initialization_complete = true;
+    // Record statistics with the actual solver time
+    recordStatistics(solver_id, solver, run.solve_time);
+    {
+        std::lock_guard<std::mutex> lock(result_mutex);
+        SolverStats &stats = solver_statistics[solver_id];
+        stats.time_slices = run.slices + 1;
+
+        // Stopped without an answer: by the portfolio, or by its own time limit
+        if (stats.termination_reason < 0 && solver.wasInterrupted())
+        {
+            stats.termination_reason = solver_control[solver_id].suspend ? 2 : shouldTerminate() ? 3 : 1;
         }
+    }
+
+    // Decrement active solvers count using atomic directly
+    active_solvers.fetch_sub(1);
+
+    // Notify others of available resources
+    resource_cv.notify_all();
+}
+
+void PortfolioManager::setCheckpointing(const std::string &prefix, std::chrono::milliseconds interval)
+{
+    checkpoint_prefix = prefix;
+    checkpoint_interval = interval;
+}
 
-        // Reduce CPU usage
-        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+std::string PortfolioManager::checkpointPath(int solver_id) const
+{
+    return checkpoint_prefix + "." + checkpoint_key + "." + std::to_string(solver_id);
+}
+
+void PortfolioManager::setNumConfigurations(int count)
+{
+    solver_configs.clear();
+    for (int i = 0; i < std::max(1, count); i++)
+    {
+        solver_configs.push_back(configurationVariant(i));
+    }
+
+    // Async handles keep the old counters alive
+    solver_progress = std::shared_ptr<SolverProgress[]>(new SolverProgress[solver_configs.size()]);
+    solver_control = std::unique_ptr<SolverControl[]>(new SolverControl[solver_configs.size()]);
+    solver_statistics.assign(solver_configs.size(), SolverStats{});
+    for (auto &stats : solver_statistics)
+    {
+        stats.termination_reason = -1; // Not started
     }
 }
 
+void PortfolioManager::setSliceConflicts(int conflicts)
+{
+    slice_conflicts = std::max(1, conflicts);
+}
+
+// Round r over the built-in set restarts r + 1 times slower and randomizes
+// polarities more, so repeated configurations still search differently
+PortfolioManager::SolverConfig PortfolioManager::configurationVariant(int config_id)
+{
+    const auto &configs = builtinConfigs();
+    int round = config_id / static_cast<int>(configs.size());
+    SolverConfig config = configs[config_id % configs.size()];
+    config.restart_threshold *= round + 1;
+    config.random_polarity_freq = std::min(0.3, config.random_polarity_freq * (1.0 + 0.5 * round));
+    return config;
+}
+
 // Configure an individual solver instance
 void PortfolioManager::configureSolver(CDCLSolverIncremental &solver, int config_id)
 {
-    const auto &config = solver_configs[config_id];
+    applyConfig(solver, solver_configs[config_id]);
+}
+
+int PortfolioManager::numConfigurations()
+{
+    return static_cast<int>(builtinConfigs().size());
+}
+
+void PortfolioManager::applyConfiguration(CDCLSolverIncremental &solver, int config_id)
+{
+    const auto &configs = builtinConfigs();
+    applyConfig(solver, configs[static_cast<size_t>(config_id) % configs.size()]);
+}
 
+void PortfolioManager::applyConfig(CDCLSolverIncremental &solver, const SolverConfig &config)
+{
     // Apply configuration to solver
     solver.setVarDecay(config.var_decay);
     solver.setRestartStrategy(config.use_luby_restarts, config.restart_threshold);
@@ -343,7 +742,7 @@ void PortfolioManager::releaseResources()
 // Termination control
 bool PortfolioManager::shouldTerminate() const
 {
-    return solution_found || global_timeout;
+    return solution_found || unsat_proven || global_timeout;
 }
 
 void PortfolioManager::terminateAllSolvers()
@@ -370,7 +769,7 @@ void PortfolioManager::recordStatistics(int solver_id, const CDCLSolverIncrement
     stats.max_decision_level = solver.getMaxDecisionLevel();
     stats.learned_clauses = solver.getNumLearnts();
     stats.solve_time = solve_time;
-    stats.peak_memory_usage = estimateMemoryUsage(formula);
+    stats.peak_memory_usage = job_memory_estimate;
     stats.termination_reason = solver_statistics[solver_id].termination_reason;
 
     solver_statistics[solver_id] = stats;
@@ -430,6 +829,7 @@ void PortfolioManager::setMaxMemoryUsage(size_t max_memory_mb)
     size_t max_memory_bytes = max_memory_mb * 1024 * 1024;
     size_t memory_per_solver = estimateMemoryUsage(formula);
     max_concurrent_solvers = std::max(1, static_cast<int>(max_memory_bytes / memory_per_solver));
+    memory_governor.setLimit(max_memory_bytes);
 }
 
 // Statistics reporting
@@ -463,6 +863,10 @@ void PortfolioManager::printStatistics() const
             std::cout << "    Max Decision Level: " << stats.max_decision_level << "\n";
             std::cout << "    Learned Clauses: " << stats.learned_clauses << "\n";
             std::cout << "    Solve Time: " << stats.solve_time.count() << "µs\n";
+            if (stats.time_slices > 1)
+            {
+                std::cout << "    Time Slices: " << stats.time_slices << "\n";
+            }
             std::cout << "    Peak Memory: " << (stats.peak_memory_usage / (1024 * 1024)) << "MB\n";
 
             std::string termination;
@@ -506,7 +910,18 @@ void PortfolioManager::printStatistics() const
     std::cout << "  Total Runtime: " << total_time.count() << "µs\n";
     std::cout << "  Solver Configurations: " << solver_configs.size() << "\n";
     std::cout << "  Max Concurrent Solvers: " << max_concurrent_solvers << "\n";
-    std::cout << "  Result: " << (solution_found ? "SATISFIABLE" : "UNSATISFIABLE") << "\n";
+    if (solver_configs.size() > solver_threads.size() && !solver_threads.empty())
+    {
+        std::cout << "  Time Slices: " << total_slices << " over " << solver_threads.size() << " workers\n";
+    }
+    if (memory_governor.enabled())
+    {
+        std::cout << "  Memory Limit: " << (memory_governor.getLimit() / (1024 * 1024)) << "MB, peak "
+                  << (memory_governor.getPeakUsage() / (1024 * 1024)) << "MB ("
+                  << memory_governor.getShrinks() << " shrinks, " << memory_governor.getCompactions()
+                  << " compactions, " << memory_governor.getSuspensions() << " suspensions)\n";
+    }
+    std::cout << "  Result: " << (solution_found ? "SATISFIABLE" : unsat_proven ? "UNSATISFIABLE" : "UNKNOWN") << "\n";
 
     if (solution_found)
     {
@@ -0,0 +1,137 @@
+#include "../include/SolveHandle.h"
+#include "../include/ThreadPool.h"
+#include <algorithm>
+#include <thread>
+
+namespace
+{
+    // Never destroyed: a solve still queued at exit must not run against
+    // objects that are already gone, so the threads simply end with the process
+    ThreadPool &executor()
+    {
+        static ThreadPool *pool = new ThreadPool(SolveHandle::solveExecutorThreads());
+        return *pool;
+    }
+}
+
+// At least two, so a long portfolio solve cannot hold up every other query
+size_t SolveHandle::solveExecutorThreads()
+{
+    return std::max(2u, std::thread::hardware_concurrency());
+}
+
+SolveHandle SolveHandle::create()
+{
+    SolveHandle handle;
+    handle.state = std::make_shared<State>();
+    return handle;
+}
+
+void SolveHandle::execute(std::function<void()> task)
+{
+    executor().submit(std::move(task));
+}
+
+SolveStatus SolveHandle::status() const
+{
+    if (!state)
+    {
+        return SolveStatus::UNKNOWN;
+    }
+    std::lock_guard<std::mutex> lock(state->mutex);
+    return state->status;
+}
+
+SolveStatus SolveHandle::wait() const
+{
+    if (!state)
+    {
+        return SolveStatus::UNKNOWN;
+    }
+    std::unique_lock<std::mutex> lock(state->mutex);
+    state->done_cv.wait(lock, [this]
+                        { return state->status != SolveStatus::RUNNING; });
+    return state->status;
+}
+
+SolveStatus SolveHandle::waitFor(std::chrono::milliseconds timeout) const
+{
+    if (!state)
+    {
+        return SolveStatus::UNKNOWN;
+    }
+    std::unique_lock<std::mutex> lock(state->mutex);
+    state->done_cv.wait_for(lock, timeout, [this]
+                            { return state->status != SolveStatus::RUNNING; });
+    return state->status;
+}
+
+void SolveHandle::cancel()
+{
+    if (state)
+    {
+        state->cancelled = true;
+    }
+}
+
+SolveProgress SolveHandle::progress() const
+{
+    SolveProgress progress;
+    if (!state)
+    {
+        return progress;
+    }
+    if (state->poll)
+    {
+        return state->poll();
+    }
+    progress.conflicts = state->conflicts.load(std::memory_order_relaxed);
+    progress.decisions = state->decisions.load(std::memory_order_relaxed);
+    progress.restarts = state->restarts.load(std::memory_order_relaxed);
+    progress.best_trail = state->best_trail.load(std::memory_order_relaxed);
+    return progress;
+}
+
+void SolveHandle::onComplete(Callback callback)
+{
+    if (!state)
+    {
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> lock(state->mutex);
+        if (state->status == SolveStatus::RUNNING)
+        {
+            state->callbacks.push_back(std::move(callback));
+            return;
+        }
+    }
+    callback(*this);
+}
+
+void SolveHandle::publish(const SolveProgress &progress)
+{
+    state->conflicts.store(progress.conflicts, std::memory_order_relaxed);
+    state->decisions.store(progress.decisions, std::memory_order_relaxed);
+    state->restarts.store(progress.restarts, std::memory_order_relaxed);
+    state->best_trail.store(progress.best_trail, std::memory_order_relaxed);
+}
+
+// Waiters wake before the callbacks run; callbacks registered from here on run immediately
+void SolveHandle::complete(SolveStatus status, std::unordered_map<int, bool> model, std::vector<int> core)
+{
+    std::vector<Callback> callbacks;
+    {
+        std::lock_guard<std::mutex> lock(state->mutex);
+        state->model = std::move(model);
+        state->core = std::move(core);
+        state->status = status;
+        callbacks.swap(state->callbacks);
+    }
+    state->done_cv.notify_all();
+
+    for (auto &callback : callbacks)
+    {
+        callback(*this);
+    }
+}
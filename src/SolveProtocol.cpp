@@ -0,0 +1,422 @@
+#include "../include/SolveProtocol.h"
+#include <algorithm>
+#include <cerrno>
+#include <limits>
+#include <sys/socket.h>
+#include <unistd.h>
+
+void MessageWriter::putUnsigned(uint64_t value)
+{
+    while (value >= 0x80)
+    {
+        buffer.push_back(static_cast<uint8_t>(value) | 0x80);
+        value >>= 7;
+    }
+    buffer.push_back(static_cast<uint8_t>(value));
+}
+
+void MessageWriter::putSigned(int64_t value)
+{
+    // Zigzag: 0, -1, 1, -2, ... map to 0, 1, 2, 3, ...
+    putUnsigned((static_cast<uint64_t>(value) << 1) ^ static_cast<uint64_t>(value >> 63));
+}
+
+void MessageWriter::putClauses(const CNF &clauses)
+{
+    putUnsigned(clauses.size());
+    for (const auto &clause : clauses)
+    {
+        for (int lit : clause)
+        {
+            putSigned(lit);
+        }
+        putSigned(0);
+    }
+}
+
+bool MessageReader::getByte(uint8_t &value)
+{
+    if (pos >= data.size())
+    {
+        return false;
+    }
+    value = data[pos++];
+    return true;
+}
+
+bool MessageReader::getUnsigned(uint64_t &value)
+{
+    value = 0;
+    for (int shift = 0; shift < 64; shift += 7)
+    {
+        uint8_t byte;
+        if (!getByte(byte))
+        {
+            return false;
+        }
+        value |= static_cast<uint64_t>(byte & 0x7f) << shift;
+        if ((byte & 0x80) == 0)
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+bool MessageReader::getSigned(int64_t &value)
+{
+    uint64_t raw;
+    if (!getUnsigned(raw))
+    {
+        return false;
+    }
+    value = static_cast<int64_t>(raw >> 1) ^ -static_cast<int64_t>(raw & 1);
+    return true;
+}
+
+bool MessageReader::getClauses(CNF &clauses)
+{
+    uint64_t count;
+    // Every clause takes at least its terminating byte
+    if (!getUnsigned(count) || count > data.size() - pos)
+    {
+        return false;
+    }
+
+    clauses.assign(count, Clause());
+    for (auto &clause : clauses)
+    {
+        int64_t lit;
+        while (true)
+        {
+            if (!getSigned(lit) || lit > std::numeric_limits<int>::max() || lit < -std::numeric_limits<int>::max())
+            {
+                return false;
+            }
+            if (lit == 0)
+            {
+                break;
+            }
+            clause.push_back(static_cast<int>(lit));
+        }
+    }
+    return true;
+}
+
+std::vector<uint8_t> encodeJobRequest(const JobRequest &request)
+{
+    MessageWriter out;
+    out.putUnsigned(request.id);
+    out.putByte(static_cast<uint8_t>(request.kind));
+    out.putByte(request.flags);
+    out.putUnsigned(request.timeout_ms);
+    out.putClauses(request.clauses);
+    if (request.kind == JobKind::WCNF)
+    {
+        for (size_t i = 0; i < request.clauses.size(); i++)
+        {
+            out.putSigned(i < request.weights.size() ? request.weights[i] : 0);
+        }
+    }
+    out.putUnsigned(request.assumptions.size());
+    for (int lit : request.assumptions)
+    {
+        out.putSigned(lit);
+    }
+    return out.data();
+}
+
+bool decodeJobRequest(const std::vector<uint8_t> &payload, JobRequest &request)
+{
+    MessageReader in(payload);
+    uint8_t kind;
+    uint64_t timeout, count;
+    if (!in.getUnsigned(request.id) || !in.getByte(kind) || !in.getByte(request.flags) ||
+        !in.getUnsigned(timeout) || timeout > std::numeric_limits<uint32_t>::max() ||
+        kind > static_cast<uint8_t>(JobKind::WCNF) || !in.getClauses(request.clauses))
+    {
+        return false;
+    }
+    request.kind = static_cast<JobKind>(kind);
+    request.timeout_ms = static_cast<uint32_t>(timeout);
+
+    request.weights.clear();
+    if (request.kind == JobKind::WCNF)
+    {
+        request.weights.reserve(request.clauses.size());
+        for (size_t i = 0; i < request.clauses.size(); i++)
+        {
+            int64_t weight;
+            if (!in.getSigned(weight) || weight < 0 || weight > std::numeric_limits<int>::max())
+            {
+                return false;
+            }
+            request.weights.push_back(static_cast<int>(weight));
+        }
+    }
+
+    if (!in.getUnsigned(count) || count > payload.size())
+    {
+        return false;
+    }
+    request.assumptions.clear();
+    for (uint64_t i = 0; i < count; i++)
+    {
+        int64_t lit;
+        if (!in.getSigned(lit) || lit == 0 || lit > std::numeric_limits<int>::max() ||
+            lit < -std::numeric_limits<int>::max())
+        {
+            return false;
+        }
+        request.assumptions.push_back(static_cast<int>(lit));
+    }
+    return in.atEnd();
+}
+
+std::vector<uint8_t> encodeJobResult(const JobResult &result)
+{
+    MessageWriter out;
+    out.putUnsigned(result.id);
+    out.putByte(static_cast<uint8_t>(result.status));
+    out.putSigned(result.cost);
+    out.putUnsigned(result.literals.size());
+    for (int lit : result.literals)
+    {
+        out.putSigned(lit);
+    }
+    return out.data();
+}
+
+bool decodeJobResult(const std::vector<uint8_t> &payload, JobResult &result)
+{
+    MessageReader in(payload);
+    uint8_t status;
+    uint64_t count;
+    if (!in.getUnsigned(result.id) || !in.getByte(status) || status > static_cast<uint8_t>(JobStatus::ERROR) ||
+        !in.getSigned(result.cost) || !in.getUnsigned(count) || count > payload.size())
+    {
+        return false;
+    }
+    result.status = static_cast<JobStatus>(status);
+
+    result.literals.clear();
+    for (uint64_t i = 0; i < count; i++)
+    {
+        int64_t lit;
+        if (!in.getSigned(lit))
+        {
+            return false;
+        }
+        result.literals.push_back(static_cast<int>(lit));
+    }
+    return in.atEnd();
+}
+
+std::vector<uint8_t> encodeCancel(uint64_t id)
+{
+    MessageWriter out;
+    out.putUnsigned(id);
+    return out.data();
+}
+
+bool decodeCancel(const std::vector<uint8_t> &payload, uint64_t &id)
+{
+    MessageReader in(payload);
+    return in.getUnsigned(id) && in.atEnd();
+}
+
+std::vector<uint8_t> encodeHello(uint32_t slots)
+{
+    MessageWriter out;
+    out.putUnsigned(slots);
+    return out.data();
+}
+
+bool decodeHello(const std::vector<uint8_t> &payload, uint32_t &slots)
+{
+    MessageReader in(payload);
+    uint64_t value;
+    if (!in.getUnsigned(value) || value == 0 || value > std::numeric_limits<uint32_t>::max())
+    {
+        return false;
+    }
+    slots = static_cast<uint32_t>(value);
+    return in.atEnd();
+}
+
+std::vector<uint8_t> encodeFormula(const DistributedFormula &formula)
+{
+    MessageWriter out;
+    out.putUnsigned(formula.job_id);
+    out.putUnsigned(formula.share_max_length);
+    out.putClauses(formula.clauses);
+    return out.data();
+}
+
+bool decodeFormula(const std::vector<uint8_t> &payload, DistributedFormula &formula)
+{
+    MessageReader in(payload);
+    uint64_t length;
+    if (!in.getUnsigned(formula.job_id) || !in.getUnsigned(length) ||
+        length > std::numeric_limits<uint32_t>::max() || !in.getClauses(formula.clauses))
+    {
+        return false;
+    }
+    formula.share_max_length = static_cast<uint32_t>(length);
+    return in.atEnd();
+}
+
+std::vector<uint8_t> encodeTask(const DistributedTask &task)
+{
+    MessageWriter out;
+    out.putUnsigned(task.id);
+    out.putUnsigned(task.config);
+    out.putUnsigned(task.cube.size());
+    for (int lit : task.cube)
+    {
+        out.putSigned(lit);
+    }
+    return out.data();
+}
+
+bool decodeTask(const std::vector<uint8_t> &payload, DistributedTask &task)
+{
+    MessageReader in(payload);
+    uint64_t config, count;
+    if (!in.getUnsigned(task.id) || !in.getUnsigned(config) || config > std::numeric_limits<uint32_t>::max() ||
+        !in.getUnsigned(count) || count > payload.size())
+    {
+        return false;
+    }
+    task.config = static_cast<uint32_t>(config);
+
+    task.cube.clear();
+    for (uint64_t i = 0; i < count; i++)
+    {
+        int64_t lit;
+        if (!in.getSigned(lit) || lit == 0 || lit > std::numeric_limits<int>::max() ||
+            lit < -std::numeric_limits<int>::max())
+        {
+            return false;
+        }
+        task.cube.push_back(static_cast<int>(lit));
+    }
+    return in.atEnd();
+}
+
+std::vector<uint8_t> encodeClauseBatch(uint64_t job_id, const CNF &clauses)
+{
+    MessageWriter out;
+    out.putUnsigned(job_id);
+    out.putClauses(clauses);
+    return out.data();
+}
+
+bool decodeClauseBatch(const std::vector<uint8_t> &payload, uint64_t &job_id, CNF &clauses)
+{
+    MessageReader in(payload);
+    return in.getUnsigned(job_id) && in.getClauses(clauses) && in.atEnd();
+}
+
+namespace
+{
+    bool writeAll(int fd, const uint8_t *data, size_t size)
+    {
+        while (size > 0)
+        {
+            ssize_t written = send(fd, data, size, MSG_NOSIGNAL);
+            if (written < 0 && errno == EINTR)
+            {
+                continue;
+            }
+            if (written <= 0)
+            {
+                return false;
+            }
+            data += written;
+            size -= written;
+        }
+        return true;
+    }
+
+    bool readAll(int fd, uint8_t *data, size_t size)
+    {
+        while (size > 0)
+        {
+            ssize_t got = read(fd, data, size);
+            if (got < 0 && errno == EINTR)
+            {
+                continue;
+            }
+            if (got <= 0)
+            {
+                return false;
+            }
+            data += got;
+            size -= got;
+        }
+        return true;
+    }
+}
+
+bool sendFrame(int fd, MessageType type, const std::vector<uint8_t> &payload)
+{
+    if (payload.size() > MAX_FRAME_SIZE)
+    {
+        return false;
+    }
+
+    uint32_t size = static_cast<uint32_t>(payload.size());
+    uint8_t header[5] = {static_cast<uint8_t>(size), static_cast<uint8_t>(size >> 8),
+                         static_cast<uint8_t>(size >> 16), static_cast<uint8_t>(size >> 24),
+                         static_cast<uint8_t>(type)};
+    return writeAll(fd, header, sizeof(header)) && writeAll(fd, payload.data(), payload.size());
+}
+
+bool receiveFrame(int fd, MessageType &type, std::vector<uint8_t> &payload)
+{
+    uint8_t header[5];
+    if (!readAll(fd, header, sizeof(header)))
+    {
+        return false;
+    }
+
+    uint32_t size = header[0] | (header[1] << 8) | (header[2] << 16) | (static_cast<uint32_t>(header[3]) << 24);
+    if (size > MAX_FRAME_SIZE)
+    {
+        return false;
+    }
+    type = static_cast<MessageType>(header[4]);
+
+    // Grow with the bytes that actually arrive, so a bare header claiming a
+    // huge frame cannot make the receiver allocate it up front
+    const size_t chunk = 1 << 20;
+    payload.clear();
+    while (payload.size() < size)
+    {
+        size_t offset = payload.size();
+        payload.resize(offset + std::min<size_t>(chunk, size - offset));
+        if (!readAll(fd, payload.data() + offset, payload.size() - offset))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+const char *jobStatusName(JobStatus status)
+{
+    switch (status)
+    {
+    case JobStatus::SAT:
+        return "SATISFIABLE";
+    case JobStatus::UNSAT:
+        return "UNSATISFIABLE";
+    case JobStatus::TIMEOUT:
+        return "TIMEOUT";
+    case JobStatus::CANCELLED:
+        return "CANCELLED";
+    default:
+        return "ERROR";
+    }
+}
@@ -0,0 +1,102 @@
+#include "../include/SolveScheduler.h"
+
+SolveScheduler::SolveScheduler()
+    : SolveScheduler(Config())
+{
+}
+
+SolveScheduler::SolveScheduler(const Config &config)
+    : config(config),
+      stopping(false),
+      active(0),
+      slices(0),
+      pool(static_cast<size_t>(std::max(1, config.num_threads)))
+{
+}
+
+SolveScheduler::~SolveScheduler()
+{
+    stopping = true;
+    pool.wait();
+}
+
+SolveHandle SolveScheduler::submit(CDCLSolverIncremental &solver, const std::vector<int> &assumptions)
+{
+    auto session = std::make_shared<Session>();
+    session->solver = &solver;
+    session->task = solver.solveSliced(assumptions, config.slice_conflicts, config.slice_propagations);
+    session->handle = SolveHandle::create();
+    SolveHandle handle = session->handle;
+
+    active++;
+    pool.submit([this, session]()
+                { runSlice(session); });
+    return handle;
+}
+
+void SolveScheduler::wait()
+{
+    pool.wait();
+}
+
+// Resume one session for a slice, then requeue it behind everything already
+// waiting. Cancellation reaches the search through the solver's terminate
+// callback, which is swapped in only for the slice and restored even if the
+// search throws.
+void SolveScheduler::runSlice(std::shared_ptr<Session> session)
+{
+    CDCLSolverIncremental &solver = *session->solver;
+    SolveHandle &handle = session->handle;
+
+    bool finished = false;
+    bool threw = false;
+    {
+        CDCLSolverIncremental::TerminateScope scope(solver.terminate_callback);
+        solver.terminate_callback = [this, &handle, &scope]()
+        {
+            return stopping || handle.cancelRequested() || (scope.previous && scope.previous());
+        };
+        try
+        {
+            finished = session->task.resume();
+        }
+        catch (...)
+        {
+            threw = true;
+        }
+    }
+    slices++;
+
+    handle.publish(solver.getProgress());
+    if (threw)
+    {
+        // A search that failed cannot be resumed; give the handle an answer
+        // so waiters are released
+        session->task = SolveTask();
+        active--;
+        handle.complete(SolveStatus::UNKNOWN, {}, {});
+        return;
+    }
+    if (!finished)
+    {
+        pool.submit([this, session]()
+                    { runSlice(session); });
+        return;
+    }
+
+    bool sat = session->task.result();
+    SolveStatus status = sat ? SolveStatus::SAT : solver.wasInterrupted() ? SolveStatus::UNKNOWN : SolveStatus::UNSAT;
+    std::unordered_map<int, bool> model;
+    std::vector<int> core;
+    if (status == SolveStatus::SAT)
+    {
+        model = solver.getAssignments();
+    }
+    else if (status == SolveStatus::UNSAT)
+    {
+        core = solver.getUnsatCore();
+    }
+    session->task = SolveTask();
+    active--;
+    handle.complete(status, std::move(model), std::move(core));
+}
@@ -0,0 +1,263 @@
+#include "../include/SolverCheckpoint.h"
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <type_traits>
+#include <unistd.h>
+
+namespace
+{
+    constexpr char CHECKPOINT_MAGIC[8] = {'S', 'A', 'T', 'C', 'K', 'P', 'T', 0};
+    constexpr uint32_t CHECKPOINT_VERSION = 1;
+
+    enum Section
+    {
+        CLAUSES,
+        LITERALS,
+        ACTIVITY,
+        SAVED_PHASE,
+        TARGET_PHASE,
+        FORCED_PHASE,
+        ROOT_TRAIL,
+        TEMPORARY_GROUPS,
+        SECTION_COUNT
+    };
+
+    struct SectionEntry
+    {
+        uint64_t offset;
+        uint64_t count;
+    };
+
+    struct FileHeader
+    {
+        char magic[8];
+        uint32_t version;
+        uint32_t num_vars;
+        uint32_t flags; // 1 = empty clause
+        int32_t restart_threshold;
+        int32_t luby_index;
+        uint32_t reserved;
+        double var_inc;
+        double clause_activity_inc;
+        int64_t conflicts;
+        int64_t decisions;
+        int64_t propagations;
+        int64_t restarts;
+        SectionEntry sections[SECTION_COUNT];
+    };
+    static_assert(std::is_trivially_copyable_v<FileHeader> && sizeof(FileHeader) % 8 == 0);
+    static_assert(sizeof(CheckpointClause) == 16);
+
+    inline uint64_t align8(uint64_t offset)
+    {
+        return (offset + 7) & ~static_cast<uint64_t>(7);
+    }
+
+    bool writeAll(int fd, const void *data, size_t size)
+    {
+        const char *bytes = static_cast<const char *>(data);
+        while (size > 0)
+        {
+            ssize_t written = write(fd, bytes, size);
+            if (written < 0 && errno == EINTR)
+            {
+                continue;
+            }
+            if (written <= 0)
+            {
+                return false;
+            }
+            bytes += written;
+            size -= written;
+        }
+        return true;
+    }
+
+    // Section contents, in Section order
+    struct SectionData
+    {
+        const void *data;
+        size_t count;
+        size_t element_size;
+    };
+
+    template <typename T>
+    SectionData section(const std::vector<T> &values)
+    {
+        return {values.data(), values.size(), sizeof(T)};
+    }
+
+    // Copy a section out of the mapping; false if it is misaligned or out of bounds
+    template <typename T>
+    bool loadSection(const uint8_t *base, size_t file_size, const SectionEntry &entry, std::vector<T> &values)
+    {
+        if (entry.offset % 8 != 0 || entry.offset > file_size ||
+            entry.count > (file_size - entry.offset) / sizeof(T))
+        {
+            return false;
+        }
+        const T *first = reinterpret_cast<const T *>(base + entry.offset);
+        values.assign(first, first + entry.count);
+        return true;
+    }
+}
+
+bool writeCheckpoint(const std::string &path, const SolverCheckpoint &checkpoint)
+{
+    SectionData sections[SECTION_COUNT] = {
+        section(checkpoint.clauses),
+        section(checkpoint.literals),
+        section(checkpoint.activity),
+        section(checkpoint.saved_phase),
+        section(checkpoint.target_phase),
+        section(checkpoint.forced_phase),
+        section(checkpoint.root_trail),
+        section(checkpoint.temporary_groups)};
+
+    FileHeader header{};
+    std::memcpy(header.magic, CHECKPOINT_MAGIC, sizeof(header.magic));
+    header.version = CHECKPOINT_VERSION;
+    header.num_vars = checkpoint.num_vars;
+    header.flags = checkpoint.has_empty_clause ? 1 : 0;
+    header.restart_threshold = checkpoint.restart_threshold;
+    header.luby_index = checkpoint.luby_index;
+    header.var_inc = checkpoint.var_inc;
+    header.clause_activity_inc = checkpoint.clause_activity_inc;
+    header.conflicts = checkpoint.conflicts;
+    header.decisions = checkpoint.decisions;
+    header.propagations = checkpoint.propagations;
+    header.restarts = checkpoint.restarts;
+
+    uint64_t offset = sizeof(FileHeader);
+    for (int i = 0; i < SECTION_COUNT; i++)
+    {
+        header.sections[i] = {offset, sections[i].count};
+        offset = align8(offset + sections[i].count * sections[i].element_size);
+    }
+
+    // Write beside the target and rename over it once the data is on disk
+    std::string temp_path = path + ".tmp";
+    int fd = open(temp_path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0)
+    {
+        return false;
+    }
+
+    const uint64_t zero = 0;
+    bool ok = writeAll(fd, &header, sizeof(header));
+    for (int i = 0; i < SECTION_COUNT && ok; i++)
+    {
+        size_t bytes = sections[i].count * sections[i].element_size;
+        ok = writeAll(fd, sections[i].data, bytes) && writeAll(fd, &zero, align8(bytes) - bytes);
+    }
+    ok = ok && fsync(fd) == 0;
+    ok = close(fd) == 0 && ok;
+
+    if (!ok || rename(temp_path.c_str(), path.c_str()) != 0)
+    {
+        unlink(temp_path.c_str());
+        return false;
+    }
+    return true;
+}
+
+bool readCheckpoint(const std::string &path, SolverCheckpoint &checkpoint)
+{
+    int fd = open(path.c_str(), O_RDONLY);
+    if (fd < 0)
+    {
+        return false;
+    }
+
+    struct stat info;
+    if (fstat(fd, &info) < 0 || static_cast<size_t>(info.st_size) < sizeof(FileHeader))
+    {
+        close(fd);
+        return false;
+    }
+    size_t file_size = static_cast<size_t>(info.st_size);
+    void *address = mmap(nullptr, file_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (address == MAP_FAILED)
+    {
+        return false;
+    }
+    const uint8_t *base = static_cast<const uint8_t *>(address);
+
+    FileHeader header;
+    std::memcpy(&header, base, sizeof(header));
+    bool ok = std::memcmp(header.magic, CHECKPOINT_MAGIC, sizeof(header.magic)) == 0 &&
+              header.version == CHECKPOINT_VERSION;
+
+    if (ok)
+    {
+        checkpoint.num_vars = header.num_vars;
+        checkpoint.has_empty_clause = (header.flags & 1) != 0;
+        checkpoint.restart_threshold = header.restart_threshold;
+        checkpoint.luby_index = header.luby_index;
+        checkpoint.var_inc = header.var_inc;
+        checkpoint.clause_activity_inc = header.clause_activity_inc;
+        checkpoint.conflicts = header.conflicts;
+        checkpoint.decisions = header.decisions;
+        checkpoint.propagations = header.propagations;
+        checkpoint.restarts = header.restarts;
+
+        const auto &s = header.sections;
+        ok = loadSection(base, file_size, s[CLAUSES], checkpoint.clauses) &&
+             loadSection(base, file_size, s[LITERALS], checkpoint.literals) &&
+             loadSection(base, file_size, s[ACTIVITY], checkpoint.activity) &&
+             loadSection(base, file_size, s[SAVED_PHASE], checkpoint.saved_phase) &&
+             loadSection(base, file_size, s[TARGET_PHASE], checkpoint.target_phase) &&
+             loadSection(base, file_size, s[FORCED_PHASE], checkpoint.forced_phase) &&
+             loadSection(base, file_size, s[ROOT_TRAIL], checkpoint.root_trail) &&
+             loadSection(base, file_size, s[TEMPORARY_GROUPS], checkpoint.temporary_groups);
+    }
+    munmap(address, file_size);
+
+    if (!ok)
+    {
+        return false;
+    }
+
+    // Arrays must agree with each other and with the variable count
+    size_t per_var = static_cast<size_t>(checkpoint.num_vars) + 1;
+    uint64_t total_literals = 0;
+    for (const auto &clause : checkpoint.clauses)
+    {
+        total_literals += clause.size;
+    }
+    if (total_literals != checkpoint.literals.size() || checkpoint.activity.size() != per_var ||
+        checkpoint.saved_phase.size() != per_var || checkpoint.target_phase.size() != per_var ||
+        checkpoint.forced_phase.size() != per_var)
+    {
+        return false;
+    }
+
+    auto inRange = [&](int32_t lit)
+    { return lit != 0 && static_cast<uint32_t>(lit < 0 ? -static_cast<int64_t>(lit) : lit) <= checkpoint.num_vars; };
+    for (int32_t lit : checkpoint.literals)
+    {
+        if (!inRange(lit))
+        {
+            return false;
+        }
+    }
+    for (int32_t lit : checkpoint.root_trail)
+    {
+        if (!inRange(lit))
+        {
+            return false;
+        }
+    }
+    for (int32_t lit : checkpoint.temporary_groups)
+    {
+        if (!inRange(lit))
+        {
+            return false;
+        }
+    }
+    return true;
+}
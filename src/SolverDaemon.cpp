@@ -0,0 +1,525 @@
+#include "../include/SolverDaemon.h"
+#include "../include/CDCLSolverIncremental.h"
+#include "../include/PortfolioManager.h"
+#include "../include/HybridMaxSATSolver.h"
+#include <cstring>
+#include <iostream>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+namespace
+{
+    // Model as literals over variables 1..num_vars; untouched variables are false
+    std::vector<int> modelLiterals(const std::unordered_map<int, bool> &model, int num_vars)
+    {
+        std::vector<int> literals;
+        literals.reserve(num_vars);
+        for (int var = 1; var <= num_vars; var++)
+        {
+            auto it = model.find(var);
+            literals.push_back(it != model.end() && it->second ? var : -var);
+        }
+        return literals;
+    }
+
+    int maxVariable(const JobRequest &request)
+    {
+        int num_vars = 0;
+        for (const auto &clause : request.clauses)
+        {
+            for (int lit : clause)
+            {
+                num_vars = std::max(num_vars, std::abs(lit));
+            }
+        }
+        for (int lit : request.assumptions)
+        {
+            num_vars = std::max(num_vars, std::abs(lit));
+        }
+        return num_vars;
+    }
+
+    // Model over 1..n satisfies every hard clause (all clauses of a CNF job)
+    bool satisfiesHard(const JobRequest &request, const std::vector<int> &model)
+    {
+        for (size_t i = 0; i < request.clauses.size(); i++)
+        {
+            if (request.kind == JobKind::WCNF && request.weights[i] != 0)
+            {
+                continue;
+            }
+            bool satisfied = false;
+            for (int lit : request.clauses[i])
+            {
+                size_t var = std::abs(lit);
+                if (var <= model.size() && model[var - 1] == lit)
+                {
+                    satisfied = true;
+                    break;
+                }
+            }
+            if (!satisfied)
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+}
+
+SolverDaemon::Connection::~Connection()
+{
+    if (fd >= 0)
+    {
+        close(fd);
+    }
+}
+
+SolverDaemon::SolverDaemon(const Config &config)
+    : config(config),
+      stopping(false),
+      listen_fd(-1),
+      active_readers(0),
+      jobs_completed(0),
+      jobs_cancelled(0)
+{
+    if (config.cache_capacity > 0)
+    {
+        cache = std::make_unique<FormulaCache>(config.cache_capacity, config.cache_renaming);
+    }
+}
+
+SolverDaemon::~SolverDaemon()
+{
+    shutdown();
+}
+
+bool SolverDaemon::run()
+{
+    sockaddr_un address{};
+    address.sun_family = AF_UNIX;
+    if (config.socket_path.size() >= sizeof(address.sun_path))
+    {
+        std::cerr << "Socket path too long: " << config.socket_path << "\n";
+        return false;
+    }
+    std::strcpy(address.sun_path, config.socket_path.c_str());
+
+    listen_fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    unlink(config.socket_path.c_str());
+    if (listen_fd < 0 ||
+        bind(listen_fd, reinterpret_cast<sockaddr *>(&address), sizeof(address)) < 0 ||
+        listen(listen_fd, 128) < 0)
+    {
+        std::cerr << "Cannot listen on " << config.socket_path << ": " << std::strerror(errno) << "\n";
+        shutdown();
+        return false;
+    }
+
+    if (cache && !config.cache_path.empty() && !cache->open(config.cache_path))
+    {
+        std::cerr << "Cannot map cache file " << config.cache_path << ", caching in memory only\n";
+    }
+
+    for (int i = 0; i < std::max(1, config.num_workers); i++)
+    {
+        workers.emplace_back(&SolverDaemon::workerLoop, this);
+    }
+
+    std::cout << "sat_served listening on " << config.socket_path << " with "
+              << workers.size() << " workers" << std::endl;
+
+    // Accept until stopped; the poll timeout bounds the reaction time to stop()
+    while (!stopping)
+    {
+        pollfd listener{listen_fd, POLLIN, 0};
+        if (poll(&listener, 1, 200) <= 0)
+        {
+            continue;
+        }
+
+        int fd = accept(listen_fd, nullptr, nullptr);
+        if (fd < 0)
+        {
+            continue;
+        }
+
+        auto connection = std::make_shared<Connection>();
+        connection->fd = fd;
+        {
+            std::lock_guard<std::mutex> lock(connections_mutex);
+            connections.push_back(connection);
+            active_readers++;
+        }
+        std::thread(&SolverDaemon::readerLoop, this, connection).detach();
+    }
+
+    shutdown();
+    return true;
+}
+
+// Read frames from one client until it disconnects. Jobs still open at that
+// point are cancelled; their workers drop the results.
+void SolverDaemon::readerLoop(std::shared_ptr<Connection> connection)
+{
+    MessageType type;
+    std::vector<uint8_t> payload;
+    while (receiveFrame(connection->fd, type, payload))
+    {
+        if (type == MessageType::SUBMIT)
+        {
+            auto job = std::make_shared<Job>();
+            job->connection = connection;
+            // Every variable costs solver memory up front, so the largest one is bounded
+            bool valid = decodeJobRequest(payload, job->request) &&
+                         maxVariable(job->request) <= config.max_variables;
+            if (valid)
+            {
+                std::lock_guard<std::mutex> lock(connection->jobs_mutex);
+                valid = connection->jobs.emplace(job->request.id, job).second;
+            }
+
+            if (!valid)
+            {
+                // Malformed or oversized payload, or a job id that is still in use
+                JobResult result;
+                result.id = job->request.id;
+                result.status = JobStatus::ERROR;
+                std::lock_guard<std::mutex> lock(connection->write_mutex);
+                sendFrame(connection->fd, MessageType::RESULT, encodeJobResult(result));
+                continue;
+            }
+
+            {
+                std::lock_guard<std::mutex> lock(queue_mutex);
+                queue.push_back(job);
+            }
+            queue_cv.notify_one();
+        }
+        else if (type == MessageType::CANCEL)
+        {
+            uint64_t id;
+            std::shared_ptr<Job> job;
+            if (decodeCancel(payload, id))
+            {
+                std::lock_guard<std::mutex> lock(connection->jobs_mutex);
+                auto it = connection->jobs.find(id);
+                if (it != connection->jobs.end())
+                {
+                    job = it->second;
+                }
+            }
+            if (job)
+            {
+                cancel(*job);
+            }
+        }
+    }
+
+    // Client gone (or daemon stopping): nobody is left to read these results
+    std::vector<std::shared_ptr<Job>> open_jobs;
+    {
+        std::lock_guard<std::mutex> lock(connection->jobs_mutex);
+        for (const auto &[id, job] : connection->jobs)
+        {
+            open_jobs.push_back(job);
+        }
+    }
+    for (const auto &job : open_jobs)
+    {
+        cancel(*job);
+    }
+    ::shutdown(connection->fd, SHUT_RDWR);
+
+    std::lock_guard<std::mutex> lock(connections_mutex);
+    connections.erase(std::remove(connections.begin(), connections.end(), connection), connections.end());
+    active_readers--;
+    readers_cv.notify_all();
+}
+
+void SolverDaemon::workerLoop()
+{
+    while (true)
+    {
+        std::shared_ptr<Job> job;
+        {
+            std::unique_lock<std::mutex> lock(queue_mutex);
+            queue_cv.wait(lock, [this]
+                          { return !queue.empty() || stopping; });
+            if (queue.empty())
+            {
+                return;
+            }
+            job = queue.front();
+            queue.pop_front();
+        }
+
+        JobResult result;
+        if (job->cancelled)
+        {
+            result.id = job->request.id;
+            result.status = JobStatus::CANCELLED;
+        }
+        else
+        {
+            try
+            {
+                result = solveJob(*job);
+            }
+            catch (const std::exception &e)
+            {
+                // Out of memory or a solver failure: only this job is lost
+                std::cerr << "Job " << job->request.id << " failed: " << e.what() << std::endl;
+                {
+                    std::lock_guard<std::mutex> lock(job->mutex);
+                    job->portfolio = nullptr;
+                }
+                result = JobResult();
+                result.id = job->request.id;
+                result.status = JobStatus::ERROR;
+            }
+        }
+        finish(*job, result);
+    }
+}
+
+// Answer from the cache when the formula (or, with renaming, an isomorphic
+// one) was solved before; otherwise solve and remember SAT/UNSAT answers
+JobResult SolverDaemon::solveJob(Job &job)
+{
+    if (!cache)
+    {
+        return solveUncached(job);
+    }
+
+    const JobRequest &request = job.request;
+    CanonicalFormula query = cache->canonicalize(request.clauses, request.weights, request.assumptions);
+    CachedResult cached;
+    // Models are checked before they are served, so a key collision costs a solve
+    if (cache->lookup(query, cached) && (!cached.sat || satisfiesHard(request, cached.literals)))
+    {
+        JobResult result;
+        result.id = request.id;
+        result.status = cached.sat ? JobStatus::SAT : JobStatus::UNSAT;
+        result.cost = cached.cost;
+        result.literals = std::move(cached.literals);
+        return result;
+    }
+
+    JobResult result = solveUncached(job);
+    if (result.status == JobStatus::SAT || result.status == JobStatus::UNSAT)
+    {
+        cache->store(query, {result.status == JobStatus::SAT, result.cost, result.literals});
+    }
+    return result;
+}
+
+JobResult SolverDaemon::solveUncached(Job &job)
+{
+    auto timeout = job.request.timeout_ms > 0 ? std::chrono::milliseconds(job.request.timeout_ms)
+                                              : config.default_timeout;
+
+    JobResult result = job.request.kind == JobKind::WCNF ? solveWCNF(job, timeout) : solveCNF(job, timeout);
+    result.id = job.request.id;
+
+    // Whatever the solver reports, a cancelled job is answered as cancelled
+    if (job.cancelled && result.status != JobStatus::ERROR)
+    {
+        result.status = JobStatus::CANCELLED;
+        result.literals.clear();
+    }
+    return result;
+}
+
+// Single solver under the job's assumptions, or the portfolio for large and
+// flagged jobs without assumptions
+JobResult SolverDaemon::solveCNF(Job &job, std::chrono::milliseconds timeout)
+{
+    const JobRequest &request = job.request;
+    JobResult result;
+    int num_vars = maxVariable(request);
+
+    bool use_portfolio = request.assumptions.empty() &&
+                         ((request.flags & JOB_FLAG_PORTFOLIO) || request.clauses.size() >= config.portfolio_threshold);
+    if (use_portfolio)
+    {
+        PortfolioManager portfolio(request.clauses, timeout, config.portfolio_threads);
+        {
+            std::lock_guard<std::mutex> lock(job.mutex);
+            if (job.cancelled)
+            {
+                result.status = JobStatus::CANCELLED;
+                return result;
+            }
+            job.portfolio = &portfolio;
+        }
+
+        bool sat = portfolio.solve(request.clauses);
+        {
+            std::lock_guard<std::mutex> lock(job.mutex);
+            job.portfolio = nullptr;
+        }
+
+        if (sat)
+        {
+            result.status = JobStatus::SAT;
+            result.literals = modelLiterals(portfolio.getSolution(), num_vars);
+        }
+        else
+        {
+            result.status = portfolio.isUnsatProven() ? JobStatus::UNSAT : JobStatus::TIMEOUT;
+        }
+        return result;
+    }
+
+    CDCLSolverIncremental solver(request.clauses);
+    solver.ensureVariable(num_vars);
+    solver.setTimeout(timeout);
+    solver.setTerminateCallback([&job]()
+                                { return job.cancelled.load(std::memory_order_relaxed); });
+
+    if (solver.solve(request.assumptions))
+    {
+        result.status = JobStatus::SAT;
+        result.literals = modelLiterals(solver.getAssignments(), num_vars);
+    }
+    else if (solver.wasInterrupted())
+    {
+        result.status = JobStatus::TIMEOUT;
+    }
+    else
+    {
+        result.status = JobStatus::UNSAT;
+        result.literals = solver.getUnsatCore();
+    }
+    return result;
+}
+
+// Weighted MaxSAT through HybridMaxSATSolver. Its inner searches poll the
+// job's cancel flag and deadline, so both stop the job promptly.
+JobResult SolverDaemon::solveWCNF(Job &job, std::chrono::milliseconds timeout)
+{
+    const JobRequest &request = job.request;
+    JobResult result;
+    if (!request.assumptions.empty())
+    {
+        result.status = JobStatus::ERROR; // Assumptions are a CNF-only feature
+        return result;
+    }
+
+    CNF hard;
+    for (size_t i = 0; i < request.clauses.size(); i++)
+    {
+        if (request.weights[i] == 0)
+        {
+            hard.push_back(request.clauses[i]);
+        }
+    }
+
+    HybridMaxSATSolver solver(hard);
+    auto deadline = std::chrono::steady_clock::now() + timeout;
+    solver.setTerminateCallback([&job, deadline]()
+                                { return job.cancelled.load(std::memory_order_relaxed) ||
+                                         std::chrono::steady_clock::now() >= deadline; });
+    for (size_t i = 0; i < request.clauses.size(); i++)
+    {
+        if (request.weights[i] > 0)
+        {
+            solver.addSoftClause(request.clauses[i], request.weights[i]);
+        }
+    }
+
+    // A stopped inner search leaves -1 or a bound that is not proven optimal;
+    // either way the job timed out and the answer must not be cached
+    int cost = solver.solve();
+    if (solver.wasInterrupted())
+    {
+        result.status = JobStatus::TIMEOUT;
+        return result;
+    }
+    if (cost < 0)
+    {
+        result.status = JobStatus::UNSAT;
+        return result;
+    }
+
+    result.status = JobStatus::SAT;
+    result.cost = cost;
+    result.literals = modelLiterals(solver.getAssignment(), maxVariable(request));
+    return result;
+}
+
+// Stop a queued or running job; the worker still answers it
+void SolverDaemon::cancel(Job &job)
+{
+    std::lock_guard<std::mutex> lock(job.mutex);
+    job.cancelled = true;
+    if (job.portfolio != nullptr)
+    {
+        job.portfolio->stop();
+    }
+}
+
+void SolverDaemon::finish(Job &job, const JobResult &result)
+{
+    auto &connection = *job.connection;
+    {
+        std::lock_guard<std::mutex> lock(connection.jobs_mutex);
+        connection.jobs.erase(job.request.id);
+    }
+    {
+        // Fails quietly once the client is gone
+        std::lock_guard<std::mutex> lock(connection.write_mutex);
+        sendFrame(connection.fd, MessageType::RESULT, encodeJobResult(result));
+    }
+
+    jobs_completed++;
+    if (result.status == JobStatus::CANCELLED)
+    {
+        jobs_cancelled++;
+    }
+}
+
+// Close the listener, cut every connection (which cancels its jobs), then let
+// the workers drain the queue and exit
+void SolverDaemon::shutdown()
+{
+    stopping = true;
+    if (listen_fd >= 0)
+    {
+        close(listen_fd);
+        unlink(config.socket_path.c_str());
+        listen_fd = -1;
+    }
+
+    {
+        std::unique_lock<std::mutex> lock(connections_mutex);
+        for (const auto &connection : connections)
+        {
+            ::shutdown(connection->fd, SHUT_RDWR);
+        }
+        readers_cv.wait(lock, [this]
+                        { return active_readers == 0; });
+    }
+
+    {
+        // Workers test stopping under this lock; taking it orders the wakeup after their test
+        std::lock_guard<std::mutex> lock(queue_mutex);
+    }
+    queue_cv.notify_all();
+    for (auto &worker : workers)
+    {
+        if (worker.joinable())
+        {
+            worker.join();
+        }
+    }
+    workers.clear();
+
+    if (cache)
+    {
+        cache->flush();
+    }
+}
@@ -0,0 +1,71 @@
+#include "../include/ThreadPool.h"
+#include <algorithm>
+
+ThreadPool::ThreadPool(size_t num_threads)
+    : running(0),
+      stopping(false)
+{
+    num_threads = std::max<size_t>(1, num_threads);
+    workers.reserve(num_threads);
+    for (size_t i = 0; i < num_threads; i++)
+    {
+        workers.emplace_back(&ThreadPool::workerLoop, this);
+    }
+}
+
+ThreadPool::~ThreadPool()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    task_cv.notify_all();
+    for (auto &worker : workers)
+    {
+        worker.join();
+    }
+}
+
+void ThreadPool::submit(std::function<void()> task)
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        tasks.push_back(std::move(task));
+    }
+    task_cv.notify_one();
+}
+
+void ThreadPool::wait()
+{
+    std::unique_lock<std::mutex> lock(mutex);
+    idle_cv.wait(lock, [this]
+                 { return tasks.empty() && running == 0; });
+}
+
+void ThreadPool::workerLoop()
+{
+    std::unique_lock<std::mutex> lock(mutex);
+    while (true)
+    {
+        task_cv.wait(lock, [this]
+                     { return !tasks.empty() || stopping; });
+        if (tasks.empty())
+        {
+            return; // Stopping with nothing left to run
+        }
+
+        std::function<void()> task = std::move(tasks.front());
+        tasks.pop_front();
+        running++;
+
+        lock.unlock();
+        task();
+        lock.lock();
+
+        running--;
+        if (tasks.empty() && running == 0)
+        {
+            idle_cv.notify_all();
+        }
+    }
+}
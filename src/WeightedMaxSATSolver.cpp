@@ -6,7 +6,7 @@
 #include <chrono>
 
 WeightedMaxSATSolver::WeightedMaxSATSolver(const CNF &hard_clauses, bool debug)
-    : hard_clauses(hard_clauses), debug_output(debug), solver_calls(0),
+    : hard_clauses(hard_clauses), debug_output(debug), solver_calls(0), interrupted(false),
       has_previous_solution(false) {}
 
 void WeightedMaxSATSolver::addSoftClause(const Clause &soft_clause, int weight)
@@ -41,13 +41,13 @@ int WeightedMaxSATSolver::solveStratified()
     // Reset warm start data at beginning of new solve
     has_previous_solution = false;
     last_solution.clear();
+    interrupted = false;
 
     if (soft_clauses.empty())
     {
         // No soft clauses, just solve the hard clauses
         MaxSATSolver solver(hard_clauses, debug_output);
-        solver_calls += solver.getNumSolverCalls();
-        bool result = solver.solve() == 0;
+        bool result = runSolver(solver) == 0;
         return result ? 0 : -1; // -1 indicates unsatisfiable hard clauses
     }
 
@@ -137,8 +137,11 @@ int WeightedMaxSATSolver::solveStratified()
         }
 
         // Solve
-        int violated = solver.solve();
-        solver_calls += solver.getNumSolverCalls();
+        int violated = runSolver(solver);
+        if (interrupted)
+        {
+            return -1;
+        }
 
         if (violated == -1)
         {
@@ -186,13 +189,13 @@ int WeightedMaxSATSolver::solveBinarySearch()
     // Reset warm start data at beginning of new solve
     has_previous_solution = false;
     last_solution.clear();
+    interrupted = false;
 
     if (soft_clauses.empty())
     {
         // No soft clauses, just solve the hard clauses
         MaxSATSolver solver(hard_clauses, debug_output);
-        solver_calls += solver.getNumSolverCalls();
-        bool result = solver.solve() == 0;
+        bool result = runSolver(solver) == 0;
         return result ? 0 : -1; // -1 indicates unsatisfiable hard clauses
     }
 
@@ -210,8 +213,11 @@ int WeightedMaxSATSolver::solveBinarySearch()
         full_solver.addSoftClause(clause);
     }
 
-    int violated = full_solver.solve();
-    solver_calls += full_solver.getNumSolverCalls();
+    int violated = runSolver(full_solver);
+    if (interrupted)
+    {
+        return -1;
+    }
 
     if (violated == 0)
     {
@@ -258,7 +264,7 @@ int WeightedMaxSATSolver::solveBinarySearch()
             std::cout << "Early estimation successful at weight = " << early_estimate << std::endl;
         }
     }
-    else
+    else if (!interrupted)
     {
         // Use exponential probing with adaptive step sizes
         while (upper_bound < total_weight)
@@ -273,6 +279,10 @@ int WeightedMaxSATSolver::solveBinarySearch()
                 // Found a satisfiable point, use this as upper bound
                 break;
             }
+            if (interrupted)
+            {
+                break;
+            }
 
             // Update bounds and increase step size
             lower_bound = upper_bound + 1;
@@ -282,9 +292,9 @@ int WeightedMaxSATSolver::solveBinarySearch()
     }
 
     // If we've reached the maximum and it's still UNSAT, try with all weight
-    if (upper_bound == total_weight && !checkWeightLimit(total_weight))
+    if (interrupted || (upper_bound == total_weight && !checkWeightLimit(total_weight)))
     {
-        return -1; // Formula is UNSAT even with all weight violated
+        return -1; // Formula is UNSAT even with all weight violated, or the search stopped
     }
 
     if (debug_output)
@@ -305,6 +315,10 @@ int WeightedMaxSATSolver::solveBinarySearch()
         }
 
         bool satisfiable = checkWeightLimit(mid_weight);
+        if (interrupted)
+        {
+            return -1;
+        }
 
         if (satisfiable)
         {
@@ -319,7 +333,7 @@ int WeightedMaxSATSolver::solveBinarySearch()
     }
 
     // Final check
-    bool final_check = checkWeightLimit(lower_bound);
+    bool final_check = checkWeightLimit(lower_bound) && !interrupted;
 
     if (debug_output)
     {
@@ -392,8 +406,7 @@ bool WeightedMaxSATSolver::checkWeightLimit(int weight_limit)
     }
 
     // Solve
-    int result = solver.solve(); // MaxSATSolver now has warm starting built in
-    solver_calls += solver.getNumSolverCalls();
+    int result = runSolver(solver); // MaxSATSolver now has warm starting built in
 
     // Update warm start data if successful
     if (result >= 0)
@@ -434,6 +447,15 @@ bool WeightedMaxSATSolver::checkWeightLimit(int weight_limit)
     return actual_weight <= weight_limit;
 }
 
+int WeightedMaxSATSolver::runSolver(MaxSATSolver &solver)
+{
+    solver.setTerminateCallback(terminate_callback);
+    int result = solver.solve();
+    solver_calls += solver.getNumSolverCalls();
+    interrupted |= solver.wasInterrupted();
+    return result;
+}
+
 int WeightedMaxSATSolver::getNumSolverCalls() const
 {
     return solver_calls;
@@ -504,46 +504,26 @@ void debugBasicFunctionality()
 // Enumerate all satisfying assignments for a small formula
 void enumerateAllSolutions(CDCLSolverIncremental &solver, int max_solutions = -1)
 {
-    int count = 0;
-    bool solutions_remain = true;
+    EnumerationOptions options;
+    options.max_models = (max_solutions < 0) ? 0 : static_cast<size_t>(max_solutions);
 
-    while (solutions_remain && (max_solutions == -1 || count < max_solutions))
-    {
-        // Solve the current formula
-        bool result = solver.solve();
-
-        if (!result)
-        {
-            solutions_remain = false;
-            break;
-        }
-
-        // We found a solution
-        count++;
-
-        // Print the solution
-        std::cout << "Solution " << count << ":\n";
-        const auto &assignments = solver.getAssignments();
-        for (const auto &[var, value] : assignments)
+    int index = 0;
+    size_t count = solver.enumerateModels([&index](const std::vector<int> &model)
+                                          {
+        std::cout << "Solution " << ++index << ":\n";
+        for (int lit : model)
         {
-            std::cout << "x" << var << " = " << value << ", ";
+            int var = std::abs(lit);
+            std::cout << "x" << var << " = " << (lit > 0) << ", ";
             if (var % 5 == 0)
                 std::cout << "\n";
         }
         std::cout << "\n\n";
+        return true; },
+                                          options);
 
-        // Create a blocking clause to exclude this solution
-        Clause blocking_clause;
-        for (const auto &[var, value] : assignments)
-        {
-            blocking_clause.push_back(value ? -var : var);
-        }
-
-        // Add the blocking clause to the formula
-        solver.addClause(blocking_clause);
-    }
-
-    std::cout << "Total satisfying assignments: " << count << "\n";
+    std::cout << "Total satisfying assignments: " << count
+              << (solver.wasInterrupted() ? " (stopped early, incomplete)" : "") << "\n";
 }
 
 // Helper function to run a benchmark and print results
@@ -0,0 +1,162 @@
+#include <iostream>
+#include <vector>
+#include <string>
+#include <chrono>
+#include <csignal>
+#include "../include/DistributedPortfolio.h"
+#include "../include/DimacsParser.h"
+
+// Coordinator or worker behind the signal handlers
+static DistributedCoordinator *active_coordinator = nullptr;
+static DistributedWorker *active_worker = nullptr;
+
+static void handleSignal(int)
+{
+    if (active_coordinator != nullptr)
+    {
+        active_coordinator->stop();
+    }
+    if (active_worker != nullptr)
+    {
+        active_worker->stop();
+    }
+}
+
+// Wait for the workers, solve one file, print the answer DIMACS style
+int coordinate(const std::string &path, const DistributedCoordinator::Config &config)
+{
+    CNF formula, soft;
+    std::vector<int> weights;
+    bool weighted;
+    if (!readFormulaFile(path, formula, soft, weights, weighted) || weighted)
+    {
+        std::cerr << "Cannot read CNF file " << path << "\n";
+        return 1;
+    }
+
+    DistributedCoordinator coordinator(config);
+    if (!coordinator.listen())
+    {
+        std::cerr << "Cannot listen on " << config.bind_address << ":" << config.port << "\n";
+        return 1;
+    }
+    std::cout << "c coordinator listening on " << config.bind_address << ":" << coordinator.getPort() << std::endl;
+
+    active_coordinator = &coordinator;
+    std::signal(SIGINT, handleSignal);
+    std::signal(SIGTERM, handleSignal);
+
+    if (coordinator.acceptWorkers() == 0)
+    {
+        std::cerr << "No worker connected\n";
+        active_coordinator = nullptr;
+        return 1;
+    }
+
+    auto start = std::chrono::high_resolution_clock::now();
+    JobResult result = coordinator.solve(formula);
+    auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::high_resolution_clock::now() - start);
+    active_coordinator = nullptr;
+
+    std::cout << "c " << elapsed.count() << " ms, " << coordinator.getSharedClauses() << " clauses shared\n";
+    std::cout << "s " << (result.status == JobStatus::SAT     ? "SATISFIABLE"
+                          : result.status == JobStatus::UNSAT ? "UNSATISFIABLE"
+                                                              : "UNKNOWN")
+              << "\n";
+    if (result.status == JobStatus::SAT)
+    {
+        std::cout << "v";
+        for (int lit : result.literals)
+        {
+            std::cout << " " << lit;
+        }
+        std::cout << " 0\n";
+    }
+    return result.status == JobStatus::SAT ? 10 : result.status == JobStatus::UNSAT ? 20 : 0;
+}
+
+// Serve one coordinator until it closes the connection
+int work(const DistributedWorker::Config &config)
+{
+    DistributedWorker worker(config);
+    active_worker = &worker;
+    std::signal(SIGINT, handleSignal);
+    std::signal(SIGTERM, handleSignal);
+
+    bool ok = worker.run();
+    active_worker = nullptr;
+    if (!ok)
+    {
+        std::cerr << "Cannot reach coordinator at " << config.host << ":" << config.port << "\n";
+        return 1;
+    }
+    std::cout << "Worker finished " << worker.getTasksCompleted() << " tasks\n";
+    return 0;
+}
+
+void printUsage()
+{
+    std::cout << "Usage:\n";
+    std::cout << "  ./sat_portfolio_node coordinator [options] FILE  - Solve FILE on connected workers\n";
+    std::cout << "      --bind ADDR                                    Listen address (default 127.0.0.1)\n";
+    std::cout << "      --port P                                       Listen port (default: any free port)\n";
+    std::cout << "      --workers N                                    Workers to wait for (default 1)\n";
+    std::cout << "      --wait SEC                                     How long to wait for them (default 30)\n";
+    std::cout << "      --timeout SEC                                  Solve timeout (default 1800)\n";
+    std::cout << "      --cubes K                                      Split into 2^K cubes (default 0: portfolio)\n";
+    std::cout << "      --share-length L                               Longest shared clause, 0 = no sharing (default 8)\n";
+    std::cout << "  ./sat_portfolio_node worker [options] HOST PORT   - Run tasks for a coordinator\n";
+    std::cout << "      --threads N                                    Solver slots (default: cores)\n";
+    std::cout << "      --slice N                                      Conflicts between clause exchanges (default 2000)\n";
+    std::cout << "  ./sat_portfolio_node help                         - Show this help\n";
+}
+
+int main(int argc, char *argv[])
+{
+    std::string command = argc > 1 ? argv[1] : "help";
+
+    DistributedCoordinator::Config coordinator_config;
+    DistributedWorker::Config worker_config;
+    std::vector<std::string> positional;
+
+    for (int i = 2; i < argc; i++)
+    {
+        std::string arg = argv[i];
+        bool has_value = i + 1 < argc;
+        if (arg == "--bind" && has_value)
+            coordinator_config.bind_address = argv[++i];
+        else if (arg == "--port" && has_value)
+            coordinator_config.port = static_cast<uint16_t>(std::stoi(argv[++i]));
+        else if (arg == "--workers" && has_value)
+            coordinator_config.num_workers = std::max(1, std::stoi(argv[++i]));
+        else if (arg == "--wait" && has_value)
+            coordinator_config.connect_timeout = std::chrono::seconds(std::stoi(argv[++i]));
+        else if (arg == "--timeout" && has_value)
+            coordinator_config.timeout = std::chrono::seconds(std::stoi(argv[++i]));
+        else if (arg == "--cubes" && has_value)
+            coordinator_config.cube_variables = std::stoi(argv[++i]);
+        else if (arg == "--share-length" && has_value)
+            coordinator_config.share_max_length = static_cast<uint32_t>(std::stoi(argv[++i]));
+        else if (arg == "--threads" && has_value)
+            worker_config.num_threads = std::max(1, std::stoi(argv[++i]));
+        else if (arg == "--slice" && has_value)
+            worker_config.slice_conflicts = std::max(1, std::stoi(argv[++i]));
+        else
+            positional.push_back(arg);
+    }
+
+    if (command == "coordinator" && positional.size() == 1)
+    {
+        return coordinate(positional[0], coordinator_config);
+    }
+    if (command == "worker" && positional.size() == 2)
+    {
+        worker_config.host = positional[0];
+        worker_config.port = static_cast<uint16_t>(std::stoi(positional[1]));
+        return work(worker_config);
+    }
+
+    printUsage();
+    return command == "help" ? 0 : 1;
+}
@@ -7,8 +7,11 @@
 #include <thread>
 #include <unordered_map>
 #include <map>
+#include <sstream>
 #include "../include/SATInstance.h"
 #include "../include/PortfolioManager.h"
+#include "../include/DimacsParser.h"
+#include "../include/BatchSolver.h"
 
 // Helper function to generate random 3-SAT instances (taken from main_incremental.cpp)
 CNF generateRandom3SAT(int num_vars, double clause_ratio, int seed = 42)
@@ -274,6 +277,64 @@ void testClauseRatios(int num_vars, const std::vector<double> &ratios, int insta
     }
 }
 
+// Same sweep as testClauseRatios through a BatchSolver: instances share one
+// thread pool and only those past the conflict budget get a portfolio
+void testClauseRatiosBatch(int num_vars, const std::vector<double> &ratios, int instances_per_ratio,
+                           const BatchSolver::Config &config)
+{
+    size_t count = ratios.size() * instances_per_ratio;
+    std::random_device rd;
+    unsigned base_seed = rd();
+
+    std::cout << "\nRandom 3-SAT Batch Benchmark\n";
+    std::cout << "Variables: " << num_vars << ", Instances per ratio: " << instances_per_ratio
+              << ", Workers: " << config.num_threads << ", Conflict budget: " << config.conflict_budget << "\n\n";
+
+    BatchSolver batch(config);
+    auto start = std::chrono::high_resolution_clock::now();
+    std::vector<BatchResult> results = batch.solve(count, [&](size_t i)
+                                                   { return generateRandom3SAT(num_vars, ratios[i / instances_per_ratio], base_seed + i); });
+    auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::high_resolution_clock::now() - start);
+
+    std::vector<int> column_widths = {8, 8, 8, 8, 10, 12, 12};
+    printTableSeparator(column_widths);
+    printTableRow({"Ratio", "SAT", "UNSAT", "Unknown", "Escalated", "Time (µs)", "Conflicts"}, column_widths);
+    printTableSeparator(column_widths);
+
+    for (size_t r = 0; r < ratios.size(); r++)
+    {
+        int counts[3] = {0, 0, 0};
+        int escalated = 0;
+        long long total_time = 0;
+        long long total_conflicts = 0;
+        for (int k = 0; k < instances_per_ratio; k++)
+        {
+            const BatchResult &result = results[r * instances_per_ratio + k];
+            counts[static_cast<int>(result.status)]++;
+            escalated += result.escalated;
+            total_time += result.time.count();
+            total_conflicts += result.conflicts;
+        }
+
+        std::ostringstream ratio;
+        ratio << std::fixed << std::setprecision(2) << ratios[r];
+        printTableRow({ratio.str(),
+                       std::to_string(counts[0]),
+                       std::to_string(counts[1]),
+                       std::to_string(counts[2]),
+                       std::to_string(escalated),
+                       std::to_string(total_time / instances_per_ratio),
+                       std::to_string(total_conflicts / instances_per_ratio)},
+                      column_widths);
+    }
+    printTableSeparator(column_widths);
+
+    std::cout << count << " instances in " << elapsed.count() << " ms ("
+              << std::fixed << std::setprecision(1) << (elapsed.count() > 0 ? count * 1000.0 / elapsed.count() : 0)
+              << " instances/s), " << batch.getEscalated() << " escalated to the portfolio\n";
+}
+
 // Function to run comprehensive benchmarks around the phase transition
 void runPhaseTransitionBenchmark()
 {
@@ -338,6 +399,45 @@ void runConfigurationBenchmark()
     testClauseRatios(num_vars, ratios, instances, timeout);
 }
 
+// Solve one DIMACS file; with a checkpoint prefix, an interrupted run resumes
+// from the solvers' last checkpoints when started again. With more
+// configurations than threads the configurations are time-sliced.
+int solveFile(const std::string &path, std::chrono::seconds timeout,
+              const std::string &checkpoint_prefix, std::chrono::seconds checkpoint_interval,
+              int num_threads, int num_configs, int slice_conflicts, size_t memory_mb)
+{
+    CNF formula, soft;
+    std::vector<int> weights;
+    bool weighted;
+    if (!readFormulaFile(path, formula, soft, weights, weighted) || weighted)
+    {
+        std::cout << "Cannot read CNF file " << path << "\n";
+        return 1;
+    }
+
+    PortfolioManager portfolio(formula, timeout, num_threads);
+    if (num_configs > 0)
+    {
+        portfolio.setNumConfigurations(num_configs);
+    }
+    if (slice_conflicts > 0)
+    {
+        portfolio.setSliceConflicts(slice_conflicts);
+    }
+    if (memory_mb > 0)
+    {
+        portfolio.setMaxMemoryUsage(memory_mb);
+    }
+    if (!checkpoint_prefix.empty())
+    {
+        portfolio.setCheckpointing(checkpoint_prefix, checkpoint_interval);
+    }
+
+    bool sat = portfolio.solve(formula);
+    std::cout << "s " << (sat ? "SATISFIABLE" : portfolio.isUnsatProven() ? "UNSATISFIABLE" : "UNKNOWN") << "\n";
+    return sat ? 10 : portfolio.isUnsatProven() ? 20 : 0;
+}
+
 // Main function with command line processing
 int main(int argc, char *argv[])
 {
@@ -389,6 +489,67 @@ int main(int argc, char *argv[])
 
             testClauseRatios(num_vars, ratios, instances, std::chrono::seconds(timeout_seconds));
         }
+        else if (command == "batch")
+        {
+            // Same ratio sweep as custom, on a shared thread pool
+            int num_vars = 100;
+            int instances = 100;
+            BatchSolver::Config config;
+            std::vector<int> positional;
+            for (int i = 2; i < argc; i++)
+            {
+                std::string arg = argv[i];
+                if (arg == "--budget" && i + 1 < argc)
+                    config.conflict_budget = std::stoi(argv[++i]);
+                else if (arg == "--threads" && i + 1 < argc)
+                    config.num_threads = std::max(1, std::stoi(argv[++i]));
+                else
+                    positional.push_back(std::stoi(arg));
+            }
+            if (positional.size() > 0)
+                num_vars = positional[0];
+            if (positional.size() > 1)
+                instances = positional[1];
+            if (positional.size() > 2)
+                config.timeout = std::chrono::seconds(positional[2]);
+
+            std::vector<double> ratios;
+            for (double r = 3.0; r <= 5.0; r += 0.2)
+            {
+                ratios.push_back(r);
+            }
+            testClauseRatiosBatch(num_vars, ratios, instances, config);
+        }
+        else if (command == "file" && argc > 2)
+        {
+            int timeout_seconds = 1800;
+            std::string checkpoint_prefix;
+            int checkpoint_seconds = 60;
+            int num_threads = std::thread::hardware_concurrency();
+            int num_configs = 0;
+            int slice_conflicts = 0;
+            size_t memory_mb = 0;
+            for (int i = 3; i < argc; i++)
+            {
+                std::string arg = argv[i];
+                if (arg == "--checkpoint" && i + 1 < argc)
+                    checkpoint_prefix = argv[++i];
+                else if (arg == "--checkpoint-interval" && i + 1 < argc)
+                    checkpoint_seconds = std::stoi(argv[++i]);
+                else if (arg == "--threads" && i + 1 < argc)
+                    num_threads = std::max(1, std::stoi(argv[++i]));
+                else if (arg == "--configs" && i + 1 < argc)
+                    num_configs = std::max(1, std::stoi(argv[++i]));
+                else if (arg == "--slice" && i + 1 < argc)
+                    slice_conflicts = std::max(1, std::stoi(argv[++i]));
+                else if (arg == "--memory" && i + 1 < argc)
+                    memory_mb = std::stoul(argv[++i]);
+                else
+                    timeout_seconds = std::stoi(arg);
+            }
+            return solveFile(argv[2], std::chrono::seconds(timeout_seconds), checkpoint_prefix,
+                             std::chrono::seconds(checkpoint_seconds), num_threads, num_configs, slice_conflicts, memory_mb);
+        }
         else if (command == "help")
         {
             std::cout << "Usage:\n";
@@ -396,6 +557,16 @@ int main(int argc, char *argv[])
             std::cout << "  ./portfolio_solver scale   - Run scaling benchmark\n";
             std::cout << "  ./portfolio_solver config  - Run configuration effectiveness benchmark\n";
             std::cout << "  ./portfolio_solver custom [vars] [instances] [timeout] - Run custom benchmark\n";
+            std::cout << "  ./portfolio_solver batch [vars] [instances] [timeout] [--budget N] [--threads N]\n";
+            std::cout << "                             - Run the custom sweep as one batch on a thread pool\n";
+            std::cout << "  ./portfolio_solver file FILE [timeout] [--checkpoint PREFIX] [--checkpoint-interval SEC]\n";
+            std::cout << "                             - Solve a DIMACS file, resuming from checkpoints under PREFIX\n";
+            std::cout << "      [--threads N] [--configs M] [--slice C]\n";
+            std::cout << "                             - M configurations on N threads; with M > N they take\n";
+            std::cout << "                               turns, each running C conflicts to its next restart\n";
+            std::cout << "      [--memory MB]\n";
+            std::cout << "                             - Shed learned clauses, then stop solvers, near MB\n";
+            std::cout << "                               (default: the container's memory limit)\n";
             std::cout << "  ./portfolio_solver help    - Show this help\n";
         }
         else
@@ -73,6 +73,7 @@ bool runWithPreprocessing(const std::string &problem_name, const CNF &formula,
     std::cout << "Variables: " << countVariables(formula) << ", Clauses: " << formula.size() << "\n";
 
     CNF working_formula = formula;
+    ProblemType problem_type = detected_type;
     std::chrono::microseconds preprocess_time(0);
     std::chrono::microseconds solve_time(0);
 
@@ -101,6 +102,7 @@ bool runWithPreprocessing(const std::string &problem_name, const CNF &formula,
 
         // Apply preprocessing
         working_formula = preprocessor.preprocess(formula);
+        problem_type = preprocessor.getProblemType();
 
         auto preprocess_end = std::chrono::high_resolution_clock::now();
         preprocess_time = std::chrono::duration_cast<std::chrono::microseconds>(
@@ -122,6 +124,12 @@ bool runWithPreprocessing(const std::string &problem_name, const CNF &formula,
 
     // Create solver and solve
     CDCLSolverIncremental solver(working_formula);
+
+    // Binary-heavy encodings profit from hyper-binary shortcuts
+    if (problem_type == ProblemType::GRAPH_COLORING || problem_type == ProblemType::HAMILTONIAN)
+    {
+        solver.setHyperBinaryResolution(true);
+    }
     bool result = solver.solve();
 
     auto solve_end = std::chrono::high_resolution_clock::now();
@@ -0,0 +1,241 @@
+#include <iostream>
+#include <vector>
+#include <string>
+#include <chrono>
+#include <csignal>
+#include <cstring>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#include "../include/SolverDaemon.h"
+#include "../include/DimacsParser.h"
+
+// Daemon behind the signal handlers
+static SolverDaemon *active_daemon = nullptr;
+
+static void handleSignal(int)
+{
+    if (active_daemon != nullptr)
+    {
+        active_daemon->stop();
+    }
+}
+
+// Run the daemon until SIGINT/SIGTERM
+int serve(const SolverDaemon::Config &config)
+{
+    SolverDaemon daemon(config);
+    active_daemon = &daemon;
+    std::signal(SIGINT, handleSignal);
+    std::signal(SIGTERM, handleSignal);
+
+    bool ok = daemon.run();
+    active_daemon = nullptr;
+
+    std::cout << "sat_served stopped after " << daemon.getJobsCompleted() << " jobs ("
+              << daemon.getJobsCancelled() << " cancelled, " << daemon.getCacheHits() << " from cache)\n";
+    return ok ? 0 : 1;
+}
+
+// Connect to a running daemon, -1 on failure
+int connectTo(const std::string &socket_path)
+{
+    sockaddr_un address{};
+    address.sun_family = AF_UNIX;
+    if (socket_path.size() >= sizeof(address.sun_path))
+    {
+        return -1;
+    }
+    std::strcpy(address.sun_path, socket_path.c_str());
+
+    int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (fd >= 0 && connect(fd, reinterpret_cast<sockaddr *>(&address), sizeof(address)) < 0)
+    {
+        close(fd);
+        return -1;
+    }
+    return fd;
+}
+
+// Submit every file (repeat times each) over one connection, then print the
+// results in completion order
+int submit(const std::string &socket_path, const std::vector<std::string> &files,
+           uint32_t timeout_ms, bool portfolio, int repeat, bool print_models)
+{
+    std::vector<JobRequest> requests;
+    for (const auto &path : files)
+    {
+        JobRequest request;
+        CNF soft;
+        std::vector<int> weights;
+        bool weighted;
+        if (!readFormulaFile(path, request.clauses, soft, weights, weighted))
+        {
+            std::cerr << "Cannot read " << path << "\n";
+            return 1;
+        }
+
+        if (weighted)
+        {
+            // Hard clauses carry weight 0 in the protocol
+            request.kind = JobKind::WCNF;
+            request.weights.assign(request.clauses.size(), 0);
+            request.clauses.insert(request.clauses.end(), soft.begin(), soft.end());
+            request.weights.insert(request.weights.end(), weights.begin(), weights.end());
+        }
+        request.timeout_ms = timeout_ms;
+        request.flags = portfolio ? JOB_FLAG_PORTFOLIO : 0;
+        requests.push_back(request);
+    }
+
+    int fd = connectTo(socket_path);
+    if (fd < 0)
+    {
+        std::cerr << "Cannot connect to " << socket_path << "\n";
+        return 1;
+    }
+
+    auto start = std::chrono::high_resolution_clock::now();
+
+    // Pipeline all submissions; job id = submission index
+    uint64_t next_id = 0;
+    for (int r = 0; r < repeat; r++)
+    {
+        for (auto &request : requests)
+        {
+            request.id = next_id++;
+            if (!sendFrame(fd, MessageType::SUBMIT, encodeJobRequest(request)))
+            {
+                std::cerr << "Connection lost while submitting\n";
+                close(fd);
+                return 1;
+            }
+        }
+    }
+
+    size_t counts[5] = {0, 0, 0, 0, 0};
+    MessageType type;
+    std::vector<uint8_t> payload;
+    for (uint64_t received = 0; received < next_id;)
+    {
+        JobResult result;
+        if (!receiveFrame(fd, type, payload))
+        {
+            std::cerr << "Connection lost after " << received << " results\n";
+            close(fd);
+            return 1;
+        }
+        if (type != MessageType::RESULT || !decodeJobResult(payload, result))
+        {
+            continue;
+        }
+        received++;
+        counts[static_cast<int>(result.status)]++;
+
+        if (repeat == 1)
+        {
+            std::cout << files[result.id % files.size()] << ": " << jobStatusName(result.status);
+            if (result.cost >= 0)
+            {
+                std::cout << " (cost " << result.cost << ")";
+            }
+            std::cout << "\n";
+
+            if (print_models && result.status == JobStatus::SAT)
+            {
+                std::cout << "v";
+                for (int lit : result.literals)
+                {
+                    std::cout << " " << lit;
+                }
+                std::cout << " 0\n";
+            }
+        }
+    }
+    close(fd);
+
+    auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::high_resolution_clock::now() - start);
+    std::cout << next_id << " jobs in " << elapsed.count() / 1000 << " ms ("
+              << (elapsed.count() > 0 ? next_id * 1000000.0 / elapsed.count() : 0) << " jobs/s): "
+              << counts[0] << " SAT, " << counts[1] << " UNSAT, " << counts[2] << " timeout, "
+              << counts[3] << " cancelled, " << counts[4] << " error\n";
+    return 0;
+}
+
+void printUsage()
+{
+    std::cout << "Usage:\n";
+    std::cout << "  ./sat_served serve [options]             - Run the daemon\n";
+    std::cout << "      --socket PATH                          Socket path (default /tmp/sat_served.sock)\n";
+    std::cout << "      --workers N                            Worker threads (default: cores)\n";
+    std::cout << "      --portfolio-threshold N                Clauses from which CNF jobs use the portfolio\n";
+    std::cout << "      --portfolio-threads N                  Threads per portfolio job\n";
+    std::cout << "      --timeout MS                           Default per-job timeout\n";
+    std::cout << "      --cache N                              Cache up to N answers (default off)\n";
+    std::cout << "      --cache-file PATH                      Persist the cache in a memory-mapped file\n";
+    std::cout << "      --cache-renaming                       Also answer repeats up to variable renaming\n";
+    std::cout << "      --max-vars N                           Reject jobs over more variables (default 10000000)\n";
+    std::cout << "  ./sat_served submit [options] FILE...    - Solve .cnf/.wcnf files on a running daemon\n";
+    std::cout << "      --socket PATH, --timeout MS, --portfolio, --repeat N, --models\n";
+    std::cout << "  ./sat_served help                        - Show this help\n";
+}
+
+int main(int argc, char *argv[])
+{
+    std::string command = argc > 1 ? argv[1] : "help";
+
+    SolverDaemon::Config config;
+    std::vector<std::string> files;
+    uint32_t timeout_ms = 0;
+    bool portfolio = false;
+    bool print_models = false;
+    int repeat = 1;
+
+    for (int i = 2; i < argc; i++)
+    {
+        std::string arg = argv[i];
+        bool has_value = i + 1 < argc;
+        if (arg == "--socket" && has_value)
+            config.socket_path = argv[++i];
+        else if (arg == "--workers" && has_value)
+            config.num_workers = std::stoi(argv[++i]);
+        else if (arg == "--portfolio-threshold" && has_value)
+            config.portfolio_threshold = std::stoul(argv[++i]);
+        else if (arg == "--portfolio-threads" && has_value)
+            config.portfolio_threads = std::stoi(argv[++i]);
+        else if (arg == "--timeout" && has_value)
+        {
+            timeout_ms = std::stoul(argv[++i]);
+            config.default_timeout = std::chrono::milliseconds(timeout_ms);
+        }
+        else if (arg == "--cache" && has_value)
+            config.cache_capacity = std::stoul(argv[++i]);
+        else if (arg == "--cache-file" && has_value)
+            config.cache_path = argv[++i];
+        else if (arg == "--cache-renaming")
+            config.cache_renaming = true;
+        else if (arg == "--max-vars" && has_value)
+            config.max_variables = std::stoi(argv[++i]);
+        else if (arg == "--repeat" && has_value)
+            repeat = std::max(1, std::stoi(argv[++i]));
+        else if (arg == "--portfolio")
+            portfolio = true;
+        else if (arg == "--models")
+            print_models = true;
+        else
+            files.push_back(arg);
+    }
+
+    if (command == "serve")
+    {
+        return serve(config);
+    }
+    if (command == "submit" && !files.empty())
+    {
+        return submit(config.socket_path, files, timeout_ms, portfolio, repeat, print_models);
+    }
+
+    printUsage();
+    return command == "help" ? 0 : 1;
+}
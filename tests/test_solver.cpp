@@ -0,0 +1,1166 @@
+// Behavioural checks for libsatsolver, run by ctest (test_solver). Every
+// check prints a line; a failed condition is reported and makes the run exit
+// with status 1. The formulas are small enough that each answer is known.
+#include "../include/CDCLSolverIncremental.h"
+#include "../include/DistributedPortfolio.h"
+#include "../include/FormulaCache.h"
+#include "../include/HybridMaxSATSolver.h"
+#include "../include/MemoryGovernor.h"
+#include "../include/SolveScheduler.h"
+#include "../include/SolverDaemon.h"
+#include "../include/ipasir.h"
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+static int failures = 0;
+
+static void check(bool condition, const std::string &what)
+{
+    std::cout << (condition ? "  ok      " : "  FAILED  ") << what << "\n";
+    if (!condition)
+    {
+        failures++;
+    }
+}
+
+// True if every clause has a literal the model makes true
+static bool satisfies(const CNF &formula, const std::unordered_map<int, bool> &model)
+{
+    for (const auto &clause : formula)
+    {
+        bool satisfied = false;
+        for (int lit : clause)
+        {
+            auto it = model.find(std::abs(lit));
+            if (it != model.end() && it->second == (lit > 0))
+            {
+                satisfied = true;
+                break;
+            }
+        }
+        if (!satisfied)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+// pigeons into holes, one pigeon per hole: UNSAT when pigeons > holes
+static CNF pigeonhole(int pigeons, int holes)
+{
+    CNF formula;
+    auto var = [holes](int p, int h)
+    { return p * holes + h + 1; };
+    for (int p = 0; p < pigeons; p++)
+    {
+        Clause somewhere;
+        for (int h = 0; h < holes; h++)
+        {
+            somewhere.push_back(var(p, h));
+        }
+        formula.push_back(somewhere);
+    }
+    for (int h = 0; h < holes; h++)
+    {
+        for (int p = 0; p < pigeons; p++)
+        {
+            for (int q = p + 1; q < pigeons; q++)
+            {
+                formula.push_back({-var(p, h), -var(q, h)});
+            }
+        }
+    }
+    return formula;
+}
+
+static void ipasirAddClause(void *solver, const Clause &clause)
+{
+    for (int lit : clause)
+    {
+        ipasir_add(solver, lit);
+    }
+    ipasir_add(solver, 0);
+}
+
+static void testIpasir()
+{
+    std::cout << "IPASIR interface\n";
+
+    void *solver = ipasir_init();
+    CNF formula = {{1, 2}, {-1, 3}, {-2, -3}};
+    for (const auto &clause : formula)
+    {
+        ipasirAddClause(solver, clause);
+    }
+
+    ipasir_assume(solver, -3);
+    check(ipasir_solve(solver) == 10, "SAT under an assumption");
+    std::unordered_map<int, bool> model;
+    for (int var = 1; var <= 3; var++)
+    {
+        int value = ipasir_val(solver, var);
+        check(value == var || value == -var, "ipasir_val returns +/-lit for x" + std::to_string(var));
+        model[var] = value > 0;
+    }
+    check(satisfies(formula, model) && !model[3], "model satisfies the clauses and the assumption");
+
+    // Only the two conflicting assumptions are failed; x4 plays no part
+    ipasirAddClause(solver, {-1, -2});
+    ipasir_assume(solver, 1);
+    ipasir_assume(solver, 2);
+    ipasir_assume(solver, 4);
+    check(ipasir_solve(solver) == 20, "UNSAT under conflicting assumptions");
+    check(ipasir_failed(solver, 1) && ipasir_failed(solver, 2), "both conflicting assumptions failed");
+    check(!ipasir_failed(solver, 4), "unrelated assumption not failed");
+
+    // Assumptions last for one call only
+    check(ipasir_solve(solver) == 10, "assumptions cleared after a solve");
+
+    ipasirAddClause(solver, {1});
+    ipasirAddClause(solver, {2});
+    check(ipasir_solve(solver) == 20, "UNSAT once the clauses contradict");
+    ipasir_release(solver);
+
+    // Learned clauses respect the length limit and arrive 0-terminated
+    solver = ipasir_init();
+    for (const auto &clause : pigeonhole(5, 4))
+    {
+        ipasirAddClause(solver, clause);
+    }
+    struct LearnStats
+    {
+        int clauses = 0;
+        int too_long = 0;
+    } learned;
+    ipasir_set_learn(solver, &learned, 3, [](void *data, int *clause)
+                     {
+                         auto *stats = static_cast<LearnStats *>(data);
+                         int length = 0;
+                         while (clause[length] != 0)
+                         {
+                             length++;
+                         }
+                         stats->clauses++;
+                         stats->too_long += length > 3; });
+    check(ipasir_solve(solver) == 20, "pigeonhole 5/4 is UNSAT");
+    check(learned.too_long == 0, "learn callback only sees clauses up to the limit");
+    ipasir_release(solver);
+
+    // A terminate callback that fires at once interrupts the search
+    solver = ipasir_init();
+    for (const auto &clause : pigeonhole(9, 8))
+    {
+        ipasirAddClause(solver, clause);
+    }
+    ipasir_set_terminate(solver, nullptr, [](void *)
+                         { return 1; });
+    check(ipasir_solve(solver) == 0, "terminate callback interrupts the solve");
+    ipasir_release(solver);
+}
+
+// Bulk-loaded clauses are normalized: duplicates dropped, tautologies skipped
+static void testClauseLoading()
+{
+    std::cout << "Clause loading\n";
+
+    CNF formula = {{1, 1, -2}, {-1}, {2, 2}, {3, -3}};
+    CDCLSolverIncremental solver(formula);
+    check(!solver.solve(), "repeated literals do not hide a conflict");
+    check(solver.getNumClauses() == 3, "tautology is not stored");
+
+    CDCLSolverIncremental tautologies({{1, -1}, {2, -2, 3}});
+    check(tautologies.solve(), "formula of tautologies is SAT");
+}
+
+// Retracted groups stop constraining later solves; live ones keep holding
+static void testTemporaryGroups()
+{
+    std::cout << "Temporary groups\n";
+
+    CDCLSolverIncremental solver({{1, 2}, {-1, 3}});
+    int forbid_two = solver.newTemporaryGroup();
+    solver.addTemporaryClause(forbid_two, {-2});
+    int forbid_three = solver.newTemporaryGroup();
+    solver.addTemporaryClause(forbid_three, {-3});
+    check(!solver.solve(), "two live groups make the formula UNSAT");
+
+    solver.retractTemporaryGroup(forbid_three);
+    check(solver.solve(), "SAT after retracting one group");
+    const auto &model = solver.getAssignments();
+    check(!model.at(2) && model.at(1) && model.at(3), "remaining group still holds");
+
+    solver.retractTemporaryGroup(forbid_two);
+    solver.addClause({-3});
+    check(solver.solve() && solver.getAssignments().at(2), "retracted groups stay retracted");
+
+    // A clause for the next solve only
+    solver.addTemporaryClause({-2});
+    check(!solver.solve(), "single-solve clause applies once");
+    check(solver.solve(), "single-solve clause gone afterwards");
+
+    // Retracting repeatedly or adding to a retracted group does nothing
+    solver.retractTemporaryGroup(forbid_two);
+    solver.addTemporaryClause(forbid_two, {-1});
+    solver.addTemporaryClause(forbid_two, {-2});
+    check(solver.solve(), "clauses for a retracted group are ignored");
+}
+
+// Small seeded 3-SAT formula; the generator is fixed so counts are stable
+static CNF random3Sat(int num_vars, int num_clauses, unsigned seed)
+{
+    CNF formula;
+    for (int i = 0; i < num_clauses; i++)
+    {
+        Clause clause;
+        while (clause.size() < 3)
+        {
+            seed = seed * 1103515245u + 12345u;
+            int var = static_cast<int>((seed >> 16) % num_vars) + 1;
+            int lit = ((seed >> 8) & 1) ? var : -var;
+            if (std::find(clause.begin(), clause.end(), var) == clause.end() &&
+                std::find(clause.begin(), clause.end(), -var) == clause.end())
+            {
+                clause.push_back(lit);
+            }
+        }
+        formula.push_back(clause);
+    }
+    return formula;
+}
+
+// Count the distinct projected models of a formula by trying every assignment
+static size_t bruteForceCount(const CNF &formula, int num_vars, const std::vector<int> &projection)
+{
+    std::vector<std::vector<int>> seen;
+    for (unsigned mask = 0; mask < (1u << num_vars); mask++)
+    {
+        std::unordered_map<int, bool> model;
+        for (int var = 1; var <= num_vars; var++)
+        {
+            model[var] = (mask >> (var - 1)) & 1;
+        }
+        if (!satisfies(formula, model))
+        {
+            continue;
+        }
+
+        std::vector<int> projected;
+        for (int var : projection)
+        {
+            projected.push_back(model[var] ? var : -var);
+        }
+        if (std::find(seen.begin(), seen.end(), projected) == seen.end())
+        {
+            seen.push_back(projected);
+        }
+    }
+    return seen.size();
+}
+
+static void testEnumeration()
+{
+    std::cout << "Model enumeration\n";
+
+    const int num_vars = 10;
+    std::vector<int> all_vars;
+    for (int var = 1; var <= num_vars; var++)
+    {
+        all_vars.push_back(var);
+    }
+    const std::vector<int> projection = {1, 3, 5, 7};
+
+    for (unsigned seed = 1; seed <= 3; seed++)
+    {
+        CNF formula = random3Sat(num_vars, 30, seed);
+        for (bool chronological : {false, true})
+        {
+            std::string mode = chronological ? " (chronological)" : " (blocking)";
+            for (const auto &vars : {all_vars, projection})
+            {
+                EnumerationOptions options;
+                options.chronological = chronological;
+                if (vars.size() < all_vars.size())
+                {
+                    options.projection = vars;
+                }
+
+                CDCLSolverIncremental solver(formula);
+                std::vector<std::vector<int>> models;
+                bool all_valid = true;
+                size_t found = solver.enumerateModels([&](const std::vector<int> &model)
+                                                      {
+                                                          std::unordered_map<int, bool> values;
+                                                          for (int lit : model)
+                                                          {
+                                                              values[std::abs(lit)] = lit > 0;
+                                                          }
+                                                          // Full models must satisfy the formula outright
+                                                          if (vars.size() == all_vars.size())
+                                                          {
+                                                              all_valid &= satisfies(formula, values);
+                                                          }
+                                                          std::vector<int> sorted = model;
+                                                          std::sort(sorted.begin(), sorted.end(), [](int a, int b)
+                                                                    { return std::abs(a) < std::abs(b); });
+                                                          models.push_back(sorted);
+                                                          return true; },
+                                                      options);
+
+                std::string what = "seed " + std::to_string(seed) + (vars.size() < all_vars.size() ? " projected" : " full") + mode;
+                std::sort(models.begin(), models.end());
+                bool distinct = std::adjacent_find(models.begin(), models.end()) == models.end();
+                check(found == models.size() && found == bruteForceCount(formula, num_vars, vars), what + ": model count");
+                check(distinct && all_valid, what + ": models distinct and valid");
+            }
+        }
+    }
+
+    // Assumptions restrict the enumeration, max_models caps it
+    CNF formula = random3Sat(num_vars, 30, 1);
+    CNF restricted = formula;
+    restricted.push_back({2});
+    EnumerationOptions options;
+    options.assumptions = {2};
+    CDCLSolverIncremental solver(formula);
+    size_t found = solver.enumerateModels([](const std::vector<int> &)
+                                          { return true; },
+                                          options);
+    check(found == bruteForceCount(restricted, num_vars, all_vars), "assumptions restrict the models");
+    options.max_models = 2;
+    check(solver.enumerateModels([](const std::vector<int> &)
+                                 { return true; },
+                                 options) == std::min<size_t>(2, found),
+          "max_models stops the enumeration");
+    check(!solver.wasInterrupted(), "a capped enumeration is not reported as interrupted");
+
+    // A stop through the terminate callback leaves a partial count that only
+    // wasInterrupted() tells apart from a complete one
+    for (bool chronological : {false, true})
+    {
+        std::string mode = chronological ? " (chronological)" : " (blocking)";
+        CDCLSolverIncremental complete(formula);
+        EnumerationOptions all;
+        all.chronological = chronological;
+        size_t total = complete.enumerateModels([](const std::vector<int> &)
+                                                { return true; },
+                                                all);
+        check(total == bruteForceCount(formula, num_vars, all_vars) && !complete.wasInterrupted(),
+              "complete enumeration is not interrupted" + mode);
+
+        CDCLSolverIncremental stopped(formula);
+        size_t reported = 0;
+        stopped.setTerminateCallback([&reported]()
+                                     { return reported >= 3; });
+        size_t partial = stopped.enumerateModels([&reported](const std::vector<int> &)
+                                                 {
+                                                     reported++;
+                                                     return true; },
+                                                 all);
+        check(partial < total && stopped.wasInterrupted(), "stopped enumeration is reported as interrupted" + mode);
+    }
+}
+
+// Cores are built from the assumptions the refutation used
+static void testUnsatCores()
+{
+    std::cout << "UNSAT cores\n";
+
+    // Pigeonhole 4/3 with one selector per clause. The formula is minimally
+    // unsatisfiable, so the core must name every selector and nothing else.
+    CNF pigeons = pigeonhole(4, 3);
+    int next_var = 4 * 3 + 1;
+    CNF formula;
+    std::vector<int> selectors;
+    for (auto clause : pigeons)
+    {
+        clause.push_back(-next_var);
+        selectors.push_back(next_var++);
+        formula.push_back(clause);
+    }
+
+    // Selectors for satisfiable side clauses must stay out of the core
+    std::vector<int> unrelated;
+    for (int i = 0; i < 3; i++)
+    {
+        int side = next_var++;
+        int selector = next_var++;
+        formula.push_back({side, -selector});
+        unrelated.push_back(selector);
+    }
+
+    std::vector<int> assumptions = unrelated;
+    assumptions.insert(assumptions.begin() + 1, selectors.begin(), selectors.end());
+    CDCLSolverIncremental solver(formula);
+    check(!solver.solve(assumptions), "selected pigeonhole is UNSAT");
+
+    std::vector<int> core = solver.getUnsatCore();
+    std::sort(core.begin(), core.end());
+    bool subset = std::all_of(core.begin(), core.end(), [&](int lit)
+                              { return std::find(assumptions.begin(), assumptions.end(), lit) != assumptions.end(); });
+    check(subset, "core is a subset of the assumptions");
+    check(core == selectors, "core is exactly the minimal set of selectors");
+    check(!solver.solve(core), "formula with the core alone is UNSAT");
+
+    // Dropping any one selector makes the rest satisfiable
+    bool minimal = true;
+    for (size_t i = 0; i < core.size(); i++)
+    {
+        std::vector<int> smaller = core;
+        smaller.erase(smaller.begin() + i);
+        minimal &= solver.solve(smaller);
+    }
+    check(minimal, "every core literal is needed");
+
+    // Contradictory assumptions form their own core
+    check(!solver.solve({unrelated[0], -unrelated[0]}), "contradictory assumptions are UNSAT");
+    core = solver.getUnsatCore();
+    check(std::all_of(core.begin(), core.end(), [&](int lit)
+                      { return std::abs(lit) == unrelated[0]; }) &&
+              !core.empty(),
+          "contradiction core names only that variable");
+}
+
+// Repeated solves under changing assumptions agree with fresh solvers that
+// take the assumptions as unit clauses. Learned clauses are vivified at
+// restarts below the assumptions, so they must stay valid for the formula.
+static void testAssumptionSolves()
+{
+    std::cout << "Solving under assumptions\n";
+
+    for (unsigned seed = 1; seed <= 4; seed++)
+    {
+        CNF formula = random3Sat(80, 340, seed);
+        CDCLSolverIncremental solver(formula);
+        solver.setRestartStrategy(true, 20);
+
+        bool agree = true;
+        unsigned state = seed;
+        for (int round = 0; round < 6; round++)
+        {
+            state = state * 1103515245u + 12345u;
+            int var = static_cast<int>((state >> 16) % 80) + 1;
+            std::vector<int> assumptions = {(state >> 8) & 1 ? var : -var};
+
+            CNF with_units = formula;
+            with_units.push_back(assumptions);
+            CDCLSolverIncremental fresh(with_units);
+            bool expected = fresh.solve();
+
+            bool result = solver.solve(assumptions);
+            agree &= result == expected && (!result || satisfies(with_units, solver.getAssignments()));
+        }
+        check(agree, "seed " + std::to_string(seed) + ": answers and models match fresh solves");
+    }
+}
+
+// A learned clause limit small enough to reduce the database on almost every
+// conflict. Reductions run in the middle of the search and must keep the
+// clauses that are reasons on the trail, or conflict analysis and the cores
+// built from the trail go wrong.
+static void testReductionKeepsReasons()
+{
+    std::cout << "Clause database reduction\n";
+
+    bool agree = true;
+    bool cores_hold = true;
+    for (unsigned seed = 1; seed <= 6; seed++)
+    {
+        CNF formula = random3Sat(100, 426, seed);
+        CDCLSolverIncremental solver(formula);
+        solver.setMaxLearnts(20);
+        CDCLSolverIncremental fresh(formula);
+        bool result = solver.solve();
+        agree &= result == fresh.solve() && (!result || satisfies(formula, solver.getAssignments()));
+
+        // Under assumptions, a reported core must refute the formula on its own
+        std::vector<int> assumptions;
+        for (int var = 1; var <= 12; var++)
+        {
+            assumptions.push_back((seed + var) % 3 == 0 ? -var : var);
+        }
+        if (!solver.solve(assumptions))
+        {
+            CNF with_core = formula;
+            for (int lit : solver.getUnsatCore())
+            {
+                with_core.push_back({lit});
+            }
+            CDCLSolverIncremental check_core(with_core);
+            cores_hold &= !check_core.solve();
+        }
+    }
+    check(agree, "answers and models match fresh solves");
+    check(cores_hold, "cores under assumptions refute the formula");
+}
+
+// Solve with a feature switched on, first alone and then under changing
+// assumptions, and compare every answer, model and core with fresh solvers
+// that have it switched off and take the assumptions as unit clauses
+static bool agreesWithFresh(CDCLSolverIncremental &solver, const CNF &formula, int num_vars, unsigned seed,
+                            const std::function<void(CDCLSolverIncremental &, bool)> &configure)
+{
+    configure(solver, true);
+    solver.setRestartStrategy(true, 20);
+
+    bool agree = true;
+    unsigned state = seed;
+    for (int round = 0; round < 8; round++)
+    {
+        std::vector<int> assumptions;
+        for (int i = 0; i < round % 3; i++)
+        {
+            state = state * 1103515245u + 12345u;
+            int var = static_cast<int>((state >> 16) % num_vars) + 1;
+            assumptions.push_back((state >> 8) & 1 ? var : -var);
+        }
+
+        CNF with_units = formula;
+        for (int lit : assumptions)
+        {
+            with_units.push_back({lit});
+        }
+        CDCLSolverIncremental fresh(with_units);
+        configure(fresh, false);
+        bool expected = fresh.solve();
+
+        bool result = solver.solve(assumptions);
+        agree &= result == expected;
+        if (result)
+        {
+            agree &= satisfies(with_units, solver.getAssignments());
+        }
+        else
+        {
+            CNF with_core = formula;
+            for (int lit : solver.getUnsatCore())
+            {
+                with_core.push_back({lit});
+            }
+            CDCLSolverIncremental core_check(with_core);
+            configure(core_check, false);
+            agree &= !core_check.solve();
+        }
+    }
+    return agree;
+}
+
+// Hyper-binary resolution adds binary clauses and rewires reasons at level 1,
+// which conflict analysis then relies on
+static void testHyperBinaryResolution()
+{
+    std::cout << "Hyper-binary resolution\n";
+
+    int added = 0;
+    for (unsigned seed = 1; seed <= 4; seed++)
+    {
+        // Binary-heavy: 3-SAT clauses plus binaries taken from a second formula
+        CNF formula = random3Sat(60, 150, seed);
+        for (const auto &clause : random3Sat(60, 40, seed + 50))
+        {
+            formula.push_back({clause[0], clause[1]});
+        }
+
+        CDCLSolverIncremental solver(formula);
+        bool agree = agreesWithFresh(solver, formula, 60, seed, [](CDCLSolverIncremental &s, bool enable)
+                                     { s.setHyperBinaryResolution(enable); });
+        added += solver.getHyperBinaries();
+        check(agree, "seed " + std::to_string(seed) + ": answers, models and cores match fresh solves");
+    }
+    check(added > 0, "hyper-binary resolution was exercised");
+}
+
+// On-the-fly strengthening must count each literal of a reason once. This
+// satisfiable formula repeats literals and used to come back UNSAT about
+// half of the time; the search is randomized, so it is solved repeatedly.
+static void testStrengthening()
+{
+    std::cout << "On-the-fly strengthening\n";
+
+    CNF formula = {{2, -6, -6}, {-5, 4, -5}, {-4, 5, -3}, {-1, 2, 5}, {-4, 6, 1}, {2, -2, -1}, {-4, 2, -3}, {5, 6, 6}, {-5, -1, -3}, {-5, -3, 6}, {-5, 6, -4}, {1, -6, 1}, {-2, -6, -4}, {2, 5, -2}};
+    int wrong = 0;
+    for (int run = 0; run < 200; run++)
+    {
+        CDCLSolverIncremental solver(formula);
+        if (!solver.solve() || !satisfies(formula, solver.getAssignments()))
+        {
+            wrong++;
+        }
+    }
+    check(wrong == 0, "formula with repeated literals is always SAT with a valid model");
+}
+
+// Trail saving replays implications a backjump undid straight from their
+// saved reasons. It is on by default, so the fresh solvers switch it off.
+static void testTrailSaving()
+{
+    std::cout << "Trail saving\n";
+
+    int replayed = 0;
+    for (unsigned seed = 1; seed <= 4; seed++)
+    {
+        CNF formula = random3Sat(80, 340, seed);
+        CDCLSolverIncremental solver(formula);
+        bool agree = agreesWithFresh(solver, formula, 80, seed, [](CDCLSolverIncremental &s, bool enable)
+                                     { s.setTrailSaving(enable); });
+        replayed += solver.getReplayed();
+        check(agree, "seed " + std::to_string(seed) + ": answers, models and cores match fresh solves");
+    }
+    check(replayed > 0, "saved implications were replayed");
+}
+
+// Client side of the daemon's Unix socket, -1 until the daemon listens
+static int connectDaemon(const std::string &socket_path)
+{
+    sockaddr_un address{};
+    address.sun_family = AF_UNIX;
+    std::strncpy(address.sun_path, socket_path.c_str(), sizeof(address.sun_path) - 1);
+    for (int attempt = 0; attempt < 100; attempt++)
+    {
+        int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+        if (fd >= 0 && connect(fd, reinterpret_cast<sockaddr *>(&address), sizeof(address)) == 0)
+        {
+            return fd;
+        }
+        close(fd);
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    }
+    return -1;
+}
+
+// Submit a CNF job and return the daemon's answer
+static JobResult daemonSolve(int fd, uint64_t id, const CNF &clauses, uint32_t timeout_ms = 0)
+{
+    JobRequest request;
+    request.id = id;
+    request.clauses = clauses;
+    request.timeout_ms = timeout_ms;
+    JobResult result;
+    MessageType type;
+    std::vector<uint8_t> payload;
+    if (!sendFrame(fd, MessageType::SUBMIT, encodeJobRequest(request)) ||
+        !receiveFrame(fd, type, payload) || !decodeJobResult(payload, result))
+    {
+        result.id = id;
+        result.status = JobStatus::ERROR;
+    }
+    return result;
+}
+
+// sat_served over a temporary socket: answers, timeouts and cancellation,
+// and requests that are malformed or too large are refused without taking
+// the daemon (or its other clients) down
+static void testSolverDaemon()
+{
+    std::cout << "Solver daemon\n";
+
+    SolverDaemon::Config config;
+    config.socket_path = (std::filesystem::temp_directory_path() / "test_solver.sock").string();
+    config.num_workers = 2;
+    config.max_variables = 100000;
+    SolverDaemon daemon(config);
+    std::thread server([&]
+                       { daemon.run(); });
+
+    int fd = connectDaemon(config.socket_path);
+    check(fd >= 0, "client connects");
+    if (fd < 0)
+    {
+        daemon.stop();
+        server.join();
+        return;
+    }
+
+    CNF satisfiable = random3Sat(60, 240, 5);
+    JobResult sat = daemonSolve(fd, 1, satisfiable);
+    std::unordered_map<int, bool> model;
+    for (int lit : sat.literals)
+    {
+        model[std::abs(lit)] = lit > 0;
+    }
+    check(sat.id == 1 && sat.status == JobStatus::SAT && satisfies(satisfiable, model), "SAT job with a valid model");
+    check(daemonSolve(fd, 2, pigeonhole(5, 4)).status == JobStatus::UNSAT, "UNSAT job refuted");
+    check(daemonSolve(fd, 3, pigeonhole(10, 9), 200).status == JobStatus::TIMEOUT, "job stops at its timeout");
+
+    // Cancel a job that would otherwise run for the default minute
+    JobRequest hard;
+    hard.id = 4;
+    hard.clauses = pigeonhole(10, 9);
+    sendFrame(fd, MessageType::SUBMIT, encodeJobRequest(hard));
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    sendFrame(fd, MessageType::CANCEL, encodeCancel(4));
+    MessageType type;
+    std::vector<uint8_t> payload;
+    JobResult cancelled;
+    check(receiveFrame(fd, type, payload) && decodeJobResult(payload, cancelled) &&
+              cancelled.id == 4 && cancelled.status == JobStatus::CANCELLED,
+          "cancelled job answered as CANCELLED");
+
+    // Refused payloads: garbage and a variable far over the configured limit
+    sendFrame(fd, MessageType::SUBMIT, {0xff, 0xff, 0xff});
+    JobResult malformed;
+    check(receiveFrame(fd, type, payload) && decodeJobResult(payload, malformed) &&
+              malformed.status == JobStatus::ERROR,
+          "malformed payload answered with ERROR");
+    check(daemonSolve(fd, 5, {{2000000000, 1}}).status == JobStatus::ERROR, "oversized variable answered with ERROR");
+    check(daemonSolve(fd, 6, pigeonhole(4, 3)).status == JobStatus::UNSAT, "connection still served afterwards");
+
+    // A frame header over the size limit ends only that connection
+    uint8_t header[5] = {0xff, 0xff, 0xff, 0xff, static_cast<uint8_t>(MessageType::SUBMIT)};
+    check(write(fd, header, sizeof(header)) == sizeof(header) && !receiveFrame(fd, type, payload),
+          "oversized frame closes its connection");
+    close(fd);
+
+    fd = connectDaemon(config.socket_path);
+    check(fd >= 0 && daemonSolve(fd, 1, satisfiable).status == JobStatus::SAT, "daemon survives for new clients");
+    close(fd);
+
+    daemon.stop();
+    server.join();
+    std::filesystem::remove(config.socket_path);
+}
+
+// A MaxSAT solve stopped through its terminate callback reports the
+// interruption instead of an optimum or UNSAT
+static void testMaxSATTermination()
+{
+    std::cout << "MaxSAT termination\n";
+
+    HybridMaxSATSolver solver({{1, 2}, {-1, -2}});
+    solver.addSoftClause({1}, 2);
+    solver.addSoftClause({2}, 1);
+    check(solver.solve() == 1 && !solver.wasInterrupted(), "optimum found without a stop");
+
+    for (int mode = 0; mode < 3; mode++)
+    {
+        HybridMaxSATSolver stopped(pigeonhole(9, 8));
+        HybridMaxSATSolver::Config config;
+        config.force_binary = mode == 1;
+        config.force_stratified = mode == 2;
+        stopped.setConfig(config);
+        stopped.addSoftClause({1}, 2);
+        stopped.addSoftClause({-1}, 1);
+        stopped.setTerminateCallback([]()
+                                     { return true; });
+        std::string name = mode == 0 ? "default algorithm" : mode == 1 ? "binary search" : "stratified";
+        check(stopped.solve() == -1 && stopped.wasInterrupted(), name + ": stopped solve is flagged as interrupted");
+    }
+}
+
+// Rename variable v to permutation[v]
+static CNF renameVariables(const CNF &formula, const std::vector<int> &permutation)
+{
+    CNF renamed;
+    for (const auto &clause : formula)
+    {
+        Clause mapped;
+        for (int lit : clause)
+        {
+            mapped.push_back(lit > 0 ? permutation[lit] : -permutation[-lit]);
+        }
+        renamed.push_back(mapped);
+    }
+    return renamed;
+}
+
+// Cache keys ignore clause and literal order; with renaming, answers of a
+// renamed formula come back in its own variables. Entries are evicted least
+// recently used first and survive a reload, also from a torn log.
+static void testFormulaCache()
+{
+    std::cout << "Formula cache\n";
+
+    CNF formula = random3Sat(30, 120, 21);
+    FormulaCache exact(16);
+    CNF shuffled(formula.rbegin(), formula.rend());
+    for (auto &clause : shuffled)
+    {
+        std::reverse(clause.begin(), clause.end());
+    }
+    shuffled.push_back(shuffled.front());    // Duplicate clause
+    shuffled.push_back({4, -4, 9});          // Tautology
+    shuffled[0].push_back(shuffled[0][0]);   // Duplicate literal
+    check(exact.canonicalize(formula, {}, {}).key == exact.canonicalize(shuffled, {}, {}).key,
+          "key ignores clause and literal order, duplicates and tautologies");
+    CNF other = formula;
+    other.pop_back();
+    check(!(exact.canonicalize(formula, {}, {}).key == exact.canonicalize(other, {}, {}).key),
+          "a different formula gets a different key");
+
+    // Renamed copies hit the entry and get the model and core in their own variables
+    FormulaCache renaming(16, true);
+    CDCLSolverIncremental solver(formula);
+    bool sat = solver.solve();
+    std::vector<int> model;
+    for (int var = 1; var <= 30; var++)
+    {
+        model.push_back(solver.getAssignments().count(var) && solver.getAssignments().at(var) ? var : -var);
+    }
+    CanonicalFormula original = renaming.canonicalize(formula, {}, {});
+    renaming.store(original, {true, -1, model});
+
+    // Assumptions on every variable that the model refutes give a core
+    std::vector<int> assumptions;
+    for (int lit : model)
+    {
+        assumptions.push_back(lit % 3 == 0 ? -lit : lit);
+    }
+    bool core_sat = solver.solve(assumptions);
+    std::vector<int> core = solver.getUnsatCore();
+    renaming.store(renaming.canonicalize(formula, {}, assumptions), {false, -1, core});
+
+    bool models_valid = sat && original.renamed;
+    bool cores_valid = !core_sat;
+    unsigned state = 7;
+    for (int round = 0; round < 20; round++)
+    {
+        std::vector<int> permutation(31);
+        for (int var = 0; var <= 30; var++)
+        {
+            permutation[var] = var;
+        }
+        for (int var = 30; var > 1; var--)
+        {
+            state = state * 1103515245u + 12345u;
+            std::swap(permutation[var], permutation[(state >> 16) % var + 1]);
+        }
+        CNF renamed = renameVariables(formula, permutation);
+
+        CachedResult hit;
+        std::unordered_map<int, bool> values;
+        models_valid &= renaming.lookup(renaming.canonicalize(renamed, {}, {}), hit) && hit.sat;
+        for (int lit : hit.literals)
+        {
+            values[std::abs(lit)] = lit > 0;
+        }
+        models_valid &= satisfies(renamed, values);
+
+        std::vector<int> renamed_assumptions, expected_core;
+        for (int lit : assumptions)
+        {
+            renamed_assumptions.push_back(lit > 0 ? permutation[lit] : -permutation[-lit]);
+        }
+        for (int lit : core)
+        {
+            expected_core.push_back(lit > 0 ? permutation[lit] : -permutation[-lit]);
+        }
+        cores_valid &= renaming.lookup(renaming.canonicalize(renamed, {}, renamed_assumptions), hit) && !hit.sat;
+        std::sort(hit.literals.begin(), hit.literals.end());
+        std::sort(expected_core.begin(), expected_core.end());
+        cores_valid &= hit.literals == expected_core;
+    }
+    check(models_valid, "renamed formulas hit with models valid for them");
+    check(cores_valid, "renamed queries get the core in their own variables");
+
+    // The least recently used entry goes first
+    CNF a = random3Sat(12, 40, 1), b = random3Sat(12, 40, 2), c = random3Sat(12, 40, 3);
+    FormulaCache small(2);
+    CachedResult result;
+    small.store(small.canonicalize(a, {}, {}), {false, -1, {1}});
+    small.store(small.canonicalize(b, {}, {}), {false, -1, {2}});
+    small.lookup(small.canonicalize(a, {}, {}), result);
+    small.store(small.canonicalize(c, {}, {}), {false, -1, {3}});
+    check(small.size() == 2 && !small.lookup(small.canonicalize(b, {}, {}), result) &&
+              small.lookup(small.canonicalize(a, {}, {}), result) && small.lookup(small.canonicalize(c, {}, {}), result),
+          "least recently used entry evicted");
+
+    // Written back on destruction and reloaded by open()
+    const std::string path = (std::filesystem::temp_directory_path() / "test_solver.cache").string();
+    std::filesystem::remove(path);
+    {
+        FormulaCache stored(16);
+        check(stored.open(path), "cache file opens");
+        stored.store(stored.canonicalize(a, {}, {}), {false, -1, {1}});
+        stored.store(stored.canonicalize(b, {}, {}), {false, -1, {2}});
+        stored.store(stored.canonicalize(c, {}, {}), {false, -1, {3}});
+        stored.flush();
+    }
+    {
+        FormulaCache reloaded(16);
+        bool loaded = reloaded.open(path) && reloaded.size() == 3;
+        for (const auto &[formula_in, lit] : {std::make_pair(a, 1), std::make_pair(b, 2), std::make_pair(c, 3)})
+        {
+            loaded &= reloaded.lookup(reloaded.canonicalize(formula_in, {}, {}), result) && !result.sat &&
+                      result.literals == std::vector<int>{lit};
+        }
+        check(loaded, "entries reloaded after flush and open");
+    }
+
+    // Cut the file inside its last record (the most recently used, c): the
+    // record is dropped and everything before it still loads
+    {
+        std::ifstream in(path, std::ios::binary);
+        uint64_t declared = 0;
+        in.seekg(8);
+        in.read(reinterpret_cast<char *>(&declared), sizeof(declared));
+        in.close();
+        std::filesystem::resize_file(path, 16 + declared - 4);
+    }
+    {
+        FormulaCache recovered(16);
+        check(recovered.open(path) && recovered.size() == 2 &&
+                  recovered.lookup(recovered.canonicalize(a, {}, {}), result) &&
+                  recovered.lookup(recovered.canonicalize(b, {}, {}), result) &&
+                  !recovered.lookup(recovered.canonicalize(c, {}, {}), result),
+              "truncated log recovers the complete records");
+    }
+    std::filesystem::remove(path);
+}
+
+// A saved and reloaded solver carries on with the same formula, learned
+// clauses, statistics and temporary groups; damaged files are refused
+static void testCheckpointRoundTrip()
+{
+    std::cout << "Checkpoint round trip\n";
+
+    const std::string path = (std::filesystem::temp_directory_path() / "test_solver.ckpt").string();
+    CNF formula = random3Sat(80, 340, 7);
+    CDCLSolverIncremental original(formula);
+    int group = original.newTemporaryGroup();
+    original.addTemporaryClause(group, {-1});
+    original.addTemporaryClause(group, {-2});
+    original.solve({3});
+    check(original.saveCheckpoint(path), "checkpoint written");
+
+    CDCLSolverIncremental restored(CNF{});
+    check(restored.loadCheckpoint(path), "checkpoint loaded");
+    check(restored.getNumVars() == original.getNumVars() && restored.getNumLearnts() == original.getNumLearnts() &&
+              restored.getConflicts() == original.getConflicts(),
+          "variables, learned clauses and statistics restored");
+
+    bool same = true;
+    std::vector<std::vector<int>> queries = {{}, {3}, {1}, {-3, 4}};
+    for (const auto &assumptions : queries)
+    {
+        CNF expected_formula = formula;
+        expected_formula.push_back({-1});
+        expected_formula.push_back({-2});
+        for (int lit : assumptions)
+        {
+            expected_formula.push_back({lit});
+        }
+        CDCLSolverIncremental fresh(expected_formula);
+        bool expected = fresh.solve();
+        bool result = restored.solve(assumptions);
+        same &= result == expected && (!result || satisfies(expected_formula, restored.getAssignments()));
+    }
+    check(same, "restored solver answers like the formula with its live group");
+
+    restored.retractTemporaryGroup(group);
+    CDCLSolverIncremental fresh(formula);
+    check(restored.solve({1}) == fresh.solve({1}), "restored group can be retracted");
+
+    // Cut the file short: the reader must refuse it rather than load garbage
+    std::filesystem::resize_file(path, std::filesystem::file_size(path) / 2);
+    CDCLSolverIncremental truncated(CNF{});
+    check(!truncated.loadCheckpoint(path), "truncated checkpoint rejected");
+    std::filesystem::remove(path);
+    check(!truncated.loadCheckpoint(path), "missing checkpoint rejected");
+}
+
+// Coordinator and workers of the distributed portfolio on loopback, in
+// portfolio and cube mode. stop() shuts a worker's socket down just as a
+// crash would, so the last session checks that the coordinator requeues the
+// lost worker's tasks and still settles the formula.
+static void runDistributedSession(int cube_variables, bool kill_worker)
+{
+    std::string mode = std::string(cube_variables > 0 ? "cubes" : "portfolio") + (kill_worker ? ", worker lost" : "");
+
+    DistributedCoordinator::Config config;
+    config.num_workers = 2;
+    config.cube_variables = cube_variables;
+    config.timeout = std::chrono::seconds(60);
+    DistributedCoordinator coordinator(config);
+    if (!coordinator.listen())
+    {
+        check(false, mode + ": coordinator listens on loopback");
+        return;
+    }
+
+    DistributedWorker::Config worker_config;
+    worker_config.port = coordinator.getPort();
+    worker_config.num_threads = 1;
+    worker_config.slice_conflicts = 200;
+    DistributedWorker first(worker_config), second(worker_config);
+    std::thread first_thread([&]
+                             { first.run(); });
+    std::thread second_thread([&]
+                              { second.run(); });
+    check(coordinator.acceptWorkers() == 2, mode + ": both workers connect");
+
+    if (!kill_worker)
+    {
+        CNF satisfiable = random3Sat(80, 320, 11);
+        JobResult sat = coordinator.solve(satisfiable);
+        std::unordered_map<int, bool> model;
+        for (int lit : sat.literals)
+        {
+            model[std::abs(lit)] = lit > 0;
+        }
+        check(sat.status == JobStatus::SAT && satisfies(satisfiable, model), mode + ": SAT with a valid model");
+        check(coordinator.solve(pigeonhole(6, 5)).status == JobStatus::UNSAT, mode + ": UNSAT refuted");
+    }
+    else
+    {
+        std::thread killer([&]
+                           {
+                               std::this_thread::sleep_for(std::chrono::milliseconds(100));
+                               first.stop(); });
+        JobResult result = coordinator.solve(pigeonhole(8, 7));
+        killer.join();
+        check(result.status == JobStatus::UNSAT, mode + ": formula still settled");
+        check(second.getTasksCompleted() > 0, mode + ": surviving worker took over");
+    }
+
+    first.stop();
+    second.stop();
+    first_thread.join();
+    second_thread.join();
+}
+
+static void testDistributedPortfolio()
+{
+    std::cout << "Distributed portfolio\n";
+    runDistributedSession(0, false);
+    runDistributedSession(3, false);
+    runDistributedSession(3, true);
+}
+
+// An asynchronous solve whose search throws completes as UNKNOWN, and the
+// caller's terminate callback is back in place afterwards
+static void testAsyncFailure()
+{
+    std::cout << "Asynchronous solve failure\n";
+
+    CDCLSolverIncremental solver(pigeonhole(6, 5));
+    int polls = 0;
+    solver.setTerminateCallback([&polls]()
+                                {
+                                    if (++polls == 1)
+                                    {
+                                        throw std::runtime_error("search failed");
+                                    }
+                                    return false; });
+    SolveHandle handle = solver.solveAsync();
+    check(handle.wait() == SolveStatus::UNKNOWN, "throwing solve completes as UNKNOWN");
+
+    int polls_before = polls;
+    check(!solver.solve() && polls > polls_before, "caller's callback restored and still polled");
+
+    // The same through the scheduler, whose slices swap the callback too
+    CDCLSolverIncremental sliced(pigeonhole(6, 5));
+    int sliced_polls = 0;
+    sliced.setTerminateCallback([&sliced_polls]()
+                                {
+                                    if (++sliced_polls == 1)
+                                    {
+                                        throw std::runtime_error("search failed");
+                                    }
+                                    return false; });
+    SolveScheduler::Config config;
+    config.num_threads = 1;
+    SolveScheduler scheduler(config);
+    SolveHandle sliced_handle = scheduler.submit(sliced);
+    check(sliced_handle.wait() == SolveStatus::UNKNOWN, "throwing slice completes as UNKNOWN");
+    scheduler.wait();
+    check(scheduler.getActiveSolves() == 0, "failed session leaves the scheduler");
+
+    polls_before = sliced_polls;
+    check(!sliced.solve() && sliced_polls > polls_before, "callback restored after a failed slice");
+}
+
+// The governor escalates with the reported usage, each stage waits out its
+// cooldown before acting again, and the last active worker keeps running
+static void testMemoryGovernor()
+{
+    std::cout << "Memory governor\n";
+
+    MemoryGovernor::Config config;
+    config.limit_bytes = 1000;
+    config.cooldown = std::chrono::milliseconds(200);
+    MemoryGovernor governor(config);
+
+    std::vector<MemoryGovernor::WorkerUsage> workers(3);
+    for (size_t i = 0; i < workers.size(); i++)
+    {
+        workers[i].active = true;
+        workers[i].max_learnts = 10000;
+        workers[i].progress = 0.9 - 0.4 * i;
+    }
+    workers[1].max_learnts = 1500;
+
+    MemoryGovernor::Decision normal = governor.check(workers, 500);
+    check(normal.stage == MemoryGovernor::Stage::NORMAL && normal.learnt_limits.empty() &&
+              normal.compact.empty() && normal.suspend < 0,
+          "below 70%: no action");
+
+    MemoryGovernor::Decision shrink = governor.check(workers, 750);
+    check(shrink.stage == MemoryGovernor::Stage::SHRINK && shrink.learnt_limits.size() == 3 &&
+              shrink.learnt_limits[0].second == 5000 && shrink.learnt_limits[1].second == 1000 &&
+              shrink.compact.empty() && shrink.suspend < 0,
+          "70%: learned clause limits halved, not below the minimum");
+    check(governor.check(workers, 750).learnt_limits.empty(), "shrink waits for its cooldown");
+
+    MemoryGovernor::Decision compact = governor.check(workers, 850);
+    check(compact.stage == MemoryGovernor::Stage::COMPACT && compact.learnt_limits.empty() &&
+              compact.compact.size() == 3 && compact.suspend < 0,
+          "80%: every active worker compacts");
+
+    MemoryGovernor::Decision suspend = governor.check(workers, 950);
+    check(suspend.stage == MemoryGovernor::Stage::SUSPEND && suspend.compact.empty() && suspend.suspend == 2,
+          "90%: the worker with the least progress is suspended");
+    check(governor.check(workers, 950).suspend < 0, "suspend waits for its cooldown");
+
+    // After the cooldowns only worker 0 is left running
+    std::this_thread::sleep_for(std::chrono::milliseconds(250));
+    workers[1].active = false;
+    workers[2].active = false;
+    MemoryGovernor::Decision last = governor.check(workers, 950);
+    check(last.learnt_limits.size() == 1 && last.learnt_limits[0].first == 0 &&
+              last.compact == std::vector<int>{0} && last.suspend < 0,
+          "only active workers are instructed; the last one is never suspended");
+    check(governor.getShrinks() == 2 && governor.getCompactions() == 2 && governor.getSuspensions() == 1 &&
+              governor.getPeakUsage() == 950,
+          "counters record the actions taken");
+}
+
+int main()
+{
+    testIpasir();
+    testClauseLoading();
+    testTemporaryGroups();
+    testEnumeration();
+    testUnsatCores();
+    testAssumptionSolves();
+    testReductionKeepsReasons();
+    testHyperBinaryResolution();
+    testStrengthening();
+    testTrailSaving();
+    testSolverDaemon();
+    testMaxSATTermination();
+    testFormulaCache();
+    testCheckpointRoundTrip();
+    testAsyncFailure();
+    testDistributedPortfolio();
+    testMemoryGovernor();
+
+    if (failures > 0)
+    {
+        std::cout << failures << " check(s) failed\n";
+        return 1;
+    }
+    std::cout << "All checks passed\n";
+    return 0;
+}